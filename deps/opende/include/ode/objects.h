@@ -2112,6 +2112,25 @@ ODE_API void dJointSetFeedback (dJointID, dJointFeedback *);
  */
 ODE_API dJointFeedback *dJointGetFeedback (dJointID);
 
+/**
+ * @brief Get the constraint impulses the last step solved for, which
+ * quickstep uses to warm start the next step.
+ * @param lambda Array of 6 values, set to the impulses.
+ * @param lambda_erp Array of 6 values, set to the error correction
+ * impulses.
+ * @ingroup joints
+ */
+ODE_API void dJointGetLambda (dJointID, dReal *lambda, dReal *lambda_erp);
+
+/**
+ * @brief Set the constraint impulses used to warm start the next step.
+ * @param lambda Array of 6 impulses.
+ * @param lambda_erp Array of 6 error correction impulses.
+ * @ingroup joints
+ */
+ODE_API void dJointSetLambda (dJointID, const dReal *lambda,
+                              const dReal *lambda_erp);
+
 /**
  * @brief Set the joint anchor point.
  * @ingroup joints
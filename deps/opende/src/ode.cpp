@@ -1542,6 +1542,21 @@ dJointFeedback *dJointGetFeedback (dxJoint *joint)
   return joint->feedback;
 }
 
+void dJointGetLambda (dxJoint *joint, dReal *lambda, dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (lambda, joint->lambda, 6 * sizeof(dReal));
+  memcpy (lambda_erp, joint->lambda_erp, 6 * sizeof(dReal));
+}
+
+void dJointSetLambda (dxJoint *joint, const dReal *lambda,
+                      const dReal *lambda_erp)
+{
+  dAASSERT (joint && lambda && lambda_erp);
+  memcpy (joint->lambda, lambda, 6 * sizeof(dReal));
+  memcpy (joint->lambda_erp, lambda_erp, 6 * sizeof(dReal));
+}
+
 
 
 dJointID dConnectingJoint (dBodyID in_b1, dBodyID in_b2)
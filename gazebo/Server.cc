@@ -116,6 +116,7 @@ bool Server::ParseArgs(int _argc, char **_argv)
     ("seed",  po::value<double>(), "Start with a given random number seed.")
     ("iters",  po::value<unsigned int>(), "Number of iterations to simulate.")
     ("minimal_comms", "Reduce the TCP/IP traffic output by gzserver")
+    ("lazy_sensors", "Skip sensor updates while nothing consumes the data.")
     ("server-plugin,s", po::value<std::vector<std::string> >(),
      "Load a plugin.")
     ("profile,o", po::value<std::string>(),
@@ -172,6 +173,8 @@ bool Server::ParseArgs(int _argc, char **_argv)
   else
     gazebo::transport::setMinimalComms(false);
 
+  gazebo::sensors::set_lazy_activation(this->vm.count("lazy_sensors") > 0);
+
   // Set the random number seed if present on the command line.
   if (this->vm.count("seed"))
   {
@@ -285,16 +288,19 @@ bool Server::ParseArgs(int _argc, char **_argv)
     if (this->vm.count("profile"))
     {
       std::string profileName = this->vm["profile"].as<std::string>();
-      if (physics::get_world()->GetPresetManager()->HasProfile(profileName))
-      {
-        physics::get_world()->GetPresetManager()->CurrentProfile(profileName);
-        gzmsg << "Setting physics profile to [" << profileName << "]."
-              << std::endl;
-      }
-      else
+      for (auto &world : physics::get_worlds())
       {
-        gzerr << "Specified profile [" << profileName << "] was not found."
-              << std::endl;
+        if (world->GetPresetManager()->HasProfile(profileName))
+        {
+          world->GetPresetManager()->CurrentProfile(profileName);
+          gzmsg << "Setting physics profile of world[" << world->GetName()
+                << "] to [" << profileName << "]." << std::endl;
+        }
+        else
+        {
+          gzerr << "Specified profile [" << profileName << "] was not found"
+                << " in world[" << world->GetName() << "]." << std::endl;
+        }
       }
     }
   }
@@ -371,44 +377,8 @@ bool Server::PreLoad()
 bool Server::LoadImpl(sdf::ElementPtr _elem,
                       const std::string &_physics)
 {
-  // If a physics engine is specified,
-  if (_physics.length())
-  {
-    // Check if physics engine name is valid
-    // This must be done after physics::load();
-    if (!physics::PhysicsFactory::IsRegistered(_physics))
-    {
-      gzerr << "Unregistered physics engine [" << _physics
-            << "], the default will be used instead.\n";
-    }
-    // Try inserting physics engine name if one is given
-    else if (_elem->HasElement("world") &&
-             _elem->GetElement("world")->HasElement("physics"))
-    {
-      _elem->GetElement("world")->GetElement("physics")
-           ->GetAttribute("type")->Set(_physics);
-    }
-    else
-    {
-      gzerr << "Cannot set physics engine: <world> does not have <physics>\n";
-    }
-  }
-
-  sdf::ElementPtr worldElem = _elem->GetElement("world");
-  if (worldElem)
-  {
-    physics::WorldPtr world = physics::create_world();
-
-    // Create the world
-    try
-    {
-      physics::load_world(world, worldElem);
-    }
-    catch(common::Exception &e)
-    {
-      gzthrow("Failed to load the World\n"  << e);
-    }
-  }
+  physics::World_V worlds;
+  this->LoadWorlds(_elem, _physics, worlds);
 
   this->node = transport::NodePtr(new transport::Node());
   this->node->Init("/gazebo");
@@ -441,6 +411,66 @@ bool Server::LoadImpl(sdf::ElementPtr _elem,
   return true;
 }
 
+/////////////////////////////////////////////////
+bool Server::LoadWorlds(sdf::ElementPtr _elem, const std::string &_physics,
+                        physics::World_V &_worlds)
+{
+  // Check if physics engine name is valid
+  // This must be done after physics::load();
+  if (_physics.length() && !physics::PhysicsFactory::IsRegistered(_physics))
+  {
+    gzerr << "Unregistered physics engine [" << _physics
+          << "], the default will be used instead.\n";
+  }
+
+  // Each world runs in its own thread. Worlds are told apart by name, so
+  // a world whose name is taken is not loaded.
+  bool result = true;
+  for (sdf::ElementPtr worldElem = _elem->GetElement("world"); worldElem;
+       worldElem = worldElem->GetNextElement("world"))
+  {
+    std::string worldName = worldElem->Get<std::string>("name");
+    if (physics::has_world(worldName))
+    {
+      gzerr << "A world named [" << worldName << "] is already loaded. "
+            << "The world will not be loaded again.\n";
+      result = false;
+      continue;
+    }
+
+    // Try inserting physics engine name if one is given
+    if (_physics.length() && physics::PhysicsFactory::IsRegistered(_physics))
+    {
+      if (worldElem->HasElement("physics"))
+      {
+        worldElem->GetElement("physics")->GetAttribute("type")->Set(
+            _physics);
+      }
+      else
+      {
+        gzerr << "Cannot set physics engine: <world> does not have "
+              << "<physics>\n";
+      }
+    }
+
+    physics::WorldPtr world = physics::create_world();
+
+    // Create the world
+    try
+    {
+      physics::load_world(world, worldElem);
+    }
+    catch(common::Exception &e)
+    {
+      gzthrow("Failed to load the World\n"  << e);
+    }
+
+    _worlds.push_back(world);
+  }
+
+  return result;
+}
+
 /////////////////////////////////////////////////
 void Server::SigInt(int)
 {
@@ -674,6 +704,23 @@ void Server::ProcessControlMsgs()
     {
       this->OpenWorld((*iter).open_filename());
     }
+    else if ((*iter).has_add_world_filename())
+    {
+      this->AddWorlds((*iter).add_world_filename());
+    }
+    else if ((*iter).has_remove_world_name())
+    {
+      std::string worldName = (*iter).remove_world_name();
+      if (physics::remove_world(worldName))
+      {
+        msgs::WorldModify worldMsg;
+        worldMsg.set_world_name(worldName);
+        worldMsg.set_remove(true);
+        this->worldModPub->Publish(worldMsg);
+      }
+      else
+        gzerr << "Unable to remove unknown world [" << worldName << "]\n";
+    }
     else if ((*iter).has_stop() && (*iter).stop())
     {
       this->Stop();
@@ -682,6 +729,50 @@ void Server::ProcessControlMsgs()
   this->controlMsgs.clear();
 }
 
+/////////////////////////////////////////////////
+bool Server::AddWorlds(const std::string &_filename)
+{
+  sdf::SDFPtr sdf(new sdf::SDF);
+  if (!sdf::init(sdf))
+  {
+    gzerr << "Unable to initialize sdf\n";
+    return false;
+  }
+
+  if (!sdf::readFile(common::find_file(_filename), sdf))
+  {
+    gzerr << "Unable to read sdf file[" << _filename << "]\n";
+    return false;
+  }
+
+  physics::World_V worlds;
+  bool result;
+  try
+  {
+    result = this->LoadWorlds(sdf->Root(), "", worlds);
+  }
+  catch(common::Exception &e)
+  {
+    gzerr << "Unable to add the worlds of [" << _filename << "]: "
+          << e << "\n";
+    return false;
+  }
+
+  // The new worlds run next to the others, in their own threads.
+  for (auto &world : worlds)
+  {
+    physics::init_world(world);
+    physics::run_world(world);
+
+    msgs::WorldModify worldMsg;
+    worldMsg.set_world_name(world->GetName());
+    worldMsg.set_create(true);
+    this->worldModPub->Publish(worldMsg);
+  }
+
+  return result;
+}
+
 /////////////////////////////////////////////////
 bool Server::OpenWorld(const std::string & /*_filename*/)
 {
@@ -28,6 +28,7 @@
 #include "gazebo/msgs/msgs.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/common/CommonTypes.hh"
+#include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/util/system.hh"
 
 namespace boost
@@ -98,6 +99,19 @@ namespace gazebo
     private: bool LoadImpl(sdf::ElementPtr _elem,
                            const std::string &_physics="");
 
+    /// \brief Create and load every world of an SDF description. Each
+    /// world runs in its own thread, so a server may hold many worlds,
+    /// as long as their names differ.
+    /// \param[in] _elem Root of the SDF description.
+    /// \param[in] _physics Physics engine type (ode|bullet|dart|simbody),
+    /// or empty to use the engine of each world.
+    /// \param[out] _worlds The loaded worlds.
+    /// \return False if a world was not loaded because its name is
+    /// taken.
+    private: bool LoadWorlds(sdf::ElementPtr _elem,
+                             const std::string &_physics,
+                             physics::World_V &_worlds);
+
     /// \brief SIGINT handler
     /// \param[in] _v Unused.
     private: static void SigInt(int _v);
@@ -114,6 +128,12 @@ namespace gazebo
     /// \return True on success.
     private: bool OpenWorld(const std::string &_filename);
 
+    /// \brief Load the worlds of an SDF file and run them next to the
+    /// running worlds.
+    /// \param[in] _filename Name and path of the world file.
+    /// \return True if all the worlds were added.
+    private: bool AddWorlds(const std::string &_filename);
+
     /// \brief Handle all control messages.
     private: void ProcessControlMsgs();
 
@@ -25,6 +25,7 @@ EventT<void ()> Events::stop;
 EventT<void ()> Events::sigInt;
 
 EventT<void (std::string)> Events::worldCreated;
+EventT<void (std::string)> Events::worldRemoved;
 EventT<void (std::string)> Events::entityCreated;
 EventT<void (std::string, std::string)> Events::setSelectedEntity;
 EventT<void (std::string)> Events::addEntity;
@@ -83,6 +83,17 @@ namespace gazebo
       public: static void DisconnectWorldCreated(ConnectionPtr _subscriber)
               { worldCreated.Disconnect(_subscriber); }
 
+      //////////////////////////////////////////////////////////////////////////
+      /// \brief Connect a boost::slot the the world removed signal
+      /// \param[in] _subscriber the subscriber to this event
+      /// \return a connection
+      public: template<typename T>
+              static ConnectionPtr ConnectWorldRemoved(T _subscriber)
+              { return worldRemoved.Connect(_subscriber); }
+      /// \brief Disconnect a boost::slot the the world removed signal
+      public: static void DisconnectWorldRemoved(ConnectionPtr _subscriber)
+              { worldRemoved.Disconnect(_subscriber); }
+
       //////////////////////////////////////////////////////////////////////////
       /// \brief Connect a boost::slot the the add entity signal
       /// \param[in] _subscriber the subscriber to this event
@@ -250,6 +261,10 @@ namespace gazebo
       /// \brief A world has been created
       public: static EventT<void (std::string)> worldCreated;
 
+      /// \brief A world is being removed. Emitted before the world is
+      /// finalized, while it can still be used.
+      public: static EventT<void (std::string)> worldRemoved;
+
       /// \brief An entity has been created
       public: static EventT<void (std::string)> entityCreated;
 
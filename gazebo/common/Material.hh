@@ -17,6 +17,7 @@
 #ifndef _MATERIAL_HH_
 #define _MATERIAL_HH_
 
+#include <atomic>
 #include <string>
 #include <iostream>
 #include "gazebo/common/Color.hh"
@@ -222,8 +223,10 @@ namespace gazebo
       /// \brief the shade mode
       protected: ShadeMode shadeMode;
 
-      /// \brief the total number of instanciated Material instances
-      private: static unsigned int counter;
+      /// \brief the total number of instanciated Material instances.
+      /// Atomic, since meshes, and their materials, may be loaded by
+      /// several threads at once.
+      private: static std::atomic<unsigned int> counter;
 
       /// \brief flag to perform depth buffer write
       private: bool depthWrite;
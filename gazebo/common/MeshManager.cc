@@ -15,6 +15,7 @@
  *
  */
 #include <sys/stat.h>
+#include <algorithm>
 #include <string>
 #include <map>
 
@@ -45,9 +46,7 @@ using namespace common;
 //////////////////////////////////////////////////
 MeshManager::MeshManager()
 {
-  this->colladaLoader = new ColladaLoader();
   this->colladaExporter = new ColladaExporter();
-  this->stlLoader = new STLLoader();
 
   // Create some basic shapes
   this->CreatePlane("unit_plane",
@@ -78,9 +77,7 @@ MeshManager::MeshManager()
 //////////////////////////////////////////////////
 MeshManager::~MeshManager()
 {
-  delete this->colladaLoader;
   delete this->colladaExporter;
-  delete this->stlLoader;
   std::map<std::string, Mesh*>::iterator iter;
   for (iter = this->meshes.begin(); iter != this->meshes.end(); ++iter)
     delete iter->second;
@@ -96,71 +93,69 @@ const Mesh *MeshManager::Load(const std::string &_filename)
     return NULL;
   }
 
-  Mesh *mesh = NULL;
+  {
+    // Wait for another thread that is loading the same mesh.
+    boost::mutex::scoped_lock lock(this->mutex);
+    while (this->loading.count(_filename) > 0)
+      this->loadCondition.wait(lock);
 
-  std::string extension;
+    std::map<std::string, Mesh*>::iterator iter = this->meshes.find(_filename);
+    if (iter != this->meshes.end())
+      return iter->second;
 
-  if (this->HasMesh(_filename))
-  {
-    return this->meshes[_filename];
-
-    // This breaks trimesh geom. Each new trimesh should have a unique name.
-    /*
-    // erase mesh from this->meshes. This allows a mesh to be modified and
-    // inserted into gazebo again without closing gazebo.
-    std::map<std::string, Mesh*>::iterator iter;
-    iter = this->meshes.find(_filename);
-    delete iter->second;
-    iter->second = NULL;
-    this->meshes.erase(iter);
-    */
+    this->loading.insert(_filename);
   }
 
+  Mesh *mesh = NULL;
   std::string fullname = common::find_file(_filename);
 
-  if (!fullname.empty())
+  try
   {
-    extension = fullname.substr(fullname.rfind(".")+1, fullname.size());
-    std::transform(extension.begin(), extension.end(),
-        extension.begin(), ::tolower);
-    MeshLoader *loader = NULL;
-
-    if (extension == "stl" || extension == "stlb" || extension == "stla")
-      loader = this->stlLoader;
-    else if (extension == "dae")
-      loader = this->colladaLoader;
-    else
-      gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
-
-    try
+    if (!fullname.empty())
     {
-      // This mutex prevents two threads from loading the same mesh at the
-      // same time.
-      boost::mutex::scoped_lock lock(this->mutex);
-      if (!this->HasMesh(_filename))
-      {
-        if ((mesh = loader->Load(fullname)) != NULL)
-        {
-          mesh->SetName(_filename);
-          this->meshes.insert(std::make_pair(_filename, mesh));
-        }
-        else
-          gzerr << "Unable to load mesh[" << fullname << "]\n";
-      }
+      std::string extension = fullname.substr(fullname.rfind(".")+1,
+          fullname.size());
+      std::transform(extension.begin(), extension.end(),
+          extension.begin(), ::tolower);
+
+      // The loaders keep state while parsing, so each call has its own,
+      // and different meshes are parsed in parallel.
+      ColladaLoader colladaLoader;
+      STLLoader stlLoader;
+      MeshLoader *loader = NULL;
+
+      if (extension == "stl" || extension == "stlb" || extension == "stla")
+        loader = &stlLoader;
+      else if (extension == "dae")
+        loader = &colladaLoader;
       else
-      {
-        mesh = this->meshes[_filename];
-      }
-    }
-    catch(gazebo::common::Exception &e)
-    {
-      gzerr << "Error loading mesh[" << fullname << "]\n";
-      gzerr << e << "\n";
-      gzthrow(e);
+        gzerr << "Unsupported mesh format for file[" << _filename << "]\n";
+
+      if (loader && (mesh = loader->Load(fullname)) == NULL)
+        gzerr << "Unable to load mesh[" << fullname << "]\n";
     }
+    else
+      gzerr << "Unable to find file[" << _filename << "]\n";
   }
-  else
-    gzerr << "Unable to find file[" << _filename << "]\n";
+  catch(gazebo::common::Exception &e)
+  {
+    gzerr << "Error loading mesh[" << fullname << "]\n";
+    gzerr << e << "\n";
+
+    boost::mutex::scoped_lock lock(this->mutex);
+    this->loading.erase(_filename);
+    this->loadCondition.notify_all();
+    gzthrow(e);
+  }
+
+  boost::mutex::scoped_lock lock(this->mutex);
+  if (mesh)
+  {
+    mesh->SetName(_filename);
+    this->meshes.insert(std::make_pair(_filename, mesh));
+  }
+  this->loading.erase(_filename);
+  this->loadCondition.notify_all();
 
   return mesh;
 }
@@ -210,8 +205,11 @@ void MeshManager::GetMeshAABB(const Mesh *_mesh,
     ignition::math::Vector3d &_center,
     ignition::math::Vector3d &_minXYZ, ignition::math::Vector3d &_maxXYZ)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->meshes[_mesh->GetName()]->GetAABB(_center, _minXYZ, _maxXYZ);
+  boost::mutex::scoped_lock lock(this->mutex);
+  std::map<std::string, Mesh*>::iterator iter =
+    this->meshes.find(_mesh->GetName());
+  if (iter != this->meshes.end())
+    iter->second->GetAABB(_center, _minXYZ, _maxXYZ);
 }
 
 //////////////////////////////////////////////////
@@ -224,20 +222,25 @@ void MeshManager::GenSphericalTexCoord(const Mesh *_mesh, math::Vector3 _center)
 void MeshManager::GenSphericalTexCoord(const Mesh *_mesh,
     const ignition::math::Vector3d &_center)
 {
-  if (this->HasMesh(_mesh->GetName()))
-    this->meshes[_mesh->GetName()]->GenSphericalTexCoord(_center);
+  boost::mutex::scoped_lock lock(this->mutex);
+  std::map<std::string, Mesh*>::iterator iter =
+    this->meshes.find(_mesh->GetName());
+  if (iter != this->meshes.end())
+    iter->second->GenSphericalTexCoord(_center);
 }
 
 //////////////////////////////////////////////////
 void MeshManager::AddMesh(Mesh *_mesh)
 {
-  if (!this->HasMesh(_mesh->GetName()))
+  boost::mutex::scoped_lock lock(this->mutex);
+  if (this->meshes.find(_mesh->GetName()) == this->meshes.end())
     this->meshes[_mesh->GetName()] = _mesh;
 }
 
 //////////////////////////////////////////////////
 const Mesh *MeshManager::GetMesh(const std::string &_name) const
 {
+  boost::mutex::scoped_lock lock(this->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
 
   iter = this->meshes.find(_name);
@@ -254,12 +257,21 @@ bool MeshManager::HasMesh(const std::string &_name) const
   if (_name.empty())
     return false;
 
+  boost::mutex::scoped_lock lock(this->mutex);
   std::map<std::string, Mesh*>::const_iterator iter;
   iter = this->meshes.find(_name);
 
   return iter != this->meshes.end();
 }
 
+//////////////////////////////////////////////////
+void MeshManager::InsertMesh(Mesh *_mesh)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  if (!this->meshes.insert(std::make_pair(_mesh->GetName(), _mesh)).second)
+    delete _mesh;
+}
+
 //////////////////////////////////////////////////
 void MeshManager::CreateSphere(const std::string &name, float radius,
     int rings, int segments)
@@ -277,7 +289,6 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -318,6 +329,8 @@ void MeshManager::CreateSphere(const std::string &name, float radius,
       }
     }
   }
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -363,7 +376,6 @@ void MeshManager::CreatePlane(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -422,6 +434,8 @@ void MeshManager::CreatePlane(const std::string &_name,
   }
 
   this->Tesselate2DMesh(subMesh, _segments.X() + 1, _segments.Y() + 1, false);
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -445,7 +459,6 @@ void MeshManager::CreateBox(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -531,6 +544,8 @@ void MeshManager::CreateBox(const std::string &_name,
   // Set the indices
   for (i = 0; i < 36; ++i)
     subMesh->AddIndex(ind[i]);
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -586,7 +601,6 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -691,6 +705,7 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
   if (normals.size() != edges.size())
   {
     gzerr << "Unable to extrude mesh. Triangulation failed" << std::endl;
+    delete mesh;
     return;
   }
 
@@ -761,6 +776,8 @@ void MeshManager::CreateExtrudedPolyline(const std::string &_name,
       subMesh->AddNormal(normals[i]);
     }
   }
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -775,7 +792,6 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->meshes.insert(std::make_pair(_name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -858,6 +874,8 @@ void MeshManager::CreateCamera(const std::string &_name, float _scale)
     subMesh->AddIndex(ind[i]);
 
   mesh->RecalculateNormals();
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -876,7 +894,6 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -975,6 +992,8 @@ void MeshManager::CreateCylinder(const std::string &name, float radius,
       subMesh->AddIndex(verticeIndex - segments + seg);
     }
   }
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -993,7 +1012,6 @@ void MeshManager::CreateCone(const std::string &name, float radius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(name);
-  this->meshes.insert(std::make_pair(name, mesh));
 
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
@@ -1085,6 +1103,8 @@ void MeshManager::CreateCone(const std::string &name, float radius,
   }
 
   mesh->RecalculateNormals();
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -1110,7 +1130,6 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
 
   Mesh *mesh = new Mesh();
   mesh->SetName(_name);
-  this->meshes.insert(std::make_pair(_name, mesh));
   SubMesh *subMesh = new SubMesh();
   mesh->AddSubMesh(subMesh);
 
@@ -1252,6 +1271,8 @@ void MeshManager::CreateTube(const std::string &_name, float _innerRadius,
   }
 
   mesh->RecalculateNormals();
+
+  this->InsertMesh(mesh);
 }
 
 //////////////////////////////////////////////////
@@ -1338,7 +1359,7 @@ void MeshManager::CreateBoolean(const std::string &_name, const Mesh *_m1,
   MeshCSG csg;
   Mesh *mesh = csg.CreateBoolean(_m1, _m2, _operation, _offset);
   mesh->SetName(_name);
-  this->meshes.insert(std::make_pair(_name, mesh));
+  this->InsertMesh(mesh);
 }
 #endif
 
@@ -18,9 +18,11 @@
 #define _GAZEBO_MESHMANAGER_HH_
 
 #include <map>
+#include <set>
 #include <utility>
 #include <string>
 #include <vector>
+#include <boost/thread/condition_variable.hpp>
 #include <boost/thread/mutex.hpp>
 
 #include <ignition/math/Plane.hh>
@@ -41,9 +43,7 @@ namespace gazebo
 {
   namespace common
   {
-    class ColladaLoader;
     class ColladaExporter;
-    class STLLoader;
     class Mesh;
     class Plane;
     class SubMesh;
@@ -60,10 +60,12 @@ namespace gazebo
 
       /// \brief Destructor.
       ///
-      /// Destroys the collada loader, the stl loader and all the meshes
+      /// Destroys the collada exporter and all the meshes
       private: virtual ~MeshManager();
 
-      /// \brief Load a mesh from a file
+      /// \brief Load a mesh from a file. Different meshes may be loaded by
+      /// several threads at once; a thread that asks for a mesh another
+      /// thread is loading waits for it.
       /// \param[in] _filename the path to the mesh
       /// \return a pointer to the created mesh
       public: const Mesh *Load(const std::string &_filename);
@@ -354,22 +356,30 @@ namespace gazebo
                       const ignition::math::Vector2d &_p,
                       double _tol);
 
-      /// \brief 3D mesh loader for COLLADA files
-      private: ColladaLoader *colladaLoader;
+      /// \brief Add a mesh built by one of the Create functions. The mesh
+      /// is only added once it is complete, so other threads never see a
+      /// partial mesh. If another thread added a mesh with the same name
+      /// first, that one is kept.
+      /// \param[in] _mesh The new mesh, deleted if it is not added.
+      private: void InsertMesh(Mesh *_mesh);
 
       /// \brief 3D mesh exporter for COLLADA files
       private: ColladaExporter *colladaExporter;
 
-      /// \brief 3D mesh loader for STL files
-      private: STLLoader *stlLoader;
-
       /// \brief Dictionary of meshes, indexed by name
       private: std::map<std::string, Mesh*> meshes;
 
       /// \brief supported file extensions for meshes
       private: std::vector<std::string> fileExtensions;
 
-      private: boost::mutex mutex;
+      /// \brief Protects the meshes and the meshes being loaded.
+      private: mutable boost::mutex mutex;
+
+      /// \brief Names of the meshes being loaded.
+      private: std::set<std::string> loading;
+
+      /// \brief Notified when a mesh is done loading.
+      private: boost::condition_variable loadCondition;
 
       /// \brief Singleton implementation
       private: friend class SingletonT<MeshManager>;
@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <boost/thread.hpp>
+
+#include <string>
+#include <vector>
 
 #include "test_config.h"
 #include "gazebo/common/Mesh.hh"
@@ -245,6 +249,79 @@ TEST_F(MeshManager, CreateExtrudedPolylineClosedPath)
 }
 #endif
 
+/////////////////////////////////////////////////
+TEST_F(MeshManager, ParallelLoad)
+{
+  common::MeshManager *mgr = common::MeshManager::Instance();
+  std::vector<std::string> filenames;
+  filenames.push_back(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box.dae");
+  filenames.push_back(
+      std::string(PROJECT_SOURCE_PATH) + "/test/data/box_offset.dae");
+
+  // Several threads ask for the same meshes at once.
+  std::vector<const common::Mesh *> meshes(8, NULL);
+  std::vector<boost::thread *> threads;
+  for (unsigned int i = 0; i < meshes.size(); ++i)
+  {
+    threads.push_back(new boost::thread([&mgr, &meshes, &filenames, i]()
+        {
+          meshes[i] = mgr->Load(filenames[i % filenames.size()]);
+        }));
+  }
+  for (auto thread : threads)
+  {
+    thread->join();
+    delete thread;
+  }
+
+  // Each mesh is loaded once, and shared by the threads that asked for it.
+  for (unsigned int i = 0; i < meshes.size(); ++i)
+  {
+    ASSERT_TRUE(meshes[i] != NULL);
+    EXPECT_EQ(meshes[i], meshes[i % filenames.size()]);
+    EXPECT_EQ(meshes[i], mgr->GetMesh(filenames[i % filenames.size()]));
+  }
+  EXPECT_NE(meshes[0], meshes[1]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(MeshManager, ParallelCreate)
+{
+  common::MeshManager *mgr = common::MeshManager::Instance();
+
+  // Threads create meshes of the same names while others look them up.
+  std::vector<boost::thread *> threads;
+  for (unsigned int i = 0; i < 8; ++i)
+  {
+    threads.push_back(new boost::thread([&mgr, i]()
+        {
+          std::string name = "parallel_box_" + std::to_string(i % 2);
+          mgr->CreateBox(name, ignition::math::Vector3d(1, 2, 3),
+              ignition::math::Vector2d(1, 1));
+          const common::Mesh *mesh = mgr->GetMesh(name);
+          EXPECT_TRUE(mesh != NULL);
+          if (mesh)
+            EXPECT_EQ(mesh->GetVertexCount(), 24u);
+        }));
+  }
+  for (auto thread : threads)
+  {
+    thread->join();
+    delete thread;
+  }
+
+  const common::Mesh *box0 = mgr->GetMesh("parallel_box_0");
+  const common::Mesh *box1 = mgr->GetMesh("parallel_box_1");
+  ASSERT_TRUE(box0 != NULL);
+  ASSERT_TRUE(box1 != NULL);
+  EXPECT_NE(box0, box1);
+
+  ignition::math::Vector3d center, minXYZ, maxXYZ;
+  mgr->GetMeshAABB(box0, center, minXYZ, maxXYZ);
+  EXPECT_EQ(maxXYZ - minXYZ, ignition::math::Vector3d(1, 2, 3));
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -179,6 +179,15 @@ void PID::GetErrors(double &_pe, double &_ie, double &_de)
   _de = this->dErr;
 }
 
+/////////////////////////////////////////////////
+void PID::SetErrors(double _pe, double _ie, double _de)
+{
+  this->pErr = _pe;
+  this->pErrLast = _pe;
+  this->iErr = _ie;
+  this->dErr = _de;
+}
+
 /////////////////////////////////////////////////
 double PID::GetPGain() const
 {
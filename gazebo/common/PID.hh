@@ -143,6 +143,15 @@ namespace gazebo
       /// \param[in] _de  The derivative error.
       public: void GetErrors(double &_pe, double &_ie, double &_de);
 
+      /// \brief Set the PID error terms, for example to restore the state
+      /// of a controller saved with GetErrors. The proportional error is
+      /// also taken as the error of the previous update, which the next
+      /// update uses for the derivative error.
+      /// \param[in] _pe  The proportional error.
+      /// \param[in] _ie  The integral error.
+      /// \param[in] _de  The derivative error.
+      public: void SetErrors(double _pe, double _ie, double _de);
+
       /// \brief Assignment operator
       /// \param[in] _p a reference to a PID to assign values from
       /// \return reference to this instance
@@ -26,6 +26,7 @@
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 #include "gazebo/common/Exception.hh"
+#include "gazebo/physics/EntityRegistry.hh"
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Base.hh"
@@ -64,6 +65,10 @@ Base::~Base()
       (*iter)->SetParent(BasePtr());
   }
   this->children.clear();
+
+  if (this->world)
+    this->world->GetEntityRegistry()->Remove(this->id);
+
   if (this->sdf && this->GetWorld()) {
     boost::recursive_mutex::scoped_lock lock(*this->GetWorld()->GetElementResetMutex());
     this->sdf->Reset();
@@ -92,6 +97,10 @@ void Base::Load(sdf::ElementPtr _sdf)
   }
 
   this->ComputeScopedName();
+
+  // Index the entity once it is part of the world's entity tree.
+  if (parent_ && this->world)
+    this->world->GetEntityRegistry()->Add(shared_from_this());
 }
 
 //////////////////////////////////////////////////
@@ -113,6 +122,9 @@ void Base::Fini()
 
   this->children.clear();
 
+  if (this->world)
+    this->world->GetEntityRegistry()->Remove(this->id);
+
   this->world.reset();
 }
 
@@ -267,6 +279,14 @@ void Base::RemoveChildren()
 //////////////////////////////////////////////////
 BasePtr Base::GetById(unsigned int _id) const
 {
+  if (this->world)
+  {
+    BasePtr result = this->world->GetEntityRegistry()->GetById(_id);
+    if (result && result->GetParent().get() == this)
+      return result;
+    return BasePtr();
+  }
+
   BasePtr result;
   Base_V::const_iterator biter;
 
@@ -282,20 +302,51 @@ BasePtr Base::GetById(unsigned int _id) const
   return result;
 }
 
+//////////////////////////////////////////////////
+/// \brief Find a descendant of an entity by name or scoped name, in
+/// depth-first order.
+/// \param[in] _base The entity.
+/// \param[in] _name Name or scoped name of the descendant.
+/// \return The descendant, or NULL.
+static BasePtr findDescendant(const Base &_base, const std::string &_name)
+{
+  for (unsigned int i = 0; i < _base.GetChildCount(); ++i)
+  {
+    BasePtr child = _base.GetChild(i);
+    if (child->GetScopedName() == _name || child->GetName() == _name)
+      return child;
+
+    BasePtr result = findDescendant(*child, _name);
+    if (result)
+      return result;
+  }
+
+  return BasePtr();
+}
+
 //////////////////////////////////////////////////
 BasePtr Base::GetByName(const std::string &_name)
 {
   if (this->GetScopedName() == _name || this->GetName() == _name)
     return shared_from_this();
 
-  BasePtr result;
-  Base_V::const_iterator iter;
+  if (this->world)
+  {
+    EntityRegistryPtr registry = this->world->GetEntityRegistry();
 
-  for (iter = this->children.begin();
-      iter != this->children.end() && result == NULL; ++iter)
-    result = (*iter)->GetByName(_name);
+    // The world root is the ancestor of every indexed entity.
+    if (!this->GetParent())
+      return registry->GetByName(_name);
 
-  return result;
+    // Scoped names and the names of children are indexed.
+    BasePtr result = registry->GetByName(_name, this);
+    if (result)
+      return result;
+  }
+
+  // Deeper descendants are found in this entity's own subtree, so the
+  // cost does not depend on the size of the world.
+  return findDescendant(*this, _name);
 }
 
 //////////////////////////////////////////////////
@@ -322,6 +373,7 @@ void Base::ComputeScopedName()
 
   if (this->world) {
      this->worldScopedName = this->world->GetName() + "::" + this->scopedName;
+     this->world->GetEntityRegistry()->Update(*this);
   }
 }
 
@@ -374,9 +426,16 @@ bool Base::operator ==(const Base &ent) const
 //////////////////////////////////////////////////
 void Base::SetWorld(const WorldPtr &_newWorld)
 {
+  // Move the entity to the registry of its new world.
+  bool registered = this->world && this->world != _newWorld &&
+    this->world->GetEntityRegistry()->Remove(this->id);
+
   this->world = _newWorld;
   this->ComputeScopedName();
 
+  if (registered && this->world)
+    this->world->GetEntityRegistry()->Add(shared_from_this());
+
   Base_V::iterator iter;
   for (iter = this->children.begin(); iter != this->children.end(); ++iter)
   {
@@ -234,7 +234,7 @@ namespace gazebo
       public: BasePtr GetById(unsigned int _id) const;
       /// \endcond
 
-      /// \brief Get by name.
+      /// \brief Get by name. Scoped names are matched before names.
       /// \param[in] _name Get a child (or self) object by name
       /// \return A pointer to the object, NULL if not found
       public: BasePtr GetByName(const std::string &_name);
@@ -0,0 +1,572 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "gazebo/common/Assert.hh"
+#include "gazebo/physics/BoundingBoxTree.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+/// \brief Index used for a missing node.
+static const int kNullNode = -1;
+
+/////////////////////////////////////////////////
+static ignition::math::Box unionBox(const ignition::math::Box &_a,
+    const ignition::math::Box &_b)
+{
+  return ignition::math::Box(
+      ignition::math::Vector3d(
+        std::min(_a.Min().X(), _b.Min().X()),
+        std::min(_a.Min().Y(), _b.Min().Y()),
+        std::min(_a.Min().Z(), _b.Min().Z())),
+      ignition::math::Vector3d(
+        std::max(_a.Max().X(), _b.Max().X()),
+        std::max(_a.Max().Y(), _b.Max().Y()),
+        std::max(_a.Max().Z(), _b.Max().Z())));
+}
+
+/////////////////////////////////////////////////
+static double surfaceArea(const ignition::math::Box &_box)
+{
+  ignition::math::Vector3d d = _box.Max() - _box.Min();
+  return 2.0 * (d.X() * d.Y() + d.Y() * d.Z() + d.Z() * d.X());
+}
+
+/////////////////////////////////////////////////
+static bool overlaps(const ignition::math::Box &_a,
+    const ignition::math::Box &_b)
+{
+  return _a.Min().X() <= _b.Max().X() && _b.Min().X() <= _a.Max().X() &&
+         _a.Min().Y() <= _b.Max().Y() && _b.Min().Y() <= _a.Max().Y() &&
+         _a.Min().Z() <= _b.Max().Z() && _b.Min().Z() <= _a.Max().Z();
+}
+
+/////////////////////////////////////////////////
+static bool contains(const ignition::math::Box &_outer,
+    const ignition::math::Box &_inner)
+{
+  return _outer.Min().X() <= _inner.Min().X() &&
+         _outer.Min().Y() <= _inner.Min().Y() &&
+         _outer.Min().Z() <= _inner.Min().Z() &&
+         _inner.Max().X() <= _outer.Max().X() &&
+         _inner.Max().Y() <= _outer.Max().Y() &&
+         _inner.Max().Z() <= _outer.Max().Z();
+}
+
+/////////////////////////////////////////////////
+static double squaredDistance(const ignition::math::Box &_box,
+    const ignition::math::Vector3d &_p)
+{
+  double dx = std::max(0.0,
+      std::max(_box.Min().X() - _p.X(), _p.X() - _box.Max().X()));
+  double dy = std::max(0.0,
+      std::max(_box.Min().Y() - _p.Y(), _p.Y() - _box.Max().Y()));
+  double dz = std::max(0.0,
+      std::max(_box.Min().Z() - _p.Z(), _p.Z() - _box.Max().Z()));
+  return dx * dx + dy * dy + dz * dz;
+}
+
+/////////////////////////////////////////////////
+BoundingBoxTree::BoundingBoxTree(double _margin)
+  : root(kNullNode), freeList(kNullNode), leafCount(0),
+    margin(std::max(0.0, _margin))
+{
+}
+
+/////////////////////////////////////////////////
+BoundingBoxTree::~BoundingBoxTree()
+{
+}
+
+/////////////////////////////////////////////////
+int BoundingBoxTree::AllocateNode()
+{
+  int index;
+  if (this->freeList != kNullNode)
+  {
+    index = this->freeList;
+    this->freeList = this->nodes[index].parent;
+  }
+  else
+  {
+    index = this->nodes.size();
+    this->nodes.push_back(Node());
+  }
+
+  Node &node = this->nodes[index];
+  node.parent = kNullNode;
+  node.child1 = kNullNode;
+  node.child2 = kNullNode;
+  node.height = 0;
+  node.id = 0;
+  return index;
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::FreeNode(int _node)
+{
+  this->nodes[_node].parent = this->freeList;
+  this->nodes[_node].height = -1;
+  this->freeList = _node;
+}
+
+/////////////////////////////////////////////////
+int BoundingBoxTree::Insert(const ignition::math::Box &_box, uint32_t _id)
+{
+  ignition::math::Vector3d m(this->margin, this->margin, this->margin);
+
+  int leaf = this->AllocateNode();
+  this->nodes[leaf].box = _box;
+  this->nodes[leaf].fatBox =
+    ignition::math::Box(_box.Min() - m, _box.Max() + m);
+  this->nodes[leaf].id = _id;
+
+  this->InsertLeaf(leaf);
+  ++this->leafCount;
+  return leaf;
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::Remove(int _proxy)
+{
+  GZ_ASSERT(_proxy >= 0 && _proxy < static_cast<int>(this->nodes.size()) &&
+      this->nodes[_proxy].height == 0, "Invalid bounding box tree proxy");
+
+  this->RemoveLeaf(_proxy);
+  this->FreeNode(_proxy);
+  --this->leafCount;
+}
+
+/////////////////////////////////////////////////
+bool BoundingBoxTree::Update(int _proxy, const ignition::math::Box &_box)
+{
+  GZ_ASSERT(_proxy >= 0 && _proxy < static_cast<int>(this->nodes.size()) &&
+      this->nodes[_proxy].height == 0, "Invalid bounding box tree proxy");
+
+  this->nodes[_proxy].box = _box;
+  if (contains(this->nodes[_proxy].fatBox, _box))
+    return false;
+
+  ignition::math::Vector3d m(this->margin, this->margin, this->margin);
+
+  this->RemoveLeaf(_proxy);
+  this->nodes[_proxy].fatBox =
+    ignition::math::Box(_box.Min() - m, _box.Max() + m);
+  this->InsertLeaf(_proxy);
+  return true;
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::Clear()
+{
+  this->nodes.clear();
+  this->root = kNullNode;
+  this->freeList = kNullNode;
+  this->leafCount = 0;
+}
+
+/////////////////////////////////////////////////
+unsigned int BoundingBoxTree::GetLeafCount() const
+{
+  return this->leafCount;
+}
+
+/////////////////////////////////////////////////
+int BoundingBoxTree::GetHeight() const
+{
+  return this->root == kNullNode ? -1 : this->nodes[this->root].height;
+}
+
+/////////////////////////////////////////////////
+const ignition::math::Box &BoundingBoxTree::GetBox(int _proxy) const
+{
+  GZ_ASSERT(_proxy >= 0 && _proxy < static_cast<int>(this->nodes.size()),
+      "Invalid bounding box tree proxy");
+  return this->nodes[_proxy].box;
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::InsertLeaf(int _leaf)
+{
+  if (this->root == kNullNode)
+  {
+    this->root = _leaf;
+    this->nodes[_leaf].parent = kNullNode;
+    return;
+  }
+
+  // Find the best sibling, descending while a child is cheaper than
+  // pairing with the current node.
+  ignition::math::Box leafBox = this->nodes[_leaf].fatBox;
+  int index = this->root;
+  while (this->nodes[index].child1 != kNullNode)
+  {
+    const Node &node = this->nodes[index];
+
+    double area = surfaceArea(node.fatBox);
+    double combinedArea = surfaceArea(unionBox(node.fatBox, leafBox));
+
+    // Cost of a new parent for this node and the leaf.
+    double cost = 2.0 * combinedArea;
+
+    // Minimum cost of pushing the leaf further down.
+    double inheritanceCost = 2.0 * (combinedArea - area);
+
+    double childCost[2];
+    int children[2] = {node.child1, node.child2};
+    for (int i = 0; i < 2; ++i)
+    {
+      const Node &child = this->nodes[children[i]];
+      double unionArea = surfaceArea(unionBox(leafBox, child.fatBox));
+      childCost[i] = inheritanceCost + (child.child1 == kNullNode ?
+          unionArea : unionArea - surfaceArea(child.fatBox));
+    }
+
+    if (cost < childCost[0] && cost < childCost[1])
+      break;
+
+    index = childCost[0] < childCost[1] ? children[0] : children[1];
+  }
+
+  int sibling = index;
+
+  // Create a new parent for the sibling and the leaf.
+  int oldParent = this->nodes[sibling].parent;
+  int newParent = this->AllocateNode();
+  this->nodes[newParent].parent = oldParent;
+  this->nodes[newParent].fatBox =
+    unionBox(leafBox, this->nodes[sibling].fatBox);
+  this->nodes[newParent].height = this->nodes[sibling].height + 1;
+  this->nodes[newParent].child1 = sibling;
+  this->nodes[newParent].child2 = _leaf;
+  this->nodes[sibling].parent = newParent;
+  this->nodes[_leaf].parent = newParent;
+
+  if (oldParent != kNullNode)
+  {
+    if (this->nodes[oldParent].child1 == sibling)
+      this->nodes[oldParent].child1 = newParent;
+    else
+      this->nodes[oldParent].child2 = newParent;
+  }
+  else
+    this->root = newParent;
+
+  this->FixUpwards(oldParent);
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::RemoveLeaf(int _leaf)
+{
+  if (_leaf == this->root)
+  {
+    this->root = kNullNode;
+    return;
+  }
+
+  int parent = this->nodes[_leaf].parent;
+  int grandParent = this->nodes[parent].parent;
+  int sibling = this->nodes[parent].child1 == _leaf ?
+    this->nodes[parent].child2 : this->nodes[parent].child1;
+
+  // The sibling takes the parent's place.
+  if (grandParent != kNullNode)
+  {
+    if (this->nodes[grandParent].child1 == parent)
+      this->nodes[grandParent].child1 = sibling;
+    else
+      this->nodes[grandParent].child2 = sibling;
+  }
+  else
+    this->root = sibling;
+
+  this->nodes[sibling].parent = grandParent;
+  this->FreeNode(parent);
+
+  this->FixUpwards(grandParent);
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::FixUpwards(int _node)
+{
+  int index = _node;
+  while (index != kNullNode)
+  {
+    index = this->Balance(index);
+
+    Node &node = this->nodes[index];
+    const Node &child1 = this->nodes[node.child1];
+    const Node &child2 = this->nodes[node.child2];
+
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.fatBox = unionBox(child1.fatBox, child2.fatBox);
+
+    index = node.parent;
+  }
+}
+
+/////////////////////////////////////////////////
+int BoundingBoxTree::Balance(int _a)
+{
+  Node &a = this->nodes[_a];
+  if (a.child1 == kNullNode || a.height < 2)
+    return _a;
+
+  int iB = a.child1;
+  int iC = a.child2;
+  Node &b = this->nodes[iB];
+  Node &c = this->nodes[iC];
+
+  int balance = c.height - b.height;
+
+  // Rotate C up.
+  if (balance > 1)
+  {
+    int iF = c.child1;
+    int iG = c.child2;
+    Node &f = this->nodes[iF];
+    Node &g = this->nodes[iG];
+
+    c.child1 = _a;
+    c.parent = a.parent;
+    a.parent = iC;
+
+    if (c.parent != kNullNode)
+    {
+      if (this->nodes[c.parent].child1 == _a)
+        this->nodes[c.parent].child1 = iC;
+      else
+        this->nodes[c.parent].child2 = iC;
+    }
+    else
+      this->root = iC;
+
+    // Keep the taller of C's children under C.
+    if (f.height > g.height)
+    {
+      c.child2 = iF;
+      a.child2 = iG;
+      g.parent = _a;
+      a.fatBox = unionBox(b.fatBox, g.fatBox);
+      c.fatBox = unionBox(a.fatBox, f.fatBox);
+      a.height = 1 + std::max(b.height, g.height);
+      c.height = 1 + std::max(a.height, f.height);
+    }
+    else
+    {
+      c.child2 = iG;
+      a.child2 = iF;
+      f.parent = _a;
+      a.fatBox = unionBox(b.fatBox, f.fatBox);
+      c.fatBox = unionBox(a.fatBox, g.fatBox);
+      a.height = 1 + std::max(b.height, f.height);
+      c.height = 1 + std::max(a.height, g.height);
+    }
+
+    return iC;
+  }
+
+  // Rotate B up.
+  if (balance < -1)
+  {
+    int iD = b.child1;
+    int iE = b.child2;
+    Node &d = this->nodes[iD];
+    Node &e = this->nodes[iE];
+
+    b.child1 = _a;
+    b.parent = a.parent;
+    a.parent = iB;
+
+    if (b.parent != kNullNode)
+    {
+      if (this->nodes[b.parent].child1 == _a)
+        this->nodes[b.parent].child1 = iB;
+      else
+        this->nodes[b.parent].child2 = iB;
+    }
+    else
+      this->root = iB;
+
+    // Keep the taller of B's children under B.
+    if (d.height > e.height)
+    {
+      b.child2 = iD;
+      a.child1 = iE;
+      e.parent = _a;
+      a.fatBox = unionBox(c.fatBox, e.fatBox);
+      b.fatBox = unionBox(a.fatBox, d.fatBox);
+      a.height = 1 + std::max(c.height, e.height);
+      b.height = 1 + std::max(a.height, d.height);
+    }
+    else
+    {
+      b.child2 = iE;
+      a.child1 = iD;
+      d.parent = _a;
+      a.fatBox = unionBox(c.fatBox, d.fatBox);
+      b.fatBox = unionBox(a.fatBox, e.fatBox);
+      a.height = 1 + std::max(c.height, d.height);
+      b.height = 1 + std::max(a.height, e.height);
+    }
+
+    return iB;
+  }
+
+  return _a;
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::QueryBox(const ignition::math::Box &_box,
+    std::vector<uint32_t> &_ids) const
+{
+  if (this->root == kNullNode)
+    return;
+
+  std::vector<int> stack;
+  stack.push_back(this->root);
+  while (!stack.empty())
+  {
+    const Node &node = this->nodes[stack.back()];
+    stack.pop_back();
+
+    if (node.child1 == kNullNode)
+    {
+      if (overlaps(node.box, _box))
+        _ids.push_back(node.id);
+    }
+    else if (overlaps(node.fatBox, _box))
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::QuerySphere(const ignition::math::Vector3d &_center,
+    double _radius, std::vector<uint32_t> &_ids) const
+{
+  if (this->root == kNullNode)
+    return;
+
+  double radius2 = _radius * _radius;
+
+  std::vector<int> stack;
+  stack.push_back(this->root);
+  while (!stack.empty())
+  {
+    const Node &node = this->nodes[stack.back()];
+    stack.pop_back();
+
+    if (node.child1 == kNullNode)
+    {
+      if (squaredDistance(node.box, _center) <= radius2)
+        _ids.push_back(node.id);
+    }
+    else if (squaredDistance(node.fatBox, _center) <= radius2)
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void BoundingBoxTree::QueryFrustum(const ignition::math::Frustum &_frustum,
+    std::vector<uint32_t> &_ids) const
+{
+  if (this->root == kNullNode)
+    return;
+
+  std::vector<int> stack;
+  stack.push_back(this->root);
+  while (!stack.empty())
+  {
+    const Node &node = this->nodes[stack.back()];
+    stack.pop_back();
+
+    if (node.child1 == kNullNode)
+    {
+      if (_frustum.Contains(node.box))
+        _ids.push_back(node.id);
+    }
+    else if (_frustum.Contains(node.fatBox))
+    {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+bool BoundingBoxTree::QueryNearest(const ignition::math::Vector3d &_point,
+    uint32_t _exclude, uint32_t &_id, double &_distance) const
+{
+  if (this->root == kNullNode)
+    return false;
+
+  // Best first search, ordered by the squared distance to each node's box.
+  typedef std::pair<double, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+  queue.push(Entry(squaredDistance(this->nodes[this->root].fatBox, _point),
+        this->root));
+
+  bool found = false;
+  double best = 0;
+
+  while (!queue.empty())
+  {
+    Entry entry = queue.top();
+    queue.pop();
+
+    // Nothing left can be nearer than the best leaf.
+    if (found && entry.first >= best)
+      break;
+
+    const Node &node = this->nodes[entry.second];
+    if (node.child1 == kNullNode)
+    {
+      if (node.id == _exclude)
+        continue;
+
+      double dist = squaredDistance(node.box, _point);
+      if (!found || dist < best)
+      {
+        found = true;
+        best = dist;
+        _id = node.id;
+      }
+    }
+    else
+    {
+      queue.push(Entry(squaredDistance(this->nodes[node.child1].fatBox,
+              _point), node.child1));
+      queue.push(Entry(squaredDistance(this->nodes[node.child2].fatBox,
+              _point), node.child2));
+    }
+  }
+
+  if (found)
+    _distance = std::sqrt(best);
+  return found;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_PHYSICS_BOUNDINGBOXTREE_HH_
+#define _GAZEBO_PHYSICS_BOUNDINGBOXTREE_HH_
+
+#include <stdint.h>
+#include <vector>
+
+#include <ignition/math/Box.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class BoundingBoxTree BoundingBoxTree.hh physics/physics.hh
+    /// \brief A dynamic bounding volume tree of axis aligned boxes.
+    ///
+    /// Each leaf holds a box and a user id. The tree is built from boxes
+    /// enlarged by a margin, so a leaf whose box moves within its enlarged
+    /// box does not change the tree. Leaves are inserted where they least
+    /// increase the tree's surface area, and the tree is kept balanced
+    /// with rotations, so updates cost O(log n) and queries cost
+    /// O(log n) per result.
+    class GZ_PHYSICS_VISIBLE BoundingBoxTree
+    {
+      /// \brief Constructor.
+      /// \param[in] _margin Distance by which leaf boxes are enlarged in
+      /// the tree.
+      public: explicit BoundingBoxTree(double _margin = 0.1);
+
+      /// \brief Destructor.
+      public: virtual ~BoundingBoxTree();
+
+      /// \brief Add a leaf.
+      /// \param[in] _box Box of the leaf.
+      /// \param[in] _id User id returned by queries.
+      /// \return Proxy of the leaf, used to update or remove it.
+      public: int Insert(const ignition::math::Box &_box, uint32_t _id);
+
+      /// \brief Remove a leaf.
+      /// \param[in] _proxy Proxy returned by Insert.
+      public: void Remove(int _proxy);
+
+      /// \brief Move a leaf.
+      /// \param[in] _proxy Proxy returned by Insert.
+      /// \param[in] _box New box of the leaf.
+      /// \return True if the leaf left its enlarged box and was
+      /// reinserted.
+      public: bool Update(int _proxy, const ignition::math::Box &_box);
+
+      /// \brief Remove all leaves.
+      public: void Clear();
+
+      /// \brief Get the number of leaves.
+      /// \return Number of leaves.
+      public: unsigned int GetLeafCount() const;
+
+      /// \brief Get the height of the tree.
+      /// \return Height of the root, or -1 if the tree is empty.
+      public: int GetHeight() const;
+
+      /// \brief Get the box of a leaf.
+      /// \param[in] _proxy Proxy returned by Insert.
+      /// \return Box of the leaf, as last inserted or updated.
+      public: const ignition::math::Box &GetBox(int _proxy) const;
+
+      /// \brief Get the ids of the leaves whose box intersects a box.
+      /// \param[in] _box Box to test.
+      /// \param[out] _ids Ids of the intersecting leaves are appended.
+      public: void QueryBox(const ignition::math::Box &_box,
+                  std::vector<uint32_t> &_ids) const;
+
+      /// \brief Get the ids of the leaves whose box intersects a sphere.
+      /// \param[in] _center Center of the sphere.
+      /// \param[in] _radius Radius of the sphere.
+      /// \param[out] _ids Ids of the intersecting leaves are appended.
+      public: void QuerySphere(const ignition::math::Vector3d &_center,
+                  double _radius, std::vector<uint32_t> &_ids) const;
+
+      /// \brief Get the ids of the leaves whose box is in a frustum, as
+      /// tested by Frustum::Contains.
+      /// \param[in] _frustum Frustum to test.
+      /// \param[out] _ids Ids of the leaves in the frustum are appended.
+      public: void QueryFrustum(const ignition::math::Frustum &_frustum,
+                  std::vector<uint32_t> &_ids) const;
+
+      /// \brief Get the leaf whose box is nearest to a point.
+      /// \param[in] _point Point to measure from.
+      /// \param[in] _exclude Id of a leaf to ignore.
+      /// \param[out] _id Id of the nearest leaf.
+      /// \param[out] _distance Distance from the point to the leaf's box.
+      /// Zero if the point is inside the box.
+      /// \return False if the tree has no leaf other than _exclude.
+      public: bool QueryNearest(const ignition::math::Vector3d &_point,
+                  uint32_t _exclude, uint32_t &_id, double &_distance) const;
+
+      /// \brief A node of the tree.
+      private: class Node
+      {
+        /// \brief Enlarged box of a leaf, or the union of the children's
+        /// boxes for an internal node.
+        public: ignition::math::Box fatBox;
+
+        /// \brief Box of a leaf.
+        public: ignition::math::Box box;
+
+        /// \brief Parent node, or the next free node when unused.
+        public: int parent;
+
+        /// \brief First child, or -1 for a leaf.
+        public: int child1;
+
+        /// \brief Second child, or -1 for a leaf.
+        public: int child2;
+
+        /// \brief Height of the node. Zero for a leaf, -1 when unused.
+        public: int height;
+
+        /// \brief User id of a leaf.
+        public: uint32_t id;
+      };
+
+      /// \brief Get an unused node.
+      /// \return Index of the node.
+      private: int AllocateNode();
+
+      /// \brief Return a node to the free list.
+      /// \param[in] _node Index of the node.
+      private: void FreeNode(int _node);
+
+      /// \brief Insert a leaf node into the tree.
+      /// \param[in] _leaf Index of the leaf.
+      private: void InsertLeaf(int _leaf);
+
+      /// \brief Detach a leaf node from the tree.
+      /// \param[in] _leaf Index of the leaf.
+      private: void RemoveLeaf(int _leaf);
+
+      /// \brief Refit and rebalance the ancestors of a node, from the
+      /// node to the root.
+      /// \param[in] _node Index of the first node to fix.
+      private: void FixUpwards(int _node);
+
+      /// \brief Rotate a node's taller child up if the node is
+      /// unbalanced.
+      /// \param[in] _node Index of the node.
+      /// \return Index of the node that took _node's place.
+      private: int Balance(int _node);
+
+      /// \brief Nodes of the tree, used and free.
+      private: std::vector<Node> nodes;
+
+      /// \brief Index of the root node, or -1.
+      private: int root;
+
+      /// \brief Index of the first free node, or -1.
+      private: int freeList;
+
+      /// \brief Number of leaves.
+      private: unsigned int leafCount;
+
+      /// \brief Distance by which leaf boxes are enlarged.
+      private: double margin;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <ignition/math/Helpers.hh>
+
+#include "test/util.hh"
+#include "gazebo/math/Rand.hh"
+#include "gazebo/physics/BoundingBoxTree.hh"
+
+using namespace gazebo;
+
+class BoundingBoxTreeTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get a unit box with its min corner at a point.
+ignition::math::Box unitBox(double _x, double _y, double _z)
+{
+  return ignition::math::Box(ignition::math::Vector3d(_x, _y, _z),
+      ignition::math::Vector3d(_x + 1, _y + 1, _z + 1));
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundingBoxTreeTest, Empty)
+{
+  physics::BoundingBoxTree tree;
+  EXPECT_EQ(tree.GetLeafCount(), 0u);
+  EXPECT_EQ(tree.GetHeight(), -1);
+
+  std::vector<uint32_t> ids;
+  tree.QueryBox(unitBox(0, 0, 0), ids);
+  tree.QuerySphere(ignition::math::Vector3d::Zero, 10, ids);
+  EXPECT_TRUE(ids.empty());
+
+  uint32_t id;
+  double dist;
+  EXPECT_FALSE(tree.QueryNearest(ignition::math::Vector3d::Zero, 0, id,
+        dist));
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundingBoxTreeTest, InsertUpdateRemove)
+{
+  physics::BoundingBoxTree tree(0.5);
+  int a = tree.Insert(unitBox(0, 0, 0), 1);
+  int b = tree.Insert(unitBox(10, 0, 0), 2);
+  EXPECT_EQ(tree.GetLeafCount(), 2u);
+  EXPECT_EQ(tree.GetHeight(), 1);
+
+  std::vector<uint32_t> ids;
+  tree.QueryBox(unitBox(0.5, 0.5, 0.5), ids);
+  ASSERT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], 1u);
+
+  // A small move stays within the margin.
+  EXPECT_FALSE(tree.Update(a, unitBox(0.2, 0, 0)));
+  EXPECT_EQ(tree.GetBox(a).Min().X(), 0.2);
+
+  // The box, not the enlarged box, is used for leaves.
+  ids.clear();
+  tree.QueryBox(unitBox(-1.1, 0, 0), ids);
+  EXPECT_TRUE(ids.empty());
+
+  // A large move reinserts the leaf.
+  EXPECT_TRUE(tree.Update(a, unitBox(20, 0, 0)));
+  ids.clear();
+  tree.QueryBox(unitBox(20, 0, 0), ids);
+  ASSERT_EQ(ids.size(), 1u);
+  EXPECT_EQ(ids[0], 1u);
+
+  tree.Remove(b);
+  EXPECT_EQ(tree.GetLeafCount(), 1u);
+  EXPECT_EQ(tree.GetHeight(), 0);
+  ids.clear();
+  tree.QueryBox(unitBox(10, 0, 0), ids);
+  EXPECT_TRUE(ids.empty());
+
+  tree.Clear();
+  EXPECT_EQ(tree.GetLeafCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(BoundingBoxTreeTest, Nearest)
+{
+  physics::BoundingBoxTree tree;
+  tree.Insert(unitBox(0, 0, 0), 1);
+  tree.Insert(unitBox(5, 0, 0), 2);
+  tree.Insert(unitBox(0, 8, 0), 3);
+
+  uint32_t id = 0;
+  double dist = 0;
+  EXPECT_TRUE(tree.QueryNearest(ignition::math::Vector3d(7, 0.5, 0.5), 0,
+        id, dist));
+  EXPECT_EQ(id, 2u);
+  EXPECT_DOUBLE_EQ(dist, 1.0);
+
+  // Inside a box the distance is zero, unless that box is excluded.
+  EXPECT_TRUE(tree.QueryNearest(ignition::math::Vector3d(0.5, 0.5, 0.5), 0,
+        id, dist));
+  EXPECT_EQ(id, 1u);
+  EXPECT_DOUBLE_EQ(dist, 0.0);
+
+  EXPECT_TRUE(tree.QueryNearest(ignition::math::Vector3d(0.5, 0.5, 0.5), 1,
+        id, dist));
+  EXPECT_EQ(id, 2u);
+  EXPECT_DOUBLE_EQ(dist, 4.5);
+}
+
+/////////////////////////////////////////////////
+// Compare queries against a brute force search while leaves are moved,
+// added and removed.
+TEST_F(BoundingBoxTreeTest, BruteForce)
+{
+  physics::BoundingBoxTree tree;
+  std::map<uint32_t, std::pair<int, ignition::math::Box> > leaves;
+
+  for (uint32_t i = 0; i < 500; ++i)
+  {
+    ignition::math::Box box = unitBox(math::Rand::GetDblUniform(0, 100),
+        math::Rand::GetDblUniform(0, 100), math::Rand::GetDblUniform(0, 100));
+    leaves[i] = std::make_pair(tree.Insert(box, i), box);
+  }
+
+  for (int i = 0; i < 2000; ++i)
+  {
+    uint32_t id = math::Rand::GetIntUniform(0, 499);
+    ignition::math::Box box = unitBox(math::Rand::GetDblUniform(0, 100),
+        math::Rand::GetDblUniform(0, 100), math::Rand::GetDblUniform(0, 100));
+
+    if (leaves.find(id) == leaves.end())
+      leaves[id] = std::make_pair(tree.Insert(box, id), box);
+    else if (i % 3 == 0)
+    {
+      tree.Remove(leaves[id].first);
+      leaves.erase(id);
+    }
+    else
+    {
+      tree.Update(leaves[id].first, box);
+      leaves[id].second = box;
+    }
+  }
+
+  EXPECT_EQ(tree.GetLeafCount(), leaves.size());
+
+  // A balanced tree of n leaves is no taller than about 2 log2(n).
+  EXPECT_LE(tree.GetHeight(), 20);
+
+  for (int i = 0; i < 50; ++i)
+  {
+    ignition::math::Vector3d center(math::Rand::GetDblUniform(0, 100),
+        math::Rand::GetDblUniform(0, 100), math::Rand::GetDblUniform(0, 100));
+    ignition::math::Box query(center - ignition::math::Vector3d(5, 5, 5),
+        center + ignition::math::Vector3d(5, 5, 5));
+
+    std::vector<uint32_t> ids;
+    tree.QueryBox(query, ids);
+    std::sort(ids.begin(), ids.end());
+
+    std::vector<uint32_t> expected;
+    for (auto const &leaf : leaves)
+    {
+      const ignition::math::Box &box = leaf.second.second;
+      if (box.Min().X() <= query.Max().X() &&
+          query.Min().X() <= box.Max().X() &&
+          box.Min().Y() <= query.Max().Y() &&
+          query.Min().Y() <= box.Max().Y() &&
+          box.Min().Z() <= query.Max().Z() &&
+          query.Min().Z() <= box.Max().Z())
+      {
+        expected.push_back(leaf.first);
+      }
+    }
+    EXPECT_EQ(ids, expected);
+  }
+}
+
+/////////////////////////////////////////////////
+// Compare frustum queries against testing every leaf. A leaf box that the
+// frustum contains is inside every box that encloses it, so the tree
+// returns exactly the leaves Frustum::Contains accepts.
+TEST_F(BoundingBoxTreeTest, Frustum)
+{
+  physics::BoundingBoxTree tree;
+  std::vector<ignition::math::Box> boxes;
+
+  for (uint32_t i = 0; i < 500; ++i)
+  {
+    boxes.push_back(unitBox(math::Rand::GetDblUniform(-50, 50),
+          math::Rand::GetDblUniform(-50, 50),
+          math::Rand::GetDblUniform(-50, 50)));
+    tree.Insert(boxes.back(), i);
+  }
+
+  ignition::math::Frustum frustum;
+  frustum.SetNear(0.1);
+  frustum.SetFar(40);
+  frustum.SetFOV(IGN_DTOR(60));
+  frustum.SetAspectRatio(1.5);
+
+  for (int i = 0; i < 50; ++i)
+  {
+    frustum.SetPose(ignition::math::Pose3d(
+        math::Rand::GetDblUniform(-20, 20), math::Rand::GetDblUniform(-20, 20),
+        math::Rand::GetDblUniform(-20, 20), 0,
+        math::Rand::GetDblUniform(-1, 1), math::Rand::GetDblUniform(-3, 3)));
+
+    std::vector<uint32_t> ids;
+    tree.QueryFrustum(frustum, ids);
+    std::sort(ids.begin(), ids.end());
+
+    std::vector<uint32_t> expected;
+    for (uint32_t j = 0; j < boxes.size(); ++j)
+    {
+      if (frustum.Contains(boxes[j]))
+        expected.push_back(j);
+    }
+
+    EXPECT_EQ(ids, expected);
+  }
+
+  // A frustum far from every box finds nothing.
+  frustum.SetPose(ignition::math::Pose3d(500, 500, 500, 0, 0, 0));
+  std::vector<uint32_t> ids;
+  tree.QueryFrustum(frustum, ids);
+  EXPECT_TRUE(ids.empty());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -244,18 +244,29 @@ void ContactManager::PublishContacts()
       iter != this->customContactPublishers.end(); ++iter)
   {
     ContactPublisher *contactPublisher = iter->second;
-    msgs::Contacts msg2;
-    for (unsigned int j = 0;
-        j < contactPublisher->contacts.size(); ++j)
+
+    // Hand the contacts directly to an in-process consumer.
+    if (contactPublisher->callback)
+      contactPublisher->callback(contactPublisher->contacts);
+
+    // Without a direct consumer, keep publishing unconditionally as
+    // before. With one, only serialize for actual subscribers.
+    if (!contactPublisher->callback ||
+        contactPublisher->publisher->HasConnections())
     {
-      if (contactPublisher->contacts[j]->count == 0)
-        continue;
+      msgs::Contacts msg2;
+      for (unsigned int j = 0;
+          j < contactPublisher->contacts.size(); ++j)
+      {
+        if (contactPublisher->contacts[j]->count == 0)
+          continue;
 
-      msgs::Contact *contactMsg = msg2.add_contact();
-      contactPublisher->contacts[j]->FillMsg(*contactMsg);
+        msgs::Contact *contactMsg = msg2.add_contact();
+        contactPublisher->contacts[j]->FillMsg(*contactMsg);
+      }
+      msgs::Set(msg2.mutable_time(), this->world->GetSimTime());
+      contactPublisher->publisher->Publish(msg2);
     }
-    msgs::Set(msg2.mutable_time(), this->world->GetSimTime());
-    contactPublisher->publisher->Publish(msg2);
     contactPublisher->contacts.clear();
   }
 }
@@ -352,6 +363,24 @@ std::string ContactManager::CreateFilter(const std::string &_name,
   return topic;
 }
 
+/////////////////////////////////////////////////
+bool ContactManager::SetFilterCallback(const std::string &_name,
+    const boost::function<void (const std::vector<Contact *> &)> &_callback)
+{
+  std::string name = _name;
+  boost::replace_all(name, "::", "/");
+
+  boost::recursive_mutex::scoped_lock lock(*this->customMutex);
+  boost::unordered_map<std::string, ContactPublisher *>::iterator iter
+      = this->customContactPublishers.find(name);
+
+  if (iter == this->customContactPublishers.end())
+    return false;
+
+  iter->second->callback = _callback;
+  return true;
+}
+
 /////////////////////////////////////////////////
 void ContactManager::RemoveFilter(std::string _name)
 {
@@ -364,6 +393,7 @@ void ContactManager::RemoveFilter(std::string _name)
   {
     ContactPublisher *contactPublisher = iter->second;
     contactPublisher->contacts.clear();
+    contactPublisher->callback.clear();
     contactPublisher->collisionNames.clear();
     contactPublisher->collisions.clear();
     contactPublisher->publisher.reset();
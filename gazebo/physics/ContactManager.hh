@@ -25,6 +25,7 @@
 #include <boost/unordered/unordered_set.hpp>
 #include <boost/unordered/unordered_map.hpp>
 #include <boost/thread/recursive_mutex.hpp>
+#include <boost/function.hpp>
 
 #include "gazebo/transport/TransportTypes.hh"
 
@@ -54,6 +55,11 @@ namespace gazebo
 
       /// \brief A list of contacts associated to the collisions.
       public: std::vector<Contact *> contacts;
+
+      /// \brief Optional callback that receives the contacts directly,
+      /// in the physics thread, instead of through the publisher.
+      public: boost::function<void (const std::vector<Contact *> &)>
+              callback;
     };
 
     /// \addtogroup gazebo_physics
@@ -144,6 +150,21 @@ namespace gazebo
                   const std::map<std::string, physics::CollisionPtr>
                   &_collisions);
 
+      /// \brief Deliver the contacts of a filter directly to a callback in
+      /// this process. The callback is called from the physics thread, once
+      /// per PublishContacts, with the contacts that involve the filter's
+      /// collisions. Contacts with a zero count should be skipped. The
+      /// contacts are reused by the next physics step, so the callback must
+      /// not keep pointers to them. The filter's topic is then only
+      /// serialized and published when it has subscribers.
+      /// \param[in] _name Filter name.
+      /// \param[in] _callback Callback to receive the contacts. An empty
+      /// function disconnects the current callback.
+      /// \return True if the filter exists.
+      public: bool SetFilterCallback(const std::string &_name,
+                  const boost::function<void (const std::vector<Contact *> &)>
+                  &_callback);
+
       /// \brief Remove a contacts filter and the associated custom publisher
       /// param[in] _name Filter name.
       public: void RemoveFilter(std::string _name);
@@ -571,6 +571,14 @@ void Entity::OnPoseMsg(ConstPosePtr &_msg)
 //////////////////////////////////////////////////
 void Entity::Fini()
 {
+  // Disconnect from the world updates on the simulation thread, rather
+  // than in the destructor, which may run on the teardown thread.
+  if (this->animationConnection)
+  {
+    event::Events::DisconnectWorldUpdateBegin(this->animationConnection);
+    this->animationConnection.reset();
+  }
+
   if (this->requestPub)
   {
     msgs::Request *msg = msgs::CreateRequest("entity_delete",
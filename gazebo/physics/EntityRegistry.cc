@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "gazebo/physics/Base.hh"
+#include "gazebo/physics/EntityRegistry.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+EntityRegistry::EntityRegistry()
+{
+}
+
+//////////////////////////////////////////////////
+EntityRegistry::~EntityRegistry()
+{
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+void EntityRegistry::Add(BasePtr _entity)
+{
+  if (!_entity)
+    return;
+
+  boost::unique_lock<boost::shared_mutex> lock(this->mutex);
+
+  uint32_t id = _entity->GetId();
+  boost::unordered_map<uint32_t, Record>::iterator iter =
+    this->records.find(id);
+  if (iter != this->records.end())
+  {
+    Unindex(this->names, iter->second.name, id);
+    Unindex(this->scopedNames, iter->second.scopedName, id);
+  }
+
+  Record &record = this->records[id];
+  record.entity = _entity;
+  record.name = _entity->GetName();
+  record.scopedName = _entity->GetScopedName();
+
+  Index(this->names, record.name, id);
+  Index(this->scopedNames, record.scopedName, id);
+}
+
+//////////////////////////////////////////////////
+void EntityRegistry::Update(const Base &_entity)
+{
+  boost::unique_lock<boost::shared_mutex> lock(this->mutex);
+
+  uint32_t id = _entity.GetId();
+  boost::unordered_map<uint32_t, Record>::iterator iter =
+    this->records.find(id);
+  if (iter == this->records.end())
+    return;
+
+  Record &record = iter->second;
+  if (record.name != _entity.GetName())
+  {
+    Unindex(this->names, record.name, id);
+    record.name = _entity.GetName();
+    Index(this->names, record.name, id);
+  }
+
+  if (record.scopedName != _entity.GetScopedName())
+  {
+    Unindex(this->scopedNames, record.scopedName, id);
+    record.scopedName = _entity.GetScopedName();
+    Index(this->scopedNames, record.scopedName, id);
+  }
+}
+
+//////////////////////////////////////////////////
+bool EntityRegistry::Remove(uint32_t _id)
+{
+  boost::unique_lock<boost::shared_mutex> lock(this->mutex);
+
+  boost::unordered_map<uint32_t, Record>::iterator iter =
+    this->records.find(_id);
+  if (iter == this->records.end())
+    return false;
+
+  Unindex(this->names, iter->second.name, _id);
+  Unindex(this->scopedNames, iter->second.scopedName, _id);
+  this->records.erase(iter);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void EntityRegistry::Clear()
+{
+  boost::unique_lock<boost::shared_mutex> lock(this->mutex);
+  this->records.clear();
+  this->names.clear();
+  this->scopedNames.clear();
+}
+
+//////////////////////////////////////////////////
+bool EntityRegistry::Has(uint32_t _id) const
+{
+  boost::shared_lock<boost::shared_mutex> lock(this->mutex);
+  return this->records.find(_id) != this->records.end();
+}
+
+//////////////////////////////////////////////////
+BasePtr EntityRegistry::GetById(uint32_t _id) const
+{
+  boost::shared_lock<boost::shared_mutex> lock(this->mutex);
+
+  boost::unordered_map<uint32_t, Record>::const_iterator iter =
+    this->records.find(_id);
+  if (iter == this->records.end())
+    return BasePtr();
+
+  return iter->second.entity.lock();
+}
+
+//////////////////////////////////////////////////
+BasePtr EntityRegistry::GetByName(const std::string &_name,
+    const Base *_ancestor) const
+{
+  boost::shared_lock<boost::shared_mutex> lock(this->mutex);
+
+  BasePtr result = this->Find(this->scopedNames, _name, _ancestor);
+  if (result)
+    return result;
+
+  if (!_ancestor)
+    return this->Find(this->names, _name, NULL);
+
+  // A child of the ancestor is found by its scoped name, so that the
+  // lookup does not depend on how many entities share the name. The
+  // scoped names of the children of the world root have no prefix.
+  std::string childName = _name;
+  if (_ancestor->GetParent())
+    childName = _ancestor->GetScopedName() + "::" + _name;
+
+  result = this->Find(this->scopedNames, childName, _ancestor);
+  if (result && result->GetName() != _name)
+    result.reset();
+  return result;
+}
+
+//////////////////////////////////////////////////
+unsigned int EntityRegistry::GetCount() const
+{
+  boost::shared_lock<boost::shared_mutex> lock(this->mutex);
+  return this->records.size();
+}
+
+//////////////////////////////////////////////////
+void EntityRegistry::Index(NameIndex &_index, const std::string &_name,
+    uint32_t _id)
+{
+  _index[_name].push_back(_id);
+}
+
+//////////////////////////////////////////////////
+void EntityRegistry::Unindex(NameIndex &_index, const std::string &_name,
+    uint32_t _id)
+{
+  NameIndex::iterator iter = _index.find(_name);
+  if (iter == _index.end())
+    return;
+
+  std::vector<uint32_t> &ids = iter->second;
+  ids.erase(std::remove(ids.begin(), ids.end(), _id), ids.end());
+  if (ids.empty())
+    _index.erase(iter);
+}
+
+//////////////////////////////////////////////////
+BasePtr EntityRegistry::Find(const NameIndex &_index,
+    const std::string &_name, const Base *_ancestor) const
+{
+  NameIndex::const_iterator iter = _index.find(_name);
+  if (iter == _index.end())
+    return BasePtr();
+
+  for (std::vector<uint32_t>::const_iterator id = iter->second.begin();
+       id != iter->second.end(); ++id)
+  {
+    boost::unordered_map<uint32_t, Record>::const_iterator record =
+      this->records.find(*id);
+    if (record == this->records.end())
+      continue;
+
+    BasePtr entity = record->second.entity.lock();
+    if (!entity)
+      continue;
+
+    if (!_ancestor)
+      return entity;
+
+    for (BasePtr p = entity->GetParent(); p; p = p->GetParent())
+    {
+      if (p.get() == _ancestor)
+        return entity;
+    }
+  }
+
+  return BasePtr();
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_PHYSICS_ENTITYREGISTRY_HH_
+#define _GAZEBO_PHYSICS_ENTITYREGISTRY_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/unordered/unordered_map.hpp>
+
+#include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class EntityRegistry EntityRegistry.hh physics/physics.hh
+    /// \brief An index of the entities of a world by id, name and scoped
+    /// name.
+    ///
+    /// Entities register themselves when they are added to the world's
+    /// entity tree, and are removed when they are finalized. The
+    /// registry holds weak pointers, so it never keeps an entity alive.
+    /// Entities sharing a name are returned in the order they were
+    /// registered.
+    class GZ_PHYSICS_VISIBLE EntityRegistry
+    {
+      /// \brief Constructor.
+      public: EntityRegistry();
+
+      /// \brief Destructor.
+      public: virtual ~EntityRegistry();
+
+      /// \brief Add an entity, or update its names if it is already
+      /// registered.
+      /// \param[in] _entity Entity to add.
+      public: void Add(BasePtr _entity);
+
+      /// \brief Update the names of an entity after it was renamed. Does
+      /// nothing if the entity is not registered.
+      /// \param[in] _entity Entity that was renamed.
+      public: void Update(const Base &_entity);
+
+      /// \brief Remove an entity.
+      /// \param[in] _id Id of the entity.
+      /// \return True if the entity was registered.
+      public: bool Remove(uint32_t _id);
+
+      /// \brief Remove all entities.
+      public: void Clear();
+
+      /// \brief Get whether an entity is registered.
+      /// \param[in] _id Id of the entity.
+      /// \return True if the entity is registered.
+      public: bool Has(uint32_t _id) const;
+
+      /// \brief Get an entity by id.
+      /// \param[in] _id Id of the entity.
+      /// \return The entity, or NULL if it is not registered.
+      public: BasePtr GetById(uint32_t _id) const;
+
+      /// \brief Get an entity by scoped name or name. Scoped names are
+      /// matched first.
+      /// \param[in] _name Scoped name or name of the entity.
+      /// \param[in] _ancestor If not NULL, only descendants of this
+      /// entity are returned, and a plain name only matches a child of
+      /// it. Both lookups go through the scoped name index, so their cost
+      /// does not grow with the number of entities sharing the name.
+      /// \return The first entity registered with the name, or NULL.
+      public: BasePtr GetByName(const std::string &_name,
+                  const Base *_ancestor = NULL) const;
+
+      /// \brief Get the number of registered entities.
+      /// \return Number of entities.
+      public: unsigned int GetCount() const;
+
+      /// \brief A registered entity.
+      private: class Record
+      {
+        /// \brief The entity.
+        public: BaseWeakPtr entity;
+
+        /// \brief Name the entity is indexed by.
+        public: std::string name;
+
+        /// \brief Scoped name the entity is indexed by.
+        public: std::string scopedName;
+      };
+
+      /// \brief Ids of entities by name.
+      private: typedef boost::unordered_map<std::string,
+               std::vector<uint32_t> > NameIndex;
+
+      /// \brief Add an id to a name index.
+      /// \param[in] _index The index.
+      /// \param[in] _name Name of the entity.
+      /// \param[in] _id Id of the entity.
+      private: static void Index(NameIndex &_index, const std::string &_name,
+                   uint32_t _id);
+
+      /// \brief Remove an id from a name index.
+      /// \param[in] _index The index.
+      /// \param[in] _name Name of the entity.
+      /// \param[in] _id Id of the entity.
+      private: static void Unindex(NameIndex &_index,
+                   const std::string &_name, uint32_t _id);
+
+      /// \brief Find the first live entity in a name index.
+      /// \param[in] _index The index.
+      /// \param[in] _name Name of the entity.
+      /// \param[in] _ancestor If not NULL, the required ancestor.
+      /// \return The entity, or NULL.
+      private: BasePtr Find(const NameIndex &_index, const std::string &_name,
+                   const Base *_ancestor) const;
+
+      /// \brief Registered entities by id.
+      private: boost::unordered_map<uint32_t, Record> records;
+
+      /// \brief Ids by name.
+      private: NameIndex names;
+
+      /// \brief Ids by scoped name.
+      private: NameIndex scopedNames;
+
+      /// \brief Protects the registry.
+      private: mutable boost::shared_mutex mutex;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "test/util.hh"
+#include "gazebo/physics/Base.hh"
+#include "gazebo/physics/EntityRegistry.hh"
+
+using namespace gazebo;
+
+class EntityRegistryTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Create a named entity.
+/// \param[in] _parent Parent of the entity.
+/// \param[in] _name Name of the entity.
+/// \return The entity.
+physics::BasePtr createEntity(physics::BasePtr _parent,
+    const std::string &_name)
+{
+  physics::BasePtr entity(new physics::Base(_parent));
+  entity->SetName(_name);
+  return entity;
+}
+
+/////////////////////////////////////////////////
+TEST_F(EntityRegistryTest, AddRemove)
+{
+  physics::EntityRegistry registry;
+  physics::BasePtr root = createEntity(physics::BasePtr(), "world");
+  physics::BasePtr model = createEntity(root, "box");
+
+  registry.Add(model);
+  EXPECT_EQ(registry.GetCount(), 1u);
+  EXPECT_TRUE(registry.Has(model->GetId()));
+  EXPECT_EQ(registry.GetById(model->GetId()), model);
+  EXPECT_EQ(registry.GetByName("box"), model);
+
+  // Adding again does not duplicate the entity.
+  registry.Add(model);
+  EXPECT_EQ(registry.GetCount(), 1u);
+
+  EXPECT_TRUE(registry.Remove(model->GetId()));
+  EXPECT_FALSE(registry.Remove(model->GetId()));
+  EXPECT_EQ(registry.GetCount(), 0u);
+  EXPECT_TRUE(registry.GetById(model->GetId()) == NULL);
+  EXPECT_TRUE(registry.GetByName("box") == NULL);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EntityRegistryTest, ScopedNames)
+{
+  physics::EntityRegistry registry;
+  physics::BasePtr root = createEntity(physics::BasePtr(), "world");
+  physics::BasePtr modelA = createEntity(root, "a");
+  physics::BasePtr modelB = createEntity(root, "b");
+  physics::BasePtr linkA = createEntity(modelA, "link");
+  physics::BasePtr linkB = createEntity(modelB, "link");
+
+  registry.Add(modelA);
+  registry.Add(modelB);
+  registry.Add(linkA);
+  registry.Add(linkB);
+
+  EXPECT_EQ(registry.GetByName("a::link"), linkA);
+  EXPECT_EQ(registry.GetByName("b::link"), linkB);
+
+  // Plain names resolve to the first registered entity.
+  EXPECT_EQ(registry.GetByName("link"), linkA);
+
+  // Only descendants of the ancestor are returned.
+  EXPECT_EQ(registry.GetByName("link", modelB.get()), linkB);
+  EXPECT_TRUE(registry.GetByName("a", modelB.get()) == NULL);
+  EXPECT_EQ(registry.GetByName("a", root.get()), modelA);
+
+  // Renamed entities are indexed by their new name.
+  modelA->SetName("c");
+  registry.Update(*modelA);
+  EXPECT_TRUE(registry.GetByName("a") == NULL);
+  EXPECT_EQ(registry.GetByName("c"), modelA);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EntityRegistryTest, IdenticalModels)
+{
+  physics::EntityRegistry registry;
+  physics::BasePtr root = createEntity(physics::BasePtr(), "world");
+
+  // Many copies of one robot share the names of their links.
+  std::vector<physics::BasePtr> models;
+  std::vector<physics::BasePtr> links;
+  std::vector<physics::BasePtr> collisions;
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    models.push_back(createEntity(root, "robot_" + std::to_string(i)));
+    links.push_back(createEntity(models.back(), "link"));
+    collisions.push_back(createEntity(links.back(), "collision"));
+    registry.Add(models.back());
+    registry.Add(links.back());
+    registry.Add(collisions.back());
+  }
+
+  // A plain name under an ancestor resolves to the child of that
+  // ancestor, not to the first entity registered with the name.
+  EXPECT_EQ(registry.GetByName("link", models[50].get()), links[50]);
+  EXPECT_EQ(registry.GetByName("collision", links[99].get()),
+      collisions[99]);
+  EXPECT_EQ(registry.GetByName("robot_7", root.get()), models[7]);
+
+  // Deeper descendants are not matched by plain name.
+  EXPECT_TRUE(registry.GetByName("collision", models[50].get()) == NULL);
+  EXPECT_EQ(registry.GetByName("robot_50::link::collision",
+        models[50].get()), collisions[50]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(EntityRegistryTest, Expired)
+{
+  physics::EntityRegistry registry;
+  physics::BasePtr root = createEntity(physics::BasePtr(), "world");
+  physics::BasePtr model = createEntity(root, "box");
+  uint32_t id = model->GetId();
+
+  // The registry does not keep entities alive.
+  registry.Add(model);
+  model.reset();
+  EXPECT_TRUE(registry.GetById(id) == NULL);
+  EXPECT_TRUE(registry.GetByName("box") == NULL);
+
+  registry.Clear();
+  EXPECT_EQ(registry.GetCount(), 0u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
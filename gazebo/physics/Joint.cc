@@ -37,6 +37,7 @@
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -869,6 +870,18 @@ void Joint::SetState(const JointState &_state)
   }
 }
 
+//////////////////////////////////////////////////
+void Joint::SaveSnapshot(WorldSnapshot &/*_snapshot*/) const
+{
+}
+
+//////////////////////////////////////////////////
+bool Joint::RestoreSnapshot(const WorldSnapshot &/*_snapshot*/,
+    size_t &/*_offset*/)
+{
+  return true;
+}
+
 //////////////////////////////////////////////////
 double Joint::CheckAndTruncateForce(unsigned int _index, double _effort)
 {
@@ -125,6 +125,21 @@ namespace gazebo
       /// \param[in] _state Joint state
       public: void SetState(const JointState &_state);
 
+      /// \brief Append the solver state of the joint to a snapshot, such
+      /// as the impulses used to warm start the next step. The base
+      /// implementation saves nothing.
+      /// \param[in,out] _snapshot Snapshot to append to.
+      /// \sa World::SaveSnapshot
+      public: virtual void SaveSnapshot(WorldSnapshot &_snapshot) const;
+
+      /// \brief Restore the solver state of the joint from a snapshot.
+      /// \param[in] _snapshot Snapshot to read from.
+      /// \param[in,out] _offset Position of the joint's state, advanced
+      /// past it.
+      /// \return False if the snapshot ends before the joint's state.
+      public: virtual bool RestoreSnapshot(const WorldSnapshot &_snapshot,
+                  size_t &_offset);
+
       /// \brief Set the model this joint belongs too.
       /// \param[in] _model Pointer to a model.
       public: void SetModel(ModelPtr _model);
@@ -21,6 +21,10 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
 #include "gazebo/transport/Node.hh"
 #include "gazebo/transport/Subscriber.hh"
 #include "gazebo/physics/Model.hh"
@@ -35,6 +39,110 @@
 using namespace gazebo;
 using namespace physics;
 
+/////////////////////////////////////////////////
+void JointPidArrays::Resize(size_t _size)
+{
+  this->pGain.resize(_size);
+  this->iGain.resize(_size);
+  this->dGain.resize(_size);
+  this->iMax.resize(_size);
+  this->iMin.resize(_size);
+  this->cmdMax.resize(_size);
+  this->cmdMin.resize(_size);
+  this->pErrLast.resize(_size);
+  this->iErr.resize(_size);
+  this->dErr.resize(_size);
+  this->cmd.resize(_size);
+}
+
+/////////////////////////////////////////////////
+void JointPidArrays::Set(size_t _index, const common::PID &_pid)
+{
+  this->pGain[_index] = _pid.GetPGain();
+  this->iGain[_index] = _pid.GetIGain();
+  this->dGain[_index] = _pid.GetDGain();
+  this->iMax[_index] = _pid.GetIMax();
+  this->iMin[_index] = _pid.GetIMin();
+  this->cmdMax[_index] = _pid.GetCmdMax();
+  this->cmdMin[_index] = _pid.GetCmdMin();
+  this->pErrLast[_index] = 0.0;
+  this->iErr[_index] = 0.0;
+  this->dErr[_index] = 0.0;
+  this->cmd[_index] = 0.0;
+}
+
+/////////////////////////////////////////////////
+common::PID JointPidArrays::Get(size_t _index) const
+{
+  common::PID pid(this->pGain[_index], this->iGain[_index],
+      this->dGain[_index], this->iMax[_index], this->iMin[_index],
+      this->cmdMax[_index], this->cmdMin[_index]);
+  pid.SetErrors(this->pErrLast[_index], this->iErr[_index],
+      this->dErr[_index]);
+  pid.SetCmd(this->cmd[_index]);
+  return pid;
+}
+
+/////////////////////////////////////////////////
+void JointPidArrays::Update(const std::vector<double> &_errors,
+    const std::vector<char> &_active, double _dt, std::vector<double> &_cmds)
+{
+  const size_t size = _errors.size();
+  const double *errors = _errors.data();
+  const char *active = _active.data();
+  const double *pGains = this->pGain.data();
+  const double *iGains = this->iGain.data();
+  const double *dGains = this->dGain.data();
+  const double *iMaxs = this->iMax.data();
+  const double *iMins = this->iMin.data();
+  const double *cmdMaxs = this->cmdMax.data();
+  const double *cmdMins = this->cmdMin.data();
+  double *pErrLasts = this->pErrLast.data();
+  double *iErrs = this->iErr.data();
+  double *dErrs = this->dErr.data();
+  double *lastCmds = this->cmd.data();
+  double *cmds = _cmds.data();
+
+  // Every controller is computed, and the results of the inactive ones
+  // are dropped, so that the loop has no branches to prevent
+  // vectorization.
+  for (size_t i = 0; i < size; ++i)
+  {
+    const double err = errors[i];
+    const double iGain = iGains[i];
+    const double iMax = iMaxs[i];
+    const double iMin = iMins[i];
+    const double cmdMax = cmdMaxs[i];
+    const double cmdMin = cmdMins[i];
+    const double pErrLast = pErrLasts[i];
+
+    double iErr = iErrs[i] + _dt * err;
+    double iTerm = iGain * iErr;
+    const bool overMax = iTerm > iMax;
+    const bool underMin = !overMax & (iTerm < iMin);
+    iTerm = overMax ? iMax : iTerm;
+    iTerm = underMin ? iMin : iTerm;
+    const double iErrLimited = iTerm / iGain;
+    iErr = (overMax | underMin) ? iErrLimited : iErr;
+
+    const double dErr = (err - pErrLast) / _dt;
+    double cmd = -pGains[i] * err - iTerm - dGains[i] * dErr;
+
+    // Limits equal to zero are ignored, as in common::PID.
+    cmd = ((std::fabs(cmdMax) > 1e-6) & (cmd > cmdMax)) ? cmdMax : cmd;
+    cmd = ((std::fabs(cmdMin) > 1e-6) & (cmd < cmdMin)) ? cmdMin : cmd;
+
+    // Errors that are not finite, for which err - err is not zero, leave
+    // the controller untouched.
+    const bool update = (active[i] != 0) & (err - err == 0.0);
+    iErrs[i] = update ? iErr : iErrs[i];
+    pErrLasts[i] = update ? err : pErrLast;
+    dErrs[i] = update ? dErr : dErrs[i];
+    lastCmds[i] = update ? cmd : lastCmds[i];
+    cmds[i] = update ? cmd : 0.0;
+  }
+}
+
 /////////////////////////////////////////////////
 JointController::JointController(ModelPtr _model)
   : dataPtr(new JointControllerPrivate)
@@ -67,20 +175,60 @@ JointController::~JointController()
 /////////////////////////////////////////////////
 void JointController::AddJoint(JointPtr _joint)
 {
-  this->dataPtr->joints[_joint->GetScopedName()] = _joint;
-  this->dataPtr->posPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
-  this->dataPtr->velPids[_joint->GetScopedName()].Init(
-      1, 0.1, 0.01, 1, -1, 1000, -1000);
+  unsigned int index;
+  std::map<std::string, unsigned int>::iterator iter =
+    this->dataPtr->indices.find(_joint->GetScopedName());
+
+  if (iter != this->dataPtr->indices.end())
+  {
+    index = iter->second;
+    this->dataPtr->joints[index] = _joint;
+  }
+  else
+  {
+    index = this->dataPtr->joints.size();
+    this->dataPtr->indices[_joint->GetScopedName()] = index;
+    this->dataPtr->joints.push_back(_joint);
+
+    size_t size = this->dataPtr->joints.size();
+    this->dataPtr->posPids.Resize(size);
+    this->dataPtr->velPids.Resize(size);
+    this->dataPtr->forces.resize(size);
+    this->dataPtr->positions.resize(size);
+    this->dataPtr->velocities.resize(size);
+    this->dataPtr->hasForce.resize(size);
+    this->dataPtr->hasPosition.resize(size);
+    this->dataPtr->hasVelocity.resize(size);
+    this->dataPtr->errors.resize(size);
+    this->dataPtr->cmds.resize(size);
+  }
+
+  this->dataPtr->posPids.Set(index,
+      common::PID(1, 0.1, 0.01, 1, -1, 1000, -1000));
+  this->dataPtr->velPids.Set(index,
+      common::PID(1, 0.1, 0.01, 1, -1, 1000, -1000));
+}
+
+/////////////////////////////////////////////////
+int JointController::GetJointIndex(const std::string &_jointName) const
+{
+  std::map<std::string, unsigned int>::const_iterator iter =
+    this->dataPtr->indices.find(_jointName);
+  if (iter == this->dataPtr->indices.end())
+    return -1;
+  return static_cast<int>(iter->second);
 }
 
 /////////////////////////////////////////////////
 void JointController::Reset()
 {
   // Reset setpoints and feed-forward.
-  this->dataPtr->positions.clear();
-  this->dataPtr->velocities.clear();
-  this->dataPtr->forces.clear();
+  std::fill(this->dataPtr->hasPosition.begin(),
+      this->dataPtr->hasPosition.end(), 0);
+  std::fill(this->dataPtr->hasVelocity.begin(),
+      this->dataPtr->hasVelocity.end(), 0);
+  std::fill(this->dataPtr->hasForce.begin(),
+      this->dataPtr->hasForce.end(), 0);
   // Should the PID's be reset as well?
 }
 
@@ -95,209 +243,143 @@ void JointController::Update()
   // Negative update time wreaks havok on the integrators.
   // This happens when World::ResetTime is called.
   // TODO: fix this when World::ResetTime is improved
-  if (stepTime > 0)
+  if (stepTime <= 0)
+    return;
+
+  const Joint_V &joints = this->dataPtr->joints;
+  const size_t size = joints.size();
+  const double dt = stepTime.Double();
+
+  for (size_t i = 0; i < size; ++i)
   {
-    if (!this->dataPtr->forces.empty())
-    {
-      std::map<std::string, double>::iterator iter;
-      for (iter = this->dataPtr->forces.begin();
-          iter != this->dataPtr->forces.end(); ++iter)
-      {
-        this->dataPtr->joints[iter->first]->SetForce(0, iter->second);
-      }
-    }
+    if (this->dataPtr->hasForce[i])
+      joints[i]->SetForce(0, this->dataPtr->forces[i]);
+  }
 
-    if (!this->dataPtr->positions.empty())
+  const std::vector<char> &hasPosition = this->dataPtr->hasPosition;
+  if (std::find(hasPosition.begin(), hasPosition.end(), 1) !=
+      hasPosition.end())
+  {
+    for (size_t i = 0; i < size; ++i)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->positions.begin();
-           iter != this->dataPtr->positions.end(); ++iter)
-      {
-        double cmd = this->dataPtr->posPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetAngle(0).Radian() -
-            iter->second, stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      this->dataPtr->errors[i] = hasPosition[i] ?
+        joints[i]->GetAngle(0).Radian() - this->dataPtr->positions[i] : 0.0;
     }
 
-    if (!this->dataPtr->velocities.empty())
+    this->dataPtr->posPids.Update(this->dataPtr->errors, hasPosition, dt,
+        this->dataPtr->cmds);
+
+    for (size_t i = 0; i < size; ++i)
     {
-      std::map<std::string, double>::iterator iter;
-
-      for (iter = this->dataPtr->velocities.begin();
-           iter != this->dataPtr->velocities.end(); ++iter)
-      {
-        double cmd = this->dataPtr->velPids[iter->first].Update(
-            this->dataPtr->joints[iter->first]->GetVelocity(0) - iter->second,
-            stepTime);
-        this->dataPtr->joints[iter->first]->SetForce(0, cmd);
-      }
+      if (hasPosition[i])
+        joints[i]->SetForce(0, this->dataPtr->cmds[i]);
     }
   }
 
-  /* enable below if we want to set position kinematically
-  if (this->dataPtr->positions.size() > 0)
+  const std::vector<char> &hasVelocity = this->dataPtr->hasVelocity;
+  if (std::find(hasVelocity.begin(), hasVelocity.end(), 1) !=
+      hasVelocity.end())
   {
-    std::map<std::string, JointPtr>::iterator iter;
-    for (iter = this->dataPtr->joints.begin();
-         iter != this->dataPtr->joints.end(); ++iter)
+    for (size_t i = 0; i < size; ++i)
     {
-      if (this->dataPtr->positions.find(iter->first) ==
-          this->dataPtr->positions.end())
-      {
-        this->dataPtr->positions[iter->first] =
-          iter->second->GetAngle(0).Radian();
-      }
+      this->dataPtr->errors[i] = hasVelocity[i] ?
+        joints[i]->GetVelocity(0) - this->dataPtr->velocities[i] : 0.0;
+    }
+
+    this->dataPtr->velPids.Update(this->dataPtr->errors, hasVelocity, dt,
+        this->dataPtr->cmds);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      if (hasVelocity[i])
+        joints[i]->SetForce(0, this->dataPtr->cmds[i]);
     }
-    this->SetJointPositions(this->dataPtr->positions);
-    this->dataPtr->positions.clear();
   }
-  */
 }
 
 /////////////////////////////////////////////////
 void JointController::OnJointCmd(ConstJointCmdPtr &_msg)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_msg->name());
-  if (iter != this->dataPtr->joints.end())
+  this->ApplyJointCmd(*_msg);
+}
+
+/////////////////////////////////////////////////
+void JointController::ApplyJointCmd(const msgs::JointCmd &_msg)
+{
+  int index = this->GetJointIndex(_msg.name());
+  if (index < 0)
   {
-    if (_msg->has_reset() && _msg->reset())
-    {
-      if (this->dataPtr->forces.find(_msg->name()) !=
-          this->dataPtr->forces.end())
-      {
-        this->dataPtr->forces.erase(this->dataPtr->forces.find(_msg->name()));
-      }
-
-      if (this->dataPtr->positions.find(_msg->name()) !=
-          this->dataPtr->positions.end())
-      {
-        this->dataPtr->positions.erase(
-            this->dataPtr->positions.find(_msg->name()));
-      }
-
-      if (this->dataPtr->velocities.find(_msg->name()) !=
-          this->dataPtr->velocities.end())
-      {
-        this->dataPtr->velocities.erase(
-            this->dataPtr->velocities.find(_msg->name()));
-      }
-    }
+    gzerr << "Unable to find joint[" << _msg.name() << "]\n";
+    return;
+  }
 
-    if (_msg->has_force())
-      this->dataPtr->forces[_msg->name()] = _msg->force();
+  if (_msg.has_reset() && _msg.reset())
+  {
+    this->dataPtr->hasForce[index] = 0;
+    this->dataPtr->hasPosition[index] = 0;
+    this->dataPtr->hasVelocity[index] = 0;
+  }
 
-    if (_msg->has_position())
+  if (_msg.has_force())
+    this->SetForce(index, _msg.force());
+
+  if (_msg.has_position())
+  {
+    const msgs::PID &pid = _msg.position();
+    JointPidArrays &pids = this->dataPtr->posPids;
+
+    if (pid.has_target())
+      this->SetPositionTarget(index, pid.target());
+    if (pid.has_p_gain())
+      pids.pGain[index] = pid.p_gain();
+    if (pid.has_i_gain())
+      pids.iGain[index] = pid.i_gain();
+    if (pid.has_d_gain())
+      pids.dGain[index] = pid.d_gain();
+    if (pid.has_i_max())
+      pids.iMax[index] = pid.i_max();
+    if (pid.has_i_min())
+      pids.iMin[index] = pid.i_min();
+    if (pid.has_limit())
     {
-      if (_msg->position().has_target())
-      {
-        if (!this->SetPositionTarget(_msg->name(), _msg->position().target()))
-        {
-          gzerr << "Unable to set position target for joint["
-            << _msg->name() << "]. Joint is not found.\n";
-        }
-      }
-
-      if (_msg->position().has_p_gain())
-      {
-        this->dataPtr->posPids[_msg->name()].SetPGain(
-            _msg->position().p_gain());
-      }
-
-      if (_msg->position().has_i_gain())
-      {
-        this->dataPtr->posPids[_msg->name()].SetIGain(
-            _msg->position().i_gain());
-      }
-
-      if (_msg->position().has_d_gain())
-      {
-        this->dataPtr->posPids[_msg->name()].SetDGain(
-            _msg->position().d_gain());
-      }
-
-      if (_msg->position().has_i_max())
-      {
-        this->dataPtr->posPids[_msg->name()].SetIMax(_msg->position().i_max());
-      }
-
-      if (_msg->position().has_i_min())
-      {
-        this->dataPtr->posPids[_msg->name()].SetIMin(_msg->position().i_min());
-      }
-
-      if (_msg->position().has_limit())
-      {
-        this->dataPtr->posPids[_msg->name()].SetCmdMax(
-            _msg->position().limit());
-        this->dataPtr->posPids[_msg->name()].SetCmdMin(
-            -_msg->position().limit());
-      }
+      pids.cmdMax[index] = pid.limit();
+      pids.cmdMin[index] = -pid.limit();
     }
+  }
 
-    if (_msg->has_velocity())
+  if (_msg.has_velocity())
+  {
+    const msgs::PID &pid = _msg.velocity();
+    JointPidArrays &pids = this->dataPtr->velPids;
+
+    if (pid.has_target())
+      this->SetVelocityTarget(index, pid.target());
+    if (pid.has_p_gain())
+      pids.pGain[index] = pid.p_gain();
+    if (pid.has_i_gain())
+      pids.iGain[index] = pid.i_gain();
+    if (pid.has_d_gain())
+      pids.dGain[index] = pid.d_gain();
+    if (pid.has_i_max())
+      pids.iMax[index] = pid.i_max();
+    if (pid.has_i_min())
+      pids.iMin[index] = pid.i_min();
+    if (pid.has_limit())
     {
-      if (_msg->velocity().has_target())
-      {
-        if (!this->SetVelocityTarget(_msg->name(), _msg->velocity().target()))
-        {
-          gzerr << "Unable to set velocity target for joint["
-            << _msg->name() << "]. Joint is not found.\n";
-        }
-      }
-
-      if (_msg->velocity().has_p_gain())
-      {
-        this->dataPtr->velPids[_msg->name()].SetPGain(
-            _msg->velocity().p_gain());
-      }
-
-      if (_msg->velocity().has_i_gain())
-      {
-        this->dataPtr->velPids[_msg->name()].SetIGain(
-            _msg->velocity().i_gain());
-      }
-
-      if (_msg->velocity().has_d_gain())
-      {
-        this->dataPtr->velPids[_msg->name()].SetDGain(
-            _msg->velocity().d_gain());
-      }
-
-      if (_msg->velocity().has_i_max())
-      {
-        this->dataPtr->velPids[_msg->name()].SetIMax(_msg->velocity().i_max());
-      }
-
-      if (_msg->velocity().has_i_min())
-      {
-        this->dataPtr->velPids[_msg->name()].SetIMin(_msg->velocity().i_min());
-      }
-
-      if (_msg->velocity().has_limit())
-      {
-        this->dataPtr->velPids[_msg->name()].SetCmdMax(
-            _msg->velocity().limit());
-        this->dataPtr->velPids[_msg->name()].SetCmdMin(
-            -_msg->velocity().limit());
-      }
+      pids.cmdMax[index] = pid.limit();
+      pids.cmdMin[index] = -pid.limit();
     }
   }
-  else
-    gzerr << "Unable to find joint[" << _msg->name() << "]\n";
 }
 
 //////////////////////////////////////////////////
 void JointController::SetJointPosition(const std::string & _name,
                                        double _position, int _index)
 {
-  std::map<std::string, JointPtr>::iterator jiter =
-    this->dataPtr->joints.find(_name);
+  int index = this->GetJointIndex(_name);
 
-  if (jiter != this->dataPtr->joints.end())
-    this->SetJointPosition(jiter->second, _position, _index);
+  if (index >= 0)
+    this->SetJointPosition(this->dataPtr->joints[index], _position, _index);
   else
     gzwarn << "SetJointPosition [" << _name << "] not found\n";
 }
@@ -308,24 +390,22 @@ void JointController::SetJointPositions(
 {
   // go through all joints in this model and update each one
   //   for each joint update, recursively update all children
-  std::map<std::string, JointPtr>::iterator iter;
   std::map<std::string, double>::const_iterator jiter;
 
-  for (iter = this->dataPtr->joints.begin();
-      iter != this->dataPtr->joints.end(); ++iter)
+  for (auto const &joint : this->dataPtr->joints)
   {
     // First try name without scope, i.e. joint_name
-    jiter = _jointPositions.find(iter->second->GetName());
+    jiter = _jointPositions.find(joint->GetName());
 
     if (jiter == _jointPositions.end())
     {
       // Second try name with scope, i.e. model_name::joint_name
-      jiter = _jointPositions.find(iter->second->GetScopedName());
+      jiter = _jointPositions.find(joint->GetScopedName());
       if (jiter == _jointPositions.end())
         continue;
     }
 
-    this->SetJointPosition(iter->second, jiter->second);
+    this->SetJointPosition(joint, jiter->second);
   }
 }
 
@@ -345,48 +425,82 @@ common::Time JointController::GetLastUpdateTime() const
 /////////////////////////////////////////////////
 std::map<std::string, JointPtr> JointController::GetJoints() const
 {
-  return this->dataPtr->joints;
+  std::map<std::string, JointPtr> result;
+  for (auto const &index : this->dataPtr->indices)
+    result[index.first] = this->dataPtr->joints[index.second];
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetPositionPIDs() const
 {
-  return this->dataPtr->posPids;
+  std::map<std::string, common::PID> result;
+  // Inserted rather than assigned, since assigning a PID resets its
+  // errors.
+  for (auto const &index : this->dataPtr->indices)
+  {
+    result.insert(std::make_pair(index.first,
+          this->dataPtr->posPids.Get(index.second)));
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, common::PID> JointController::GetVelocityPIDs() const
 {
-  return this->dataPtr->velPids;
+  std::map<std::string, common::PID> result;
+  for (auto const &index : this->dataPtr->indices)
+  {
+    result.insert(std::make_pair(index.first,
+          this->dataPtr->velPids.Get(index.second)));
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetForces() const
 {
-  return this->dataPtr->forces;
+  std::map<std::string, double> result;
+  for (auto const &index : this->dataPtr->indices)
+  {
+    if (this->dataPtr->hasForce[index.second])
+      result[index.first] = this->dataPtr->forces[index.second];
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetPositions() const
 {
-  return this->dataPtr->positions;
+  std::map<std::string, double> result;
+  for (auto const &index : this->dataPtr->indices)
+  {
+    if (this->dataPtr->hasPosition[index.second])
+      result[index.first] = this->dataPtr->positions[index.second];
+  }
+  return result;
 }
 
 /////////////////////////////////////////////////
 std::map<std::string, double> JointController::GetVelocities() const
 {
-  return this->dataPtr->velocities;
+  std::map<std::string, double> result;
+  for (auto const &index : this->dataPtr->indices)
+  {
+    if (this->dataPtr->hasVelocity[index.second])
+      result[index.first] = this->dataPtr->velocities[index.second];
+  }
+  return result;
 }
 
 //////////////////////////////////////////////////
 void JointController::SetPositionPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_jointName);
+  int index = this->GetJointIndex(_jointName);
 
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->posPids[_jointName] = _pid;
+  if (index >= 0)
+    this->dataPtr->posPids.Set(index, _pid);
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -395,27 +509,29 @@ void JointController::SetPositionPID(const std::string &_jointName,
 bool JointController::SetPositionTarget(const std::string &_jointName,
     double _target)
 {
-  bool result = false;
+  int index = this->GetJointIndex(_jointName);
+  return index >= 0 && this->SetPositionTarget(index, _target);
+}
 
-  if (this->dataPtr->posPids.find(_jointName) !=
-      this->dataPtr->posPids.end())
-  {
-    this->dataPtr->positions[_jointName] = _target;
-    result = true;
-  }
+/////////////////////////////////////////////////
+bool JointController::SetPositionTarget(unsigned int _index, double _target)
+{
+  if (_index >= this->dataPtr->joints.size())
+    return false;
 
-  return result;
+  this->dataPtr->positions[_index] = _target;
+  this->dataPtr->hasPosition[_index] = 1;
+  return true;
 }
 
 //////////////////////////////////////////////////
 void JointController::SetVelocityPID(const std::string &_jointName,
                                      const common::PID &_pid)
 {
-  std::map<std::string, JointPtr>::iterator iter;
-  iter = this->dataPtr->joints.find(_jointName);
+  int index = this->GetJointIndex(_jointName);
 
-  if (iter != this->dataPtr->joints.end())
-    this->dataPtr->velPids[_jointName] = _pid;
+  if (index >= 0)
+    this->dataPtr->velPids.Set(index, _pid);
   else
     gzerr << "Unable to find joint with name[" << _jointName << "]\n";
 }
@@ -424,14 +540,28 @@ void JointController::SetVelocityPID(const std::string &_jointName,
 bool JointController::SetVelocityTarget(const std::string &_jointName,
     double _target)
 {
-  bool result = false;
+  int index = this->GetJointIndex(_jointName);
+  return index >= 0 && this->SetVelocityTarget(index, _target);
+}
 
-  if (this->dataPtr->velPids.find(_jointName) !=
-      this->dataPtr->velPids.end())
-  {
-    this->dataPtr->velocities[_jointName] = _target;
-    result = true;
-  }
+/////////////////////////////////////////////////
+bool JointController::SetVelocityTarget(unsigned int _index, double _target)
+{
+  if (_index >= this->dataPtr->joints.size())
+    return false;
 
-  return result;
+  this->dataPtr->velocities[_index] = _target;
+  this->dataPtr->hasVelocity[_index] = 1;
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool JointController::SetForce(unsigned int _index, double _force)
+{
+  if (_index >= this->dataPtr->joints.size())
+    return false;
+
+  this->dataPtr->forces[_index] = _force;
+  this->dataPtr->hasForce[_index] = 1;
+  return true;
 }
@@ -40,6 +40,11 @@ namespace gazebo
 
     /// \class JointController JointController.hh physics/physics.hh
     /// \brief A class for manipulating physics::Joint
+    ///
+    /// Each joint added to the controller is given an index, in the order
+    /// the joints were added. Functions that take a joint name look the
+    /// index up; the functions that take an index avoid the lookup, for
+    /// callers that command many joints on every step.
     class GZ_PHYSICS_VISIBLE JointController
     {
       /// \brief Constructor
@@ -53,6 +58,11 @@ namespace gazebo
       /// \param[in] _joint Joint to control.
       public: void AddJoint(JointPtr _joint);
 
+      /// \brief Get the index of a joint.
+      /// \param[in] _jointName Scoped name of the joint.
+      /// \return Index of the joint, -1 if it was not added.
+      public: int GetJointIndex(const std::string &_jointName) const;
+
       /// \brief Update the joint control.
       public: void Update();
 
@@ -91,6 +101,13 @@ namespace gazebo
       public: bool SetPositionTarget(const std::string &_jointName,
                   double _target);
 
+      /// \brief Set the target position for the position PID controller.
+      /// \param[in] _index Index of the joint.
+      /// \param[in] _target Position target.
+      /// \return False if there is no joint with this index.
+      /// \sa GetJointIndex
+      public: bool SetPositionTarget(unsigned int _index, double _target);
+
       /// \brief Set the velocity PID values for a joint.
       /// \param[in] _jointName Scoped name of the joint.
       /// \param[in] _pid New velocity PID controller.
@@ -104,14 +121,30 @@ namespace gazebo
       public: bool SetVelocityTarget(const std::string &_jointName,
                   double _target);
 
+      /// \brief Set the target velocity for the velocity PID controller.
+      /// \param[in] _index Index of the joint.
+      /// \param[in] _target Velocity target.
+      /// \return False if there is no joint with this index.
+      /// \sa GetJointIndex
+      public: bool SetVelocityTarget(unsigned int _index, double _target);
+
+      /// \brief Set the force applied to a joint on every update.
+      /// \param[in] _index Index of the joint.
+      /// \param[in] _force Force to apply.
+      /// \return False if there is no joint with this index.
+      /// \sa GetJointIndex
+      public: bool SetForce(unsigned int _index, double _force);
+
       /// \brief Get all the position PID controllers.
       /// \return A map<joint_name, PID> for all the position PID
-      /// controllers.
+      /// controllers. The PIDs carry the gains, limits, accumulated
+      /// errors and last command of the controllers.
       public: std::map<std::string, common::PID> GetPositionPIDs() const;
 
       /// \brief Get all the velocity PID controllers.
       /// \return A map<joint_name, PID> for all the velocity PID
-      /// controllers.
+      /// controllers. The PIDs carry the gains, limits, accumulated
+      /// errors and last command of the controllers.
       public: std::map<std::string, common::PID> GetVelocityPIDs() const;
 
       /// \brief Get all the applied forces.
@@ -129,6 +162,11 @@ namespace gazebo
       /// set by the user of the JointController.
       public: std::map<std::string, double> GetVelocities() const;
 
+      /// \brief Apply a joint command, as if it was received on the
+      /// model's joint_cmd topic.
+      /// \param[in] _msg The joint command.
+      public: void ApplyJointCmd(const msgs::JointCmd &_msg);
+
       /// \brief Callback when a joint command message is received.
       /// \param[in] _msg The received message.
       private: void OnJointCmd(ConstJointCmdPtr &_msg);
@@ -19,16 +19,86 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/common/CommonTypes.hh"
 #include "gazebo/common/PID.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/util/system.hh"
 
 namespace gazebo
 {
   namespace physics
   {
+    /// \brief The PID controllers of all the joints of a JointController,
+    /// stored as one array per value so that they are updated in a single
+    /// loop the compiler can vectorize. Element i belongs to joint i of
+    /// the controller.
+    class GZ_PHYSICS_VISIBLE JointPidArrays
+    {
+      /// \brief Set the number of controllers.
+      /// \param[in] _size Number of controllers.
+      public: void Resize(size_t _size);
+
+      /// \brief Set the gains and limits of a controller from a PID. The
+      /// errors and command of the controller are reset, as assigning a
+      /// common::PID does.
+      /// \param[in] _index Index of the controller.
+      /// \param[in] _pid Gains and limits to copy.
+      public: void Set(size_t _index, const common::PID &_pid);
+
+      /// \brief Get a controller as a PID, with its gains, limits, errors
+      /// and last command.
+      /// \param[in] _index Index of the controller.
+      /// \return The PID.
+      public: common::PID Get(size_t _index) const;
+
+      /// \brief Update the active controllers, the same way
+      /// common::PID::Update does.
+      /// \param[in] _errors Error of each controller.
+      /// \param[in] _active Non-zero for the controllers to update.
+      /// \param[in] _dt Time step, greater than zero.
+      /// \param[out] _cmds Command of each controller, zero for the
+      /// inactive ones.
+      public: void Update(const std::vector<double> &_errors,
+                  const std::vector<char> &_active, double _dt,
+                  std::vector<double> &_cmds);
+
+      /// \brief Proportional gains.
+      public: std::vector<double> pGain;
+
+      /// \brief Integral gains.
+      public: std::vector<double> iGain;
+
+      /// \brief Derivative gains.
+      public: std::vector<double> dGain;
+
+      /// \brief Upper integral limit.
+      public: std::vector<double> iMax;
+
+      /// \brief Lower integral limit.
+      public: std::vector<double> iMin;
+
+      /// \brief Upper command limit, ignored when zero.
+      public: std::vector<double> cmdMax;
+
+      /// \brief Lower command limit, ignored when zero.
+      public: std::vector<double> cmdMin;
+
+      /// \brief Errors of the previous update.
+      public: std::vector<double> pErrLast;
+
+      /// \brief Integral errors.
+      public: std::vector<double> iErr;
+
+      /// \brief Derivative errors.
+      public: std::vector<double> dErr;
+
+      /// \brief Commands of the last update.
+      public: std::vector<double> cmd;
+    };
+
     class JointControllerPrivate
     {
       /// \brief Model to control.
@@ -37,23 +107,43 @@ namespace gazebo
       /// \brief List of links that have been updated.
       public: Link_V updatedLinks;
 
-      /// \brief Map of joint names to the joint pointer.
-      public: std::map<std::string, JointPtr> joints;
+      /// \brief Joints to control. The other arrays are indexed the same
+      /// way.
+      public: Joint_V joints;
+
+      /// \brief Map of scoped joint names to indices in joints.
+      public: std::map<std::string, unsigned int> indices;
 
       /// \brief Position PID controllers.
-      public: std::map<std::string, common::PID> posPids;
+      public: JointPidArrays posPids;
 
       /// \brief Velocity PID controllers.
-      public: std::map<std::string, common::PID> velPids;
+      public: JointPidArrays velPids;
 
       /// \brief Forces applied to joints.
-      public: std::map<std::string, double> forces;
+      public: std::vector<double> forces;
+
+      /// \brief Joint position targets.
+      public: std::vector<double> positions;
+
+      /// \brief Joint velocity targets.
+      public: std::vector<double> velocities;
+
+      /// \brief Non-zero for the joints with a force to apply.
+      public: std::vector<char> hasForce;
+
+      /// \brief Non-zero for the joints with a position target.
+      public: std::vector<char> hasPosition;
+
+      /// \brief Non-zero for the joints with a velocity target.
+      public: std::vector<char> hasVelocity;
 
-      /// \brief Joint positions.
-      public: std::map<std::string, double> positions;
+      /// \brief Errors passed to the PID controllers, kept to avoid
+      /// allocating on every update.
+      public: std::vector<double> errors;
 
-      /// \brief Joint velocities.
-      public: std::map<std::string, double> velocities;
+      /// \brief Commands computed by the PID controllers.
+      public: std::vector<double> cmds;
 
       /// \brief Node for communication.
       public: transport::NodePtr node;
@@ -16,6 +16,10 @@
 */
 
 #include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
 
 #include "gazebo/common/PID.hh"
 #include "gazebo/math/Vector3.hh"
@@ -23,6 +27,7 @@
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Joint.hh"
 #include "gazebo/physics/JointController.hh"
+#include "gazebo/physics/JointControllerPrivate.hh"
 #include "test/util.hh"
 
 using namespace gazebo;
@@ -270,6 +275,181 @@ TEST_F(JointControllerTest, SetJointPositions)
   EXPECT_NO_THROW(jointController->SetJointPositions(positions));
 }
 
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, JointIndex)
+{
+  // Create a dummy model
+  physics::ModelPtr model(new physics::Model(physics::BasePtr()));
+  EXPECT_TRUE(model != NULL);
+
+  // Create the joint controller
+  physics::JointControllerPtr jointController(
+      new physics::JointController(model));
+  EXPECT_TRUE(jointController != NULL);
+
+  physics::JointPtr joint1(new FakeJoint(model));
+  joint1->SetName("joint1");
+
+  physics::JointPtr joint2(new FakeJoint(model));
+  joint2->SetName("joint2");
+
+  // Joints are indexed in the order they are added.
+  jointController->AddJoint(joint1);
+  jointController->AddJoint(joint2);
+  EXPECT_EQ(jointController->GetJointIndex(joint1->GetScopedName()), 0);
+  EXPECT_EQ(jointController->GetJointIndex(joint2->GetScopedName()), 1);
+  EXPECT_EQ(jointController->GetJointIndex("my_bad_name"), -1);
+
+  // Adding a joint again keeps its index.
+  jointController->AddJoint(joint1);
+  EXPECT_EQ(jointController->GetJointIndex(joint1->GetScopedName()), 0);
+  EXPECT_EQ(jointController->GetJoints().size(), 2u);
+
+  // Set targets and forces by index.
+  EXPECT_TRUE(jointController->SetPositionTarget(0u, 1.5));
+  EXPECT_TRUE(jointController->SetVelocityTarget(1u, -0.5));
+  EXPECT_TRUE(jointController->SetForce(1u, 2.0));
+
+  std::map<std::string, double> positions = jointController->GetPositions();
+  EXPECT_EQ(positions.size(), 1u);
+  EXPECT_DOUBLE_EQ(positions[joint1->GetScopedName()], 1.5);
+
+  std::map<std::string, double> velocities = jointController->GetVelocities();
+  EXPECT_EQ(velocities.size(), 1u);
+  EXPECT_DOUBLE_EQ(velocities[joint2->GetScopedName()], -0.5);
+
+  std::map<std::string, double> forces = jointController->GetForces();
+  EXPECT_EQ(forces.size(), 1u);
+  EXPECT_DOUBLE_EQ(forces[joint2->GetScopedName()], 2.0);
+
+  // Indices out of range are rejected.
+  EXPECT_FALSE(jointController->SetPositionTarget(2u, 1.0));
+  EXPECT_FALSE(jointController->SetVelocityTarget(2u, 1.0));
+  EXPECT_FALSE(jointController->SetForce(2u, 1.0));
+  EXPECT_EQ(jointController->GetPositions().size(), 1u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Expect two values to be the same, including when both are NaN.
+/// \param[in] _a First value.
+/// \param[in] _b Second value.
+static void expectSame(double _a, double _b)
+{
+  if (std::isnan(_a) || std::isnan(_b))
+    EXPECT_TRUE(std::isnan(_a) && std::isnan(_b)) << _a << " " << _b;
+  else
+    EXPECT_EQ(_a, _b);
+}
+
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, PidArraysMatchPid)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<double> uniform(-2.0, 2.0);
+  std::uniform_int_distribution<int> pick(0, 9);
+  const double inf = std::numeric_limits<double>::infinity();
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+
+  const size_t size = 64;
+  physics::JointPidArrays arrays;
+  arrays.Resize(size);
+  std::vector<common::PID> pids(size);
+
+  // Random gains and limits, with zero gains, and command limits that
+  // are ignored for being close to zero.
+  for (size_t i = 0; i < size; ++i)
+  {
+    double gains[3];
+    for (double &gain : gains)
+      gain = pick(gen) == 0 ? 0.0 : uniform(gen);
+
+    double iMax = uniform(gen);
+    double iMin = pick(gen) == 0 ? iMax + 1.0 : iMax - std::fabs(uniform(gen));
+    double cmdMax = pick(gen) == 0 ? 0.0 : std::fabs(uniform(gen));
+    double cmdMin = pick(gen) == 0 ? 1e-7 : -std::fabs(uniform(gen));
+
+    pids[i].Init(gains[0], gains[1], gains[2], iMax, iMin, cmdMax, cmdMin);
+    arrays.Set(i, pids[i]);
+  }
+
+  std::vector<double> errors(size);
+  std::vector<char> active(size);
+  std::vector<double> cmds(size);
+
+  for (int step = 0; step < 200; ++step)
+  {
+    // common::PID takes a common::Time, which holds nanoseconds, so both
+    // are given the time step it represents.
+    const common::Time dtTime(1e-4 + std::fabs(uniform(gen)) * 0.05);
+    const double dt = dtTime.Double();
+    for (size_t i = 0; i < size; ++i)
+    {
+      int kind = pick(gen);
+      errors[i] = kind == 0 ? nan : kind == 1 ? (uniform(gen) > 0 ? inf : -inf)
+        : uniform(gen) * 10.0;
+      active[i] = pick(gen) < 8;
+    }
+
+    arrays.Update(errors, active, dt, cmds);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      if (!active[i])
+      {
+        EXPECT_EQ(cmds[i], 0.0);
+        continue;
+      }
+
+      expectSame(cmds[i], pids[i].Update(errors[i], dtTime));
+
+      // The proportional error of a PID is the last one it was given,
+      // while the arrays keep the last finite one.
+      double pe, ie, de, arrayPe, arrayIe, arrayDe;
+      pids[i].GetErrors(pe, ie, de);
+      arrays.Get(i).GetErrors(arrayPe, arrayIe, arrayDe);
+      if (std::isfinite(errors[i]))
+        expectSame(arrayPe, pe);
+      expectSame(arrayIe, ie);
+      expectSame(arrayDe, de);
+      expectSame(arrays.Get(i).GetCmd(), pids[i].GetCmd());
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(JointControllerTest, PidArraysGetSet)
+{
+  physics::JointPidArrays arrays;
+  arrays.Resize(1);
+  arrays.Set(0, common::PID(1, 0.1, 0.01, 1, -1, 1000, -1000));
+
+  std::vector<double> errors(1, 0.5);
+  std::vector<char> active(1, 1);
+  std::vector<double> cmds(1);
+  arrays.Update(errors, active, 0.01, cmds);
+
+  // The errors and command are carried into the returned PID.
+  common::PID pid = arrays.Get(0);
+  double pe, ie, de;
+  pid.GetErrors(pe, ie, de);
+  EXPECT_DOUBLE_EQ(pe, 0.5);
+  EXPECT_DOUBLE_EQ(ie, 0.005);
+  EXPECT_DOUBLE_EQ(de, 50.0);
+  EXPECT_DOUBLE_EQ(pid.GetCmd(), cmds[0]);
+
+  // So the next update of the PID matches the controller's.
+  errors[0] = 0.25;
+  arrays.Update(errors, active, 0.01, cmds);
+  EXPECT_DOUBLE_EQ(pid.Update(0.25, common::Time(0.01)), cmds[0]);
+
+  // Setting a PID resets the errors, as assigning one does.
+  arrays.Set(0, pid);
+  arrays.Get(0).GetErrors(pe, ie, de);
+  EXPECT_DOUBLE_EQ(pe, 0.0);
+  EXPECT_DOUBLE_EQ(ie, 0.0);
+  EXPECT_DOUBLE_EQ(de, 0.0);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -48,6 +48,7 @@
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -264,6 +265,11 @@ void Link::Init()
 //////////////////////////////////////////////////
 void Link::Fini()
 {
+  // Stop the world updates now, on the simulation thread. The link may be
+  // destroyed later on the teardown thread, after its physics engine
+  // objects are gone.
+  this->connections.clear();
+
   this->parentJoints.clear();
   this->childJoints.clear();
   this->collisions.clear();
@@ -985,6 +991,35 @@ void Link::SetState(const LinkState &_state)
   }*/
 }
 
+/////////////////////////////////////////////////
+void Link::SaveSnapshot(WorldSnapshot &_snapshot) const
+{
+  const math::Pose &pose = this->GetWorldPose();
+  math::Vector3 linearVel = this->GetWorldCoGLinearVel();
+  math::Vector3 angularVel = this->GetWorldAngularVel();
+
+  double values[13] = {pose.pos.x, pose.pos.y, pose.pos.z,
+    pose.rot.w, pose.rot.x, pose.rot.y, pose.rot.z,
+    linearVel.x, linearVel.y, linearVel.z,
+    angularVel.x, angularVel.y, angularVel.z};
+  _snapshot.Write(values);
+}
+
+/////////////////////////////////////////////////
+bool Link::RestoreSnapshot(const WorldSnapshot &_snapshot, size_t &_offset)
+{
+  double values[13];
+  if (!_snapshot.Read(_offset, values))
+    return false;
+
+  this->SetWorldPose(math::Pose(
+        math::Vector3(values[0], values[1], values[2]),
+        math::Quaternion(values[3], values[4], values[5], values[6])));
+  this->SetLinearVel(math::Vector3(values[7], values[8], values[9]));
+  this->SetAngularVel(math::Vector3(values[10], values[11], values[12]));
+  return true;
+}
+
 /////////////////////////////////////////////////
 double Link::GetLinearDamping() const
 {
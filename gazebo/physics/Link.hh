@@ -467,6 +467,21 @@ namespace gazebo
       /// \param[in] _state The state to set the link to.
       public: void SetState(const LinkState &_state);
 
+      /// \brief Append the dynamic state of the link to a snapshot.
+      /// The base implementation saves the pose and the velocities;
+      /// physics engines may save their own state instead.
+      /// \param[in,out] _snapshot Snapshot to append to.
+      /// \sa World::SaveSnapshot
+      public: virtual void SaveSnapshot(WorldSnapshot &_snapshot) const;
+
+      /// \brief Restore the dynamic state of the link from a snapshot.
+      /// \param[in] _snapshot Snapshot to read from.
+      /// \param[in,out] _offset Position of the link's state, advanced
+      /// past it.
+      /// \return False if the snapshot ends before the link's state.
+      public: virtual bool RestoreSnapshot(const WorldSnapshot &_snapshot,
+                  size_t &_offset);
+
       /// \brief Update the mass matrix.
       public: virtual void UpdateMass() {}
 
@@ -287,6 +287,42 @@ void Model::SetJointPositions(
     this->jointController->SetJointPositions(_jointPositions);
 }
 
+//////////////////////////////////////////////////
+unsigned int Model::GetJointAxisCount() const
+{
+  unsigned int count = 0;
+  for (auto const &joint : this->joints)
+    count += joint->GetAngleCount();
+  return count;
+}
+
+//////////////////////////////////////////////////
+bool Model::SetJointForces(const std::vector<double> &_forces)
+{
+  if (_forces.size() != this->GetJointAxisCount())
+  {
+    gzerr << "SetJointForces for model [" << this->GetScopedName()
+          << "] expects " << this->GetJointAxisCount() << " efforts, got "
+          << _forces.size() << "\n";
+    return false;
+  }
+
+  this->world->GetPhysicsEngine()->SetJointForces(this->joints, _forces);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Model::GetJointStates(std::vector<double> &_positions,
+    std::vector<double> &_velocities) const
+{
+  unsigned int count = this->GetJointAxisCount();
+  _positions.resize(count);
+  _velocities.resize(count);
+
+  this->world->GetPhysicsEngine()->GetJointStates(this->joints, _positions,
+      _velocities);
+}
+
 //////////////////////////////////////////////////
 void Model::RemoveChild(EntityPtr _child)
 {
@@ -336,7 +372,11 @@ void Model::Fini()
 {
   Entity::Fini();
 
+  // Plugins and grippers connect to the world updates, so they are
+  // destroyed here, on the simulation thread, and not by the teardown
+  // thread.
   this->plugins.clear();
+  this->grippers.clear();
   this->attachedModels.clear();
   this->joints.clear();
   this->links.clear();
@@ -228,6 +228,28 @@ namespace gazebo
       public: void SetJointPositions(
                   const std::map<std::string, double> &_jointPositions);
 
+      /// \brief Get the number of joint axes of the model, which is the
+      /// size of the arrays of SetJointForces and GetJointStates.
+      /// \return Sum of the axis counts of the joints.
+      public: unsigned int GetJointAxisCount() const;
+
+      /// \brief Apply an effort to every joint axis of the model in one
+      /// call, which is cheaper than a call to Joint::SetForce per axis.
+      /// Efforts are additive within a time step, as with Joint::SetForce.
+      /// \param[in] _forces One effort per joint axis, ordered as the
+      /// joints of GetJoints and then by axis index.
+      /// \return False if _forces does not hold GetJointAxisCount() values.
+      public: bool SetJointForces(const std::vector<double> &_forces);
+
+      /// \brief Get the position and velocity of every joint axis of the
+      /// model in one call.
+      /// \param[out] _positions Resized to GetJointAxisCount(), and filled
+      /// with one position per joint axis, ordered as in SetJointForces.
+      /// \param[out] _velocities Resized and filled as _positions, with
+      /// one velocity per joint axis.
+      public: void GetJointStates(std::vector<double> &_positions,
+                  std::vector<double> &_velocities) const;
+
       /// \brief Joint Animation.
       /// \param[in] _anim Map of joint names to their position animation.
       /// \param[in] _onComplete Callback function for when the animation
@@ -167,6 +167,27 @@ int MultiRayShape::GetFiducial(unsigned int _index)
   return this->rays[_index]->GetFiducial();
 }
 
+//////////////////////////////////////////////////
+void MultiRayShape::GetScan(std::vector<double> &_ranges,
+    std::vector<double> &_retros, std::vector<int> &_fiducials) const
+{
+  // Add min range, because we measured from min range.
+  double minRange = this->GetMinRange();
+
+  size_t count = this->rays.size();
+  _ranges.resize(count);
+  _retros.resize(count);
+  _fiducials.resize(count);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    const RayShapePtr &ray = this->rays[i];
+    _ranges[i] = minRange + ray->GetLength();
+    _retros[i] = ray->GetRetro();
+    _fiducials[i] = ray->GetFiducial();
+  }
+}
+
 //////////////////////////////////////////////////
 void MultiRayShape::Update()
 {
@@ -69,6 +69,18 @@ namespace gazebo
       /// \return Fiducial value for the ray.
       public: int GetFiducial(unsigned int _index);
 
+      /// \brief Get the detected values of all the rays at once. This
+      /// avoids the per ray bounds checks and range lookups of GetRange,
+      /// GetRetro and GetFiducial.
+      /// \param[out] _ranges Range of each ray, resized to the ray count.
+      /// \param[out] _retros Retro value of each ray, resized to the ray
+      /// count.
+      /// \param[out] _fiducials Fiducial value of each ray, resized to the
+      /// ray count.
+      public: void GetScan(std::vector<double> &_ranges,
+                  std::vector<double> &_retros,
+                  std::vector<int> &_fiducials) const;
+
       /// \brief Get the minimum range.
       /// \return Minimum range of all the rays.
       public: double GetMinRange() const;
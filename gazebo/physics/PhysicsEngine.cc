@@ -34,11 +34,13 @@
 #include "gazebo/math/Rand.hh"
 
 #include "gazebo/physics/ContactManager.hh"
+#include "gazebo/physics/Joint.hh"
 #include "gazebo/physics/Link.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -92,6 +94,46 @@ void PhysicsEngine::Fini()
   this->node->Fini();
 }
 
+//////////////////////////////////////////////////
+void PhysicsEngine::SaveSnapshot(WorldSnapshot &/*_snapshot*/) const
+{
+}
+
+//////////////////////////////////////////////////
+bool PhysicsEngine::RestoreSnapshot(const WorldSnapshot &/*_snapshot*/,
+    size_t &/*_offset*/)
+{
+  return true;
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::SetJointForces(const Joint_V &_joints,
+    const std::vector<double> &_forces)
+{
+  size_t offset = 0;
+  for (auto const &joint : _joints)
+  {
+    for (unsigned int i = 0; i < joint->GetAngleCount(); ++i)
+      joint->SetForce(i, _forces[offset++]);
+  }
+}
+
+//////////////////////////////////////////////////
+void PhysicsEngine::GetJointStates(const Joint_V &_joints,
+    std::vector<double> &_positions, std::vector<double> &_velocities) const
+{
+  size_t offset = 0;
+  for (auto const &joint : _joints)
+  {
+    for (unsigned int i = 0; i < joint->GetAngleCount(); ++i)
+    {
+      _positions[offset] = joint->GetAngle(i).Radian();
+      _velocities[offset] = joint->GetVelocity(i);
+      ++offset;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 PhysicsEngine::~PhysicsEngine()
 {
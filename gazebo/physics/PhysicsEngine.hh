@@ -19,6 +19,7 @@
 
 #include <boost/thread/recursive_mutex.hpp>
 #include <string>
+#include <vector>
 
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/msgs/msgs.hh"
@@ -73,6 +74,43 @@ namespace gazebo
       /// \param[in] _seed The random number seed.
       public: virtual void SetSeed(uint32_t _seed) = 0;
 
+      /// \brief Append the state of the engine that is not held by links
+      /// and joints to a snapshot, such as its random number generator.
+      /// The base implementation saves nothing.
+      /// \param[in,out] _snapshot Snapshot to append to.
+      /// \sa World::SaveSnapshot
+      public: virtual void SaveSnapshot(WorldSnapshot &_snapshot) const;
+
+      /// \brief Restore the state of the engine from a snapshot.
+      /// \param[in] _snapshot Snapshot to read from.
+      /// \param[in,out] _offset Position of the engine's state, advanced
+      /// past it.
+      /// \return False if the snapshot ends before the engine's state.
+      public: virtual bool RestoreSnapshot(const WorldSnapshot &_snapshot,
+                  size_t &_offset);
+
+      /// \brief Apply an effort to every axis of a set of joints.
+      /// The base implementation calls Joint::SetForce once per axis.
+      /// \param[in] _joints Joints to command.
+      /// \param[in] _forces One effort per joint axis, in the order of
+      /// _joints. It must hold as many values as the joints have axes.
+      /// \sa Model::SetJointForces
+      public: virtual void SetJointForces(const Joint_V &_joints,
+                  const std::vector<double> &_forces);
+
+      /// \brief Get the position and velocity of every axis of a set of
+      /// joints. The base implementation calls Joint::GetAngle and
+      /// Joint::GetVelocity once per axis.
+      /// \param[in] _joints Joints to read.
+      /// \param[out] _positions One position per joint axis, in the order
+      /// of _joints. It must hold as many values as the joints have axes.
+      /// \param[out] _velocities One velocity per joint axis, sized as
+      /// _positions.
+      /// \sa Model::GetJointStates
+      public: virtual void GetJointStates(const Joint_V &_joints,
+                  std::vector<double> &_positions,
+                  std::vector<double> &_velocities) const;
+
       /// \brief Get the simulation update period.
       /// \return Simulation update period.
       public: double GetUpdatePeriod();
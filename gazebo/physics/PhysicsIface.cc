@@ -23,16 +23,22 @@
 
 #include <boost/thread/mutex.hpp>
 #include "gazebo/common/Console.hh"
+#include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
 #include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/PrototypeCache.hh"
 #include "gazebo/gazebo_config.h"
 
 using namespace gazebo;
 
+/// \brief The worlds of the process.
 std::vector<physics::WorldPtr> g_worlds;
 
+/// \brief Protects g_worlds, which may change while other worlds run.
+boost::mutex g_worldsMutex;
+
 boost::mutex g_uniqueIdMutex;
 uint32_t g_uniqueId = 0;
 
@@ -54,6 +60,8 @@ bool physics::fini()
 physics::WorldPtr physics::create_world(const std::string &_name)
 {
   physics::WorldPtr world(new physics::World(_name));
+
+  boost::mutex::scoped_lock lock(g_worldsMutex);
   g_worlds.push_back(world);
   return world;
 }
@@ -61,19 +69,22 @@ physics::WorldPtr physics::create_world(const std::string &_name)
 /////////////////////////////////////////////////
 physics::WorldPtr physics::get_world(const std::string &_name)
 {
-  if (_name.empty())
   {
-    if (g_worlds.empty())
-      gzerr << "no worlds\n";
+    boost::mutex::scoped_lock lock(g_worldsMutex);
+    if (_name.empty())
+    {
+      if (g_worlds.empty())
+        gzerr << "no worlds\n";
+      else
+        return *(g_worlds.begin());
+    }
     else
-      return *(g_worlds.begin());
-  }
-  else
-  {
-    for (auto const &world : g_worlds)
     {
-      if (world->GetName() == _name)
-        return world;
+      for (auto const &world : g_worlds)
+      {
+        if (world->GetName() == _name)
+          return world;
+      }
     }
   }
 
@@ -82,38 +93,60 @@ physics::WorldPtr physics::get_world(const std::string &_name)
   gzthrow("Unable to find world by name in physics::get_world(world_name)");
 }
 
+/////////////////////////////////////////////////
+physics::World_V physics::get_worlds()
+{
+  boost::mutex::scoped_lock lock(g_worldsMutex);
+  return g_worlds;
+}
+
+/////////////////////////////////////////////////
+bool physics::has_world(const std::string &_name)
+{
+  boost::mutex::scoped_lock lock(g_worldsMutex);
+  for (auto const &world : g_worlds)
+  {
+    if (world->GetName() == _name)
+      return true;
+  }
+
+  return false;
+}
+
 /////////////////////////////////////////////////
 void physics::load_worlds(sdf::ElementPtr _sdf)
 {
-  for (auto &world : g_worlds)
+  // The worlds are loaded without the lock, since loading a world looks
+  // up worlds by name.
+  for (auto &world : get_worlds())
     world->Load(_sdf);
 }
 
 /////////////////////////////////////////////////
 void physics::init_worlds()
 {
-  for (auto &world : g_worlds)
+  for (auto &world : get_worlds())
     world->Init();
 }
 
 /////////////////////////////////////////////////
 void physics::run_worlds(unsigned int _steps)
 {
-  for (auto &world : g_worlds)
+  for (auto &world : get_worlds())
     world->Run(_steps);
 }
 
 /////////////////////////////////////////////////
 void physics::pause_worlds(bool _pause)
 {
-  for (auto &world : g_worlds)
+  for (auto &world : get_worlds())
     world->SetPaused(_pause);
 }
 
 /////////////////////////////////////////////////
 void physics::stop_worlds()
 {
-  for (auto &world : g_worlds)
+  for (auto &world : get_worlds())
     world->Stop();
 }
 
@@ -150,19 +183,52 @@ void physics::stop_world(WorldPtr _world)
 /////////////////////////////////////////////////
 void physics::remove_worlds()
 {
-  for (auto &world : g_worlds)
+  World_V worlds;
   {
+    boost::mutex::scoped_lock lock(g_worldsMutex);
+    worlds.swap(g_worlds);
+  }
+
+  for (auto &world : worlds)
+  {
+    event::Events::worldRemoved(world->GetName());
     world->Fini();
     world.reset();
   }
+}
 
-  g_worlds.clear();
+/////////////////////////////////////////////////
+bool physics::remove_world(const std::string &_name)
+{
+  WorldPtr world;
+  {
+    boost::mutex::scoped_lock lock(g_worldsMutex);
+    for (auto iter = g_worlds.begin(); iter != g_worlds.end(); ++iter)
+    {
+      if ((*iter)->GetName() == _name)
+      {
+        world = *iter;
+        g_worlds.erase(iter);
+        break;
+      }
+    }
+  }
+
+  if (!world)
+    return false;
+
+  // Let users of the world, such as its sensors, let go of it before
+  // its physics engine is destroyed.
+  event::Events::worldRemoved(_name);
+
+  world->Fini();
+  return true;
 }
 
 /////////////////////////////////////////////////
 bool physics::worlds_running()
 {
-  for (auto const &world : g_worlds)
+  for (auto const &world : get_worlds())
   {
     if (world->GetRunning())
       return true;
@@ -171,6 +237,13 @@ bool physics::worlds_running()
   return false;
 }
 
+/////////////////////////////////////////////////
+physics::PrototypeCachePtr physics::get_prototype_cache()
+{
+  static PrototypeCachePtr cache(new PrototypeCache(256));
+  return cache;
+}
+
 /////////////////////////////////////////////////
 uint32_t physics::getUniqueId()
 {
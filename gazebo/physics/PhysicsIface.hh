@@ -52,6 +52,18 @@ namespace gazebo
     GZ_PHYSICS_VISIBLE
     WorldPtr get_world(const std::string &_name = "");
 
+    /// \brief Get all the worlds. Several worlds may run in the same
+    /// process, each in its own thread, as long as their names differ.
+    /// \return The worlds, in the order they were created.
+    GZ_PHYSICS_VISIBLE
+    World_V get_worlds();
+
+    /// \brief Return true if a world with the given name exists.
+    /// \param[in] _name Name of the world.
+    /// \return True if the world exists.
+    GZ_PHYSICS_VISIBLE
+    bool has_world(const std::string &_name);
+
     /// \brief Load world from sdf::Element pointer.
     /// \param[in] _world Pointer to a world.
     /// \param[in] _sdf SDF values to load from.
@@ -114,6 +126,18 @@ namespace gazebo
     GZ_PHYSICS_VISIBLE
     void remove_worlds();
 
+    /// \brief Stop and remove one world, leaving the other worlds
+    /// running.
+    /// \param[in] _name Name of the world to remove.
+    /// \return False if the world was not found.
+    GZ_PHYSICS_VISIBLE
+    bool remove_world(const std::string &_name);
+
+    /// \brief Get the cache of parsed SDF shared by all the worlds.
+    /// \return The prototype cache.
+    GZ_PHYSICS_VISIBLE
+    PrototypeCachePtr get_prototype_cache();
+
     /// \brief Return true if any world is running.
     /// \return True if any world is running.
     GZ_PHYSICS_VISIBLE
@@ -43,11 +43,15 @@ namespace gazebo
     class Joint;
     class JointController;
     class Contact;
+    class EntityRegistry;
     class PresetManager;
     class PhysicsEngine;
+    class PrototypeCache;
     class Mass;
     class Road;
     class Shape;
+    class TeardownQueue;
+    class WorldSnapshot;
     class RayShape;
     class MultiRayShape;
     class Inertial;
@@ -119,6 +123,10 @@ namespace gazebo
     /// \brief Boost shared pointer to a JointController object
     typedef boost::shared_ptr<JointController> JointControllerPtr;
 
+    /// \def  EntityRegistryPtr
+    /// \brief Boost shared pointer to an EntityRegistry object
+    typedef boost::shared_ptr<EntityRegistry> EntityRegistryPtr;
+
     /// \def  PhysicsEnginePtr
     /// \brief Boost shared pointer to a PhysicsEngine object
     typedef boost::shared_ptr<PhysicsEngine> PhysicsEnginePtr;
@@ -127,6 +135,14 @@ namespace gazebo
     /// \brief Shared pointer to a PresetManager object
     typedef boost::shared_ptr<PresetManager> PresetManagerPtr;
 
+    /// \def  PrototypeCachePtr
+    /// \brief Boost shared pointer to a PrototypeCache object
+    typedef boost::shared_ptr<PrototypeCache> PrototypeCachePtr;
+
+    /// \def  TeardownQueuePtr
+    /// \brief Boost shared pointer to a TeardownQueue object
+    typedef boost::shared_ptr<TeardownQueue> TeardownQueuePtr;
+
     /// \def ShapePtr
     /// \brief Boost shared pointer to a Shape object
     typedef boost::shared_ptr<Shape> ShapePtr;
@@ -191,6 +207,10 @@ namespace gazebo
     /// \brief Vector of BasePtr
     typedef std::vector<BasePtr> Base_V;
 
+    /// \def World_V
+    /// \brief Vector of WorldPtr
+    typedef std::vector<WorldPtr> World_V;
+
     /// \def Model_V
     /// \brief Vector of ModelPtr
     typedef std::vector<ModelPtr> Model_V;
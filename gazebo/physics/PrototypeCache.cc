@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "gazebo/common/Console.hh"
+#include "gazebo/physics/PrototypeCache.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+PrototypeCache::PrototypeCache(unsigned int _capacity)
+  : capacity(std::max(1u, _capacity)), hits(0), misses(0)
+{
+}
+
+//////////////////////////////////////////////////
+PrototypeCache::~PrototypeCache()
+{
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+sdf::ElementPtr PrototypeCache::FromString(const std::string &_sdf)
+{
+  std::string key = "string:" + _sdf;
+
+  sdf::ElementPtr root = this->Find(key);
+  if (root)
+    return root;
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF);
+  sdf::initFile("root.sdf", sdfParsed);
+  if (!sdf::readString(_sdf, sdfParsed))
+    return sdf::ElementPtr();
+
+  this->Add(key, sdfParsed->Root());
+  return sdfParsed->Root();
+}
+
+//////////////////////////////////////////////////
+sdf::ElementPtr PrototypeCache::FromFile(const std::string &_filename)
+{
+  // A file is reparsed when it is modified.
+  boost::system::error_code ec;
+  std::time_t modified = boost::filesystem::last_write_time(_filename, ec);
+  if (ec)
+    modified = 0;
+
+  std::string key = "file:" + _filename + ":" +
+    boost::lexical_cast<std::string>(modified);
+
+  sdf::ElementPtr root = this->Find(key);
+  if (root)
+    return root;
+
+  sdf::SDFPtr sdfParsed(new sdf::SDF);
+  sdf::initFile("root.sdf", sdfParsed);
+  if (!sdf::readFile(_filename, sdfParsed))
+    return sdf::ElementPtr();
+
+  this->Add(key, sdfParsed->Root());
+  return sdfParsed->Root();
+}
+
+//////////////////////////////////////////////////
+void PrototypeCache::Clear()
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  this->entries.clear();
+  this->usage.clear();
+}
+
+//////////////////////////////////////////////////
+unsigned int PrototypeCache::GetSize() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->entries.size();
+}
+
+//////////////////////////////////////////////////
+uint64_t PrototypeCache::GetHitCount() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->hits;
+}
+
+//////////////////////////////////////////////////
+uint64_t PrototypeCache::GetMissCount() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->misses;
+}
+
+//////////////////////////////////////////////////
+sdf::ElementPtr PrototypeCache::Find(const std::string &_key)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+
+  boost::unordered_map<std::string, Entry>::iterator iter =
+    this->entries.find(_key);
+  if (iter == this->entries.end())
+  {
+    this->misses++;
+    return sdf::ElementPtr();
+  }
+
+  this->hits++;
+  this->usage.splice(this->usage.begin(), this->usage, iter->second.usage);
+  return iter->second.root;
+}
+
+//////////////////////////////////////////////////
+void PrototypeCache::Add(const std::string &_key, sdf::ElementPtr _root)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+
+  if (this->entries.find(_key) != this->entries.end())
+    return;
+
+  while (this->entries.size() >= this->capacity)
+  {
+    this->entries.erase(this->usage.back());
+    this->usage.pop_back();
+  }
+
+  this->usage.push_front(_key);
+  Entry &entry = this->entries[_key];
+  entry.root = _root;
+  entry.usage = this->usage.begin();
+}
+
+//////////////////////////////////////////////////
+bool PrototypeCache::Override(sdf::ElementPtr _elem,
+    const std::string &_path, const std::string &_value)
+{
+  if (!_elem || _path.empty())
+    return false;
+
+  std::vector<std::string> segments;
+  boost::split(segments, _path, boost::is_any_of("/"));
+
+  sdf::ElementPtr elem = _elem;
+  for (unsigned int i = 0; i < segments.size(); ++i)
+  {
+    const std::string &segment = segments[i];
+
+    // The last segment may name an attribute.
+    if (i + 1 == segments.size() && !segment.empty() && segment[0] == '@')
+    {
+      sdf::ParamPtr attr = elem->GetAttribute(segment.substr(1));
+      if (!attr)
+      {
+        gzerr << "No attribute[" << segment.substr(1) << "] in override path["
+              << _path << "]\n";
+        return false;
+      }
+      return attr->SetFromString(_value);
+    }
+
+    // Split "name[selector]".
+    std::string name = segment;
+    std::string selector;
+    size_t open = segment.find('[');
+    if (open != std::string::npos)
+    {
+      size_t close = segment.find(']', open);
+      if (close == std::string::npos || close != segment.size() - 1)
+      {
+        gzerr << "Invalid segment[" << segment << "] in override path["
+              << _path << "]\n";
+        return false;
+      }
+      name = segment.substr(0, open);
+      selector = segment.substr(open + 1, close - open - 1);
+    }
+
+    if (name.empty())
+    {
+      gzerr << "Empty segment in override path[" << _path << "]\n";
+      return false;
+    }
+
+    sdf::ElementPtr child;
+    if (selector.empty())
+    {
+      // A missing element is added, so that optional values can be set.
+      child = elem->GetElement(name);
+    }
+    else if (elem->HasElement(name))
+    {
+      for (child = elem->GetElement(name); child;
+           child = child->GetNextElement(name))
+      {
+        if (child->HasAttribute("name") &&
+            child->GetAttribute("name")->GetAsString() == selector)
+        {
+          break;
+        }
+      }
+    }
+
+    if (!child)
+    {
+      gzerr << "No element[" << segment << "] in override path["
+            << _path << "]\n";
+      return false;
+    }
+    elem = child;
+  }
+
+  if (!elem->GetValue())
+  {
+    gzerr << "Element[" << elem->GetName() << "] in override path["
+          << _path << "] has no value\n";
+    return false;
+  }
+
+  return elem->GetValue()->SetFromString(_value);
+}
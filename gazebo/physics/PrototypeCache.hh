@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_PHYSICS_PROTOTYPECACHE_HH_
+#define _GAZEBO_PHYSICS_PROTOTYPECACHE_HH_
+
+#include <stdint.h>
+#include <list>
+#include <string>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered/unordered_map.hpp>
+#include <sdf/sdf.hh>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class PrototypeCache PrototypeCache.hh physics/physics.hh
+    /// \brief A cache of parsed SDF, used to spawn many models from the
+    /// same description without parsing it each time.
+    ///
+    /// SDF strings are keyed by their content, and files by their name
+    /// and modification time. The cache holds a limited number of
+    /// prototypes and evicts the least recently used one when full.
+    /// Prototypes are shared, so they must be cloned before they are
+    /// modified.
+    class GZ_PHYSICS_VISIBLE PrototypeCache
+    {
+      /// \brief Constructor.
+      /// \param[in] _capacity Maximum number of prototypes kept.
+      public: explicit PrototypeCache(unsigned int _capacity = 64);
+
+      /// \brief Destructor.
+      public: virtual ~PrototypeCache();
+
+      /// \brief Get the parsed SDF of a string, parsing it if it is not
+      /// cached.
+      /// \param[in] _sdf SDF string.
+      /// \return Root element of the parsed SDF, or NULL if the string is
+      /// not valid SDF.
+      public: sdf::ElementPtr FromString(const std::string &_sdf);
+
+      /// \brief Get the parsed SDF of a file, parsing it if it is not
+      /// cached or was modified since.
+      /// \param[in] _filename Path of the SDF file.
+      /// \return Root element of the parsed SDF, or NULL if the file is
+      /// not valid SDF.
+      public: sdf::ElementPtr FromFile(const std::string &_filename);
+
+      /// \brief Remove all prototypes.
+      public: void Clear();
+
+      /// \brief Get the number of prototypes.
+      /// \return Number of prototypes in the cache.
+      public: unsigned int GetSize() const;
+
+      /// \brief Get the number of lookups that found a prototype.
+      /// \return Number of cache hits.
+      public: uint64_t GetHitCount() const;
+
+      /// \brief Get the number of lookups that parsed SDF.
+      /// \return Number of cache misses.
+      public: uint64_t GetMissCount() const;
+
+      /// \brief Set a value in an SDF element tree.
+      ///
+      /// The path names the descendant elements of _elem, separated by
+      /// '/'. An element with a name attribute may be selected by name
+      /// in brackets, and a last segment starting with '@' names an
+      /// attribute. For example "link[base]/inertial/mass" sets the mass
+      /// of link "base", and "joint[arm]/@type" sets the type of joint
+      /// "arm".
+      /// \param[in] _elem Element the path is relative to.
+      /// \param[in] _path Path of the element or attribute.
+      /// \param[in] _value New value.
+      /// \return False if the path or the value is not valid.
+      public: static bool Override(sdf::ElementPtr _elem,
+                  const std::string &_path, const std::string &_value);
+
+      /// \brief A cached prototype.
+      private: class Entry
+      {
+        /// \brief Root element of the parsed SDF.
+        public: sdf::ElementPtr root;
+
+        /// \brief Position of the key in the recently used list.
+        public: std::list<std::string>::iterator usage;
+      };
+
+      /// \brief Find a prototype and mark it as recently used.
+      /// \param[in] _key Key of the prototype.
+      /// \return The prototype's root element, or NULL.
+      private: sdf::ElementPtr Find(const std::string &_key);
+
+      /// \brief Add a prototype, evicting the least recently used one if
+      /// the cache is full.
+      /// \param[in] _key Key of the prototype.
+      /// \param[in] _root Root element of the parsed SDF.
+      private: void Add(const std::string &_key, sdf::ElementPtr _root);
+
+      /// \brief Prototypes by key.
+      private: boost::unordered_map<std::string, Entry> entries;
+
+      /// \brief Keys, most recently used first.
+      private: std::list<std::string> usage;
+
+      /// \brief Maximum number of prototypes.
+      private: unsigned int capacity;
+
+      /// \brief Number of cache hits.
+      private: uint64_t hits;
+
+      /// \brief Number of cache misses.
+      private: uint64_t misses;
+
+      /// \brief Protects the cache.
+      private: mutable boost::mutex mutex;
+    };
+    /// \}
+  }
+}
+#endif
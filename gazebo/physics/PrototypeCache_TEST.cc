@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+
+#include "test/util.hh"
+#include "gazebo/physics/PrototypeCache.hh"
+
+using namespace gazebo;
+
+class PrototypeCacheTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+/// \brief Get the SDF of a model with one link.
+/// \param[in] _name Name of the model.
+/// \return SDF string.
+std::string modelString(const std::string &_name)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='" << _name << "'>"
+    << "  <link name='base'>"
+    << "    <inertial><mass>1.0</mass></inertial>"
+    << "  </link>"
+    << "  <link name='arm'/>"
+    << "</model>"
+    << "</sdf>";
+  return sdfStr.str();
+}
+
+/////////////////////////////////////////////////
+TEST_F(PrototypeCacheTest, FromString)
+{
+  physics::PrototypeCache cache;
+
+  sdf::ElementPtr root = cache.FromString(modelString("robot"));
+  ASSERT_TRUE(root != NULL);
+  EXPECT_EQ(cache.GetSize(), 1u);
+  EXPECT_EQ(cache.GetMissCount(), 1u);
+  EXPECT_EQ(cache.GetHitCount(), 0u);
+
+  // The same string is not parsed again.
+  EXPECT_EQ(cache.FromString(modelString("robot")), root);
+  EXPECT_EQ(cache.GetHitCount(), 1u);
+
+  // A different string is.
+  sdf::ElementPtr other = cache.FromString(modelString("robot2"));
+  ASSERT_TRUE(other != NULL);
+  EXPECT_NE(other, root);
+  EXPECT_EQ(cache.GetSize(), 2u);
+
+  EXPECT_TRUE(cache.FromString("<sdf>not valid") == NULL);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PrototypeCacheTest, Evict)
+{
+  physics::PrototypeCache cache(2);
+
+  sdf::ElementPtr a = cache.FromString(modelString("a"));
+  cache.FromString(modelString("b"));
+
+  // Use "a", so that "b" is the least recently used.
+  EXPECT_EQ(cache.FromString(modelString("a")), a);
+  cache.FromString(modelString("c"));
+  EXPECT_EQ(cache.GetSize(), 2u);
+
+  uint64_t misses = cache.GetMissCount();
+  EXPECT_EQ(cache.FromString(modelString("a")), a);
+  EXPECT_EQ(cache.GetMissCount(), misses);
+  cache.FromString(modelString("b"));
+  EXPECT_EQ(cache.GetMissCount(), misses + 1);
+}
+
+/////////////////////////////////////////////////
+TEST_F(PrototypeCacheTest, Override)
+{
+  physics::PrototypeCache cache;
+  sdf::ElementPtr root = cache.FromString(modelString("robot"));
+  ASSERT_TRUE(root != NULL);
+
+  sdf::ElementPtr model = root->Clone()->GetElement("model");
+  ASSERT_TRUE(model != NULL);
+
+  EXPECT_TRUE(physics::PrototypeCache::Override(model, "@name", "robot_1"));
+  EXPECT_EQ(model->Get<std::string>("name"), "robot_1");
+
+  EXPECT_TRUE(physics::PrototypeCache::Override(model,
+        "link[base]/inertial/mass", "2.5"));
+  EXPECT_DOUBLE_EQ(model->GetElement("link")->GetElement("inertial")->
+      Get<double>("mass"), 2.5);
+
+  // Select the second link by name, and add a missing element.
+  EXPECT_TRUE(physics::PrototypeCache::Override(model,
+        "link[arm]/inertial/mass", "0.5"));
+  sdf::ElementPtr arm = model->GetElement("link")->GetNextElement("link");
+  ASSERT_TRUE(arm != NULL);
+  EXPECT_DOUBLE_EQ(arm->GetElement("inertial")->Get<double>("mass"), 0.5);
+
+  EXPECT_FALSE(physics::PrototypeCache::Override(model,
+        "link[missing]/inertial/mass", "1"));
+  EXPECT_FALSE(physics::PrototypeCache::Override(model, "@missing", "1"));
+  EXPECT_FALSE(physics::PrototypeCache::Override(model, "link[base", "1"));
+  EXPECT_FALSE(physics::PrototypeCache::Override(model, "", "1"));
+
+  // The prototype is unchanged.
+  EXPECT_EQ(root->GetElement("model")->Get<std::string>("name"), "robot");
+  EXPECT_DOUBLE_EQ(root->GetElement("model")->GetElement("link")->
+      GetElement("inertial")->Get<double>("mass"), 1.0);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <boost/bind.hpp>
+
+#include "gazebo/physics/TeardownQueue.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+TeardownQueue::TeardownQueue()
+  : busy(0), reclaimed(0), stop(false)
+{
+  this->thread = new boost::thread(boost::bind(&TeardownQueue::Run, this));
+}
+
+//////////////////////////////////////////////////
+TeardownQueue::~TeardownQueue()
+{
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    this->stop = true;
+    this->pushCondition.notify_all();
+  }
+
+  this->thread->join();
+  delete this->thread;
+  this->thread = NULL;
+}
+
+//////////////////////////////////////////////////
+void TeardownQueue::PushObject(boost::shared_ptr<void> &_object)
+{
+  if (!_object)
+    return;
+
+  boost::mutex::scoped_lock lock(this->mutex);
+  this->pending.push_back(boost::shared_ptr<void>());
+  this->pending.back().swap(_object);
+  this->pushCondition.notify_one();
+}
+
+//////////////////////////////////////////////////
+void TeardownQueue::Flush()
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  while (!this->pending.empty() || this->busy > 0)
+    this->doneCondition.wait(lock);
+}
+
+//////////////////////////////////////////////////
+unsigned int TeardownQueue::GetPendingCount() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->pending.size() + this->busy;
+}
+
+//////////////////////////////////////////////////
+uint64_t TeardownQueue::GetReclaimedCount() const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return this->reclaimed;
+}
+
+//////////////////////////////////////////////////
+void TeardownQueue::Run()
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+
+  while (true)
+  {
+    while (this->pending.empty() && !this->stop)
+      this->pushCondition.wait(lock);
+
+    // Pending objects are destroyed before the thread stops.
+    if (this->pending.empty())
+      break;
+
+    std::list<boost::shared_ptr<void> > batch;
+    batch.swap(this->pending);
+    this->busy = batch.size();
+
+    // Destroy the objects without the lock, so that destructors may push
+    // more objects.
+    lock.unlock();
+    while (!batch.empty())
+      batch.pop_front();
+    lock.lock();
+
+    this->reclaimed += this->busy;
+    this->busy = 0;
+    this->doneCondition.notify_all();
+  }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_PHYSICS_TEARDOWNQUEUE_HH_
+#define _GAZEBO_PHYSICS_TEARDOWNQUEUE_HH_
+
+#include <stdint.h>
+#include <list>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class TeardownQueue TeardownQueue.hh physics/physics.hh
+    /// \brief Destroys objects on a background thread.
+    ///
+    /// The world hands over the last references to removed entities, so
+    /// that their destructors, which release transport nodes, SDF and
+    /// meshes, do not run in the simulation loop. Objects are destroyed in
+    /// the order they were pushed. Objects pushed here must already be
+    /// detached from the physics engine and disconnected from all events,
+    /// which Fini does on the simulation thread.
+    class GZ_PHYSICS_VISIBLE TeardownQueue
+    {
+      /// \brief Constructor. Starts the teardown thread.
+      public: TeardownQueue();
+
+      /// \brief Destructor. Destroys the pending objects and stops the
+      /// teardown thread.
+      public: virtual ~TeardownQueue();
+
+      /// \brief Hand over an object to be destroyed. The caller's
+      /// reference is released, so that the object is destroyed by the
+      /// teardown thread unless it is referenced elsewhere.
+      /// \param[in,out] _object Object to destroy. Reset on return.
+      public: template<typename T>
+              void Push(boost::shared_ptr<T> &_object)
+              {
+                boost::shared_ptr<void> object(_object);
+                _object.reset();
+                this->PushObject(object);
+              }
+
+      /// \brief Wait until all the pushed objects are destroyed. Must not
+      /// be called from a destructor run by the teardown thread.
+      public: void Flush();
+
+      /// \brief Get the number of objects waiting to be destroyed.
+      /// \return Number of pending objects.
+      public: unsigned int GetPendingCount() const;
+
+      /// \brief Get the number of objects destroyed so far.
+      /// \return Number of objects destroyed.
+      public: uint64_t GetReclaimedCount() const;
+
+      /// \brief Queue an object.
+      /// \param[in,out] _object Object to destroy. Reset on return.
+      private: void PushObject(boost::shared_ptr<void> &_object);
+
+      /// \brief Teardown thread.
+      private: void Run();
+
+      /// \brief Objects waiting to be destroyed.
+      private: std::list<boost::shared_ptr<void> > pending;
+
+      /// \brief Number of objects being destroyed.
+      private: unsigned int busy;
+
+      /// \brief Number of objects destroyed.
+      private: uint64_t reclaimed;
+
+      /// \brief True to stop the teardown thread.
+      private: bool stop;
+
+      /// \brief Protects the queue.
+      private: mutable boost::mutex mutex;
+
+      /// \brief Signaled when objects are pushed.
+      private: boost::condition_variable pushCondition;
+
+      /// \brief Signaled when objects are destroyed.
+      private: boost::condition_variable doneCondition;
+
+      /// \brief The teardown thread.
+      private: boost::thread *thread;
+    };
+    /// \}
+  }
+}
+#endif
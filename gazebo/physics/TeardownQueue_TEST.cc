@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <vector>
+
+#include "test/util.hh"
+#include "gazebo/physics/TeardownQueue.hh"
+
+using namespace gazebo;
+
+class TeardownQueueTest : public gazebo::testing::AutoLogFixture { };
+
+/// \brief Records the thread and order it was destroyed in.
+class Tracked
+{
+  /// \brief Constructor.
+  /// \param[in] _index Index of the object.
+  /// \param[out] _order Indices of the destroyed objects.
+  /// \param[out] _thread Thread of the last destroyed object.
+  public: Tracked(int _index, std::vector<int> *_order,
+              boost::thread::id *_thread)
+          : index(_index), order(_order), thread(_thread)
+  {
+  }
+
+  /// \brief Destructor.
+  public: ~Tracked()
+  {
+    this->order->push_back(this->index);
+    *this->thread = boost::this_thread::get_id();
+  }
+
+  /// \brief Index of the object.
+  private: int index;
+
+  /// \brief Indices of the destroyed objects.
+  private: std::vector<int> *order;
+
+  /// \brief Thread of the last destroyed object.
+  private: boost::thread::id *thread;
+};
+
+/////////////////////////////////////////////////
+TEST_F(TeardownQueueTest, Push)
+{
+  physics::TeardownQueue queue;
+  std::vector<int> order;
+  boost::thread::id thread;
+
+  for (int i = 0; i < 100; ++i)
+  {
+    boost::shared_ptr<Tracked> object(new Tracked(i, &order, &thread));
+    queue.Push(object);
+    EXPECT_TRUE(object == NULL);
+  }
+
+  queue.Flush();
+  EXPECT_EQ(queue.GetPendingCount(), 0u);
+  EXPECT_EQ(queue.GetReclaimedCount(), 100u);
+
+  // Objects are destroyed in order, on the teardown thread.
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(order[i], i);
+  EXPECT_NE(thread, boost::this_thread::get_id());
+}
+
+/////////////////////////////////////////////////
+TEST_F(TeardownQueueTest, SharedObject)
+{
+  physics::TeardownQueue queue;
+  std::vector<int> order;
+  boost::thread::id thread;
+
+  // An object referenced elsewhere outlives the queue's reference.
+  boost::shared_ptr<Tracked> object(new Tracked(0, &order, &thread));
+  boost::shared_ptr<Tracked> other = object;
+  queue.Push(object);
+  queue.Flush();
+  EXPECT_TRUE(order.empty());
+
+  other.reset();
+  EXPECT_EQ(order.size(), 1u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(TeardownQueueTest, Destructor)
+{
+  std::vector<int> order;
+  boost::thread::id thread;
+
+  // Pending objects are destroyed with the queue.
+  {
+    physics::TeardownQueue queue;
+    for (int i = 0; i < 10; ++i)
+    {
+      boost::shared_ptr<Tracked> object(new Tracked(i, &order, &thread));
+      queue.Push(object);
+    }
+  }
+  EXPECT_EQ(order.size(), 10u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -33,14 +33,19 @@
 
 #include <sdf/sdf.hh>
 
+#include <algorithm>
+#include <cmath>
 #include <deque>
+#include <limits>
 #include <list>
 #include <set>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include <ignition/math/Rand.hh>
 
+#include "gazebo/sensors/Sensor.hh"
 #include "gazebo/sensors/SensorManager.hh"
 #include "gazebo/math/Rand.hh"
 
@@ -52,6 +57,7 @@
 #include "gazebo/util/LogPlay.hh"
 
 #include "gazebo/common/ModelDatabase.hh"
+#include "gazebo/common/MeshManager.hh"
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Events.hh"
 #include "gazebo/common/Exception.hh"
@@ -69,9 +75,16 @@
 #include "gazebo/physics/Road.hh"
 #include "gazebo/physics/RayShape.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Joint.hh"
+#include "gazebo/physics/JointController.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
 #include "gazebo/physics/PresetManager.hh"
+#include "gazebo/physics/PrototypeCache.hh"
+#include "gazebo/physics/PhysicsIface.hh"
+#include "gazebo/physics/EntityRegistry.hh"
+#include "gazebo/physics/TeardownQueue.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/physics/Model.hh"
 #include "gazebo/physics/Actor.hh"
 #include "gazebo/physics/WorldPrivate.hh"
@@ -85,9 +98,105 @@
 using namespace gazebo;
 using namespace physics;
 
-/// \brief Flag used to say if/when to clear all models.
-/// This will be replaced with a class member variable in Gazebo 3.0
-bool g_clearModels;
+//////////////////////////////////////////////////
+/// \brief Add an entity and all its descendants to a list.
+/// \param[in] _entity The entity.
+/// \param[out] _entities The list.
+static void collectEntities(const BasePtr &_entity, Base_V &_entities)
+{
+  _entities.push_back(_entity);
+  for (unsigned int i = 0; i < _entity->GetChildCount(); ++i)
+    collectEntities(_entity->GetChild(i), _entities);
+}
+
+/// \brief Version of the format written by World::SaveSnapshot.
+static const uint32_t snapshotVersion = 2;
+
+//////////////////////////////////////////////////
+/// \brief Check that the models of a world, and their links and joints,
+/// are the ones a snapshot was saved from. Entities are compared by name,
+/// so that a snapshot may be restored into a copy of the world.
+/// \param[in] _models The models of the world.
+/// \param[in] _snapshot The snapshot.
+/// \param[in,out] _offset Position of the structure in the snapshot,
+/// advanced past it.
+/// \return True if the structure matches.
+static bool snapshotMatches(const Model_V &_models,
+    const WorldSnapshot &_snapshot, size_t &_offset)
+{
+  uint32_t count;
+  std::string name;
+  if (!_snapshot.Read(_offset, count) || count != _models.size())
+    return false;
+
+  for (auto const &model : _models)
+  {
+    if (!_snapshot.Read(_offset, name) || name != model->GetName())
+      return false;
+
+    const Link_V &links = model->GetLinks();
+    if (!_snapshot.Read(_offset, count) || count != links.size())
+      return false;
+    for (auto const &link : links)
+    {
+      if (!_snapshot.Read(_offset, name) || name != link->GetName())
+        return false;
+    }
+
+    const Joint_V &joints = model->GetJoints();
+    if (!_snapshot.Read(_offset, count) || count != joints.size())
+      return false;
+    for (auto const &joint : joints)
+    {
+      if (!_snapshot.Read(_offset, name) || name != joint->GetName())
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the mesh files used by the collisions of an element and its
+/// descendants to a set.
+/// \param[in] _elem The element.
+/// \param[in] _inCollision True if the element is part of a collision.
+/// \param[out] _uris The mesh files.
+static void collectCollisionMeshes(const sdf::ElementPtr &_elem,
+    bool _inCollision, std::set<std::string> &_uris)
+{
+  _inCollision = _inCollision || _elem->GetName() == "collision";
+  if (_inCollision && _elem->GetName() == "mesh" && _elem->HasElement("uri"))
+    _uris.insert(_elem->Get<std::string>("uri"));
+
+  for (sdf::ElementPtr child = _elem->GetFirstElement(); child;
+       child = child->GetNextElement())
+  {
+    collectCollisionMeshes(child, _inCollision, _uris);
+  }
+}
+
+class MeshLoad_TBB
+{
+  public: explicit MeshLoad_TBB(const std::vector<std::string> *_filenames)
+          : filenames(_filenames) {}
+  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+  {
+    for (size_t i = _r.begin(); i != _r.end(); i++)
+    {
+      // Errors are reported again when the shape loads the mesh.
+      try
+      {
+        common::MeshManager::Instance()->Load((*filenames)[i]);
+      }
+      catch(common::Exception &)
+      {
+      }
+    }
+  }
+
+  private: const std::vector<std::string> *filenames;
+};
 
 class ModelUpdate_TBB
 {
@@ -107,7 +216,7 @@ class ModelUpdate_TBB
 World::World(const std::string &_name)
   : dataPtr(new WorldPrivate)
 {
-  g_clearModels = false;
+  this->dataPtr->clearModels = false;
   this->dataPtr->sdf.reset(new sdf::Element);
   sdf::initFile("world.sdf", this->dataPtr->sdf);
 
@@ -120,8 +229,12 @@ World::World(const std::string &_name)
   this->dataPtr->receiveMutex = new boost::recursive_mutex();
   this->dataPtr->loadModelMutex = new boost::mutex();
   this->dataPtr->elementResetMutex = new boost::recursive_mutex();
+  this->dataPtr->entityRegistry.reset(new EntityRegistry);
+  this->dataPtr->teardownQueue.reset(new TeardownQueue);
+  this->dataPtr->prototypeCache = get_prototype_cache();
 
   this->dataPtr->initialized = false;
+  this->dataPtr->enableOnLoad = true;
   this->dataPtr->loaded = false;
   this->dataPtr->stepInc = 0;
   this->dataPtr->pause = false;
@@ -129,6 +242,8 @@ World::World(const std::string &_name)
   this->dataPtr->logThread = NULL;
   this->dataPtr->stop = false;
   this->dataPtr->seekPending = false;
+  this->dataPtr->spatialEnabled = false;
+  this->dataPtr->lockstepSteps = 0;
 
   this->dataPtr->currentStateBuffer = 0;
   this->dataPtr->stateToggle = 0;
@@ -150,6 +265,11 @@ World::World(const std::string &_name)
   this->dataPtr->prevStatTime = common::Time::GetWallTime();
   this->dataPtr->prevProcessMsgsTime = common::Time::GetWallTime();
 
+  this->dataPtr->poseNamesVersion = 0;
+  this->dataPtr->poseNamesDirty = false;
+  this->dataPtr->poseLinearThreshold = 0;
+  this->dataPtr->poseAngularThreshold = 0;
+
   this->dataPtr->connections.push_back(
      event::Events::ConnectStep(boost::bind(&World::OnStep, this)));
   this->dataPtr->connections.push_back(
@@ -186,6 +306,8 @@ World::~World()
 //////////////////////////////////////////////////
 void World::Load(sdf::ElementPtr _sdf)
 {
+  DIAG_TIMER_START("World::Load");
+
   this->dataPtr->loaded = false;
   this->dataPtr->sdf = _sdf;
 
@@ -220,6 +342,16 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->posePub = this->dataPtr->node->Advertise<msgs::PosesStamped>(
     "~/pose/info", 10, 60);
 
+  // compact pose pub, which sends entity names only when they change.
+  // The rate is capped by World::PublishPackedPoses, since a dropped
+  // message would lose the poses it holds.
+  this->dataPtr->posePackedPub =
+    this->dataPtr->node->Advertise<msgs::PosesPacked>(
+        "~/pose/packed/info", 10);
+  this->dataPtr->poseNamesPub =
+    this->dataPtr->node->Advertise<msgs::PoseNames>(
+        "~/pose/packed/names", 10);
+
   this->dataPtr->guiPub = this->dataPtr->node->Advertise<msgs::GUI>("~/gui", 5);
   if (this->dataPtr->sdf->HasElement("gui"))
   {
@@ -229,6 +361,8 @@ void World::Load(sdf::ElementPtr _sdf)
 
   this->dataPtr->factorySub = this->dataPtr->node->Subscribe("~/factory",
                                            &World::OnFactoryMsg, this);
+  this->dataPtr->factoryBatchSub = this->dataPtr->node->Subscribe(
+      "~/factory/batch", &World::OnFactoryBatchMsg, this);
   this->dataPtr->controlSub = this->dataPtr->node->Subscribe("~/world_control",
                                            &World::OnControl, this);
   this->dataPtr->playbackControlSub = this->dataPtr->node->Subscribe(
@@ -244,6 +378,12 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->modelSub = this->dataPtr->node->Subscribe<msgs::Model>(
       "~/model/modify", &World::OnModelMsg, this);
 
+  this->dataPtr->lockstepSub = this->dataPtr->node->Subscribe(
+      "~/lockstep/request", &World::OnLockstepRequest, this);
+  this->dataPtr->lockstepPub =
+    this->dataPtr->node->Advertise<msgs::LockstepObservation>(
+        "~/lockstep/observation", 100);
+
   this->dataPtr->responsePub = this->dataPtr->node->Advertise<msgs::Response>(
       "~/response");
   this->dataPtr->statPub =
@@ -290,6 +430,15 @@ void World::Load(sdf::ElementPtr _sdf)
   this->dataPtr->rootElement->SetName(this->GetName());
   this->dataPtr->rootElement->SetWorld(shared_from_this());
 
+  DIAG_TIMER_LAP("World::Load", "physics engine");
+
+  // Parse the collision meshes in parallel. The entities, which create
+  // physics engine objects, are then built one at a time, and find their
+  // meshes already loaded.
+  this->LoadMeshes();
+
+  DIAG_TIMER_LAP("World::Load", "meshes");
+
   // A special order is necessary when loading a world that contains state
   // information. The joints must be created last, otherwise they get
   // initialized improperly.
@@ -297,6 +446,8 @@ void World::Load(sdf::ElementPtr _sdf)
     // Create all the entities
     this->LoadEntities(this->dataPtr->sdf, this->dataPtr->rootElement);
 
+    DIAG_TIMER_LAP("World::Load", "entities");
+
     // Set the state of the entities
     if (this->dataPtr->sdf->HasElement("state"))
     {
@@ -318,6 +469,8 @@ void World::Load(sdf::ElementPtr _sdf)
 
     for (unsigned int i = 0; i < this->GetModelCount(); ++i)
       this->GetModel(i)->LoadJoints();
+
+    DIAG_TIMER_LAP("World::Load", "joints");
   }
 
   // TODO: Performance test to see if TBB model updating is necessary
@@ -330,9 +483,35 @@ void World::Load(sdf::ElementPtr _sdf)
 
   event::Events::worldCreated(this->GetName());
 
+  DIAG_TIMER_STOP("World::Load");
+
   this->dataPtr->loaded = true;
 }
 
+//////////////////////////////////////////////////
+void World::LoadMeshes()
+{
+  std::set<std::string> uris;
+  collectCollisionMeshes(this->dataPtr->sdf, false, uris);
+
+  // Files are looked up here, since the search paths are not safe to use
+  // from several threads.
+  common::MeshManager *meshManager = common::MeshManager::Instance();
+  std::vector<std::string> filenames;
+  for (auto const &uri : uris)
+  {
+    std::string filename = common::find_file(uri);
+    if (!filename.empty() && meshManager->IsValidFilename(filename) &&
+        !meshManager->HasMesh(filename))
+    {
+      filenames.push_back(filename);
+    }
+  }
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, filenames.size(), 1),
+      MeshLoad_TBB(&filenames));
+}
+
 //////////////////////////////////////////////////
 void World::Save(const std::string &_filename)
 {
@@ -380,7 +559,11 @@ void World::Init()
   this->dataPtr->iterations = 0;
   this->dataPtr->logPrevIteration = 0;
 
-  util::DiagnosticManager::Instance()->Init(this->GetName());
+  // The diagnostics manager is a singleton that reports on one world, the
+  // first one. Later worlds, such as clones, must not take it over.
+  World_V worlds = get_worlds();
+  if (worlds.empty() || worlds.front() == shared_from_this())
+    util::DiagnosticManager::Instance()->Init(this->GetName());
 
   util::LogRecord::Instance()->Add(this->GetName(), "state.log",
       boost::bind(&World::OnLog, this, _1));
@@ -446,6 +629,11 @@ void World::RunLoop()
 {
   this->dataPtr->physicsEngine->InitForThread();
 
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->lockstepMutex);
+    this->dataPtr->loopThreadId = boost::this_thread::get_id();
+  }
+
   this->dataPtr->startTime = common::Time::GetWallTime();
 
   // This fixes a minor issue when the world is paused before it's started
@@ -484,6 +672,11 @@ void World::RunLoop()
 
   this->dataPtr->stop = true;
 
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->lockstepMutex);
+    this->dataPtr->loopThreadId = boost::thread::id();
+  }
+
   if (this->dataPtr->logThread)
   {
     this->dataPtr->logCondition.notify_all();
@@ -504,31 +697,26 @@ void World::LogStep()
 
   if (this->dataPtr->stepInc < 0)
   {
-    // Step back: This is implemented by going to the beginning of the log file,
-    // and then, step forward up to the target frame.
-    // ToDo: Use keyframes in the log file to speed up this process.
-    if (!util::LogPlay::Instance()->Rewind())
+    // Step back: Jump directly to the target state using the state index of
+    // the log file. The last state played is one state behind the current
+    // position, hence the extra step back.
+    if (!util::LogPlay::Instance()->Skip(this->dataPtr->stepInc - 1))
     {
       gzerr << "Error processing a negative multi-step" << std::endl;
       this->dataPtr->stepInc = 0;
       return;
     }
 
-    this->dataPtr->stepInc = this->dataPtr->iterations + this->dataPtr->stepInc;
-
-    // For some reason, the first two chunks contains the same <iterations>
-    // value. If the log file contains <iterations> we will load the same
-    // iterations value twice and this will affect the way we're stepping back.
-    // ToDo: Fix the source of the problem for avoiding this extra step.
-    if (util::LogPlay::Instance()->HasIterations())
+    // If the log file does not contain iterations, the iteration counter is
+    // increased manually on each step.
+    if (!util::LogPlay::Instance()->HasIterations())
     {
-      this->dataPtr->stepInc +=
-        2 - util::LogPlay::Instance()->GetInitialIterations();
+      uint64_t stepBack = 1 - this->dataPtr->stepInc;
+      this->dataPtr->iterations = this->dataPtr->iterations > stepBack ?
+        this->dataPtr->iterations - stepBack : 0;
     }
 
-    if (this->dataPtr->stepInc < 1)
-      this->dataPtr->stepInc = 1;
-    this->dataPtr->iterations = 0;
+    this->dataPtr->stepInc = 1;
   }
 
   {
@@ -549,12 +737,18 @@ void World::LogStep()
   {
     boost::recursive_mutex::scoped_lock lk(*this->dataPtr->worldUpdateMutex);
 
+    // Jump close to the target simulation time of a "seek" command, instead
+    // of stepping through every state in between.
+    if (this->dataPtr->seekPending)
+      util::LogPlay::Instance()->Seek(this->dataPtr->targetSimTime);
+
     std::string data;
     if (!util::LogPlay::Instance()->Step(data))
     {
       // There are no more chunks, time to exit.
       this->SetPaused(true);
       this->dataPtr->stepInc = 0;
+      this->dataPtr->seekPending = false;
       break;
     }
     else
@@ -693,6 +887,9 @@ void World::Step()
 
     this->dataPtr->prevStepWallTime = common::Time::GetWallTime();
 
+    // Apply the commands of a new lockstep request before stepping.
+    this->ProcessLockstep(false);
+
     double stepTime = this->dataPtr->physicsEngine->GetMaxStepSize();
     if (!this->IsPaused() || this->dataPtr->stepInc > 0
         || this->dataPtr->needsReset)
@@ -706,6 +903,9 @@ void World::Step()
 
       if (this->IsPaused() && this->dataPtr->stepInc > 0)
         this->dataPtr->stepInc--;
+
+      // Observe right after the last step of a lockstep request.
+      this->ProcessLockstep(true);
     }
     else
     {
@@ -720,7 +920,7 @@ void World::Step()
 
   DIAG_TIMER_STOP("World::Step");
 
-  if (g_clearModels)
+  if (this->dataPtr->clearModels)
     this->ClearModels();
 }
 
@@ -842,10 +1042,14 @@ void World::Update()
 //////////////////////////////////////////////////
 void World::Fini()
 {
+  // The log holds a callback to this world, which must not outlive it.
+  util::LogRecord::Instance()->Remove(this->GetName());
+
   this->Stop();
   this->dataPtr->plugins.clear();
 
   this->dataPtr->publishModelPoses.clear();
+  this->dataPtr->packedModelPoses.clear();
 
   this->dataPtr->node->Fini();
 
@@ -855,6 +1059,9 @@ void World::Fini()
     this->dataPtr->rootElement.reset();
   }
 
+  // Destroy the removed models before the physics engine.
+  this->dataPtr->teardownQueue->Flush();
+
   if (this->dataPtr->physicsEngine)
   {
     this->dataPtr->physicsEngine->Fini();
@@ -873,24 +1080,42 @@ void World::Fini()
 //////////////////////////////////////////////////
 void World::Clear()
 {
-  g_clearModels = true;
+  this->dataPtr->clearModels = true;
 }
 
 //////////////////////////////////////////////////
 void World::ClearModels()
 {
-  g_clearModels = false;
+  this->dataPtr->clearModels = false;
   bool pauseState = this->IsPaused();
   this->SetPaused(true);
 
-  this->dataPtr->publishModelPoses.clear();
+  {
+    boost::recursive_mutex::scoped_lock lock(*this->dataPtr->receiveMutex);
+    this->dataPtr->publishModelPoses.clear();
+    this->dataPtr->packedModelPoses.clear();
+    this->dataPtr->packedPoses.clear();
+    this->dataPtr->poseNames.clear();
+    this->dataPtr->poseNamesDirty = true;
+  }
+
+  {
+    boost::mutex::scoped_lock lock(this->dataPtr->spatialMutex);
+    this->dataPtr->spatialTree.Clear();
+    this->dataPtr->spatialProxies.clear();
+    this->dataPtr->spatialDirty.clear();
+  }
 
-  // Remove all models
+  // Remove all models, and keep them until the teardown thread destroys
+  // them.
+  boost::shared_ptr<Base_V> removed(new Base_V);
   for (auto &model : this->dataPtr->models)
   {
+    collectEntities(model, *removed);
     this->dataPtr->rootElement->RemoveChild(model->GetId());
   }
   this->dataPtr->models.clear();
+  this->dataPtr->teardownQueue->Push(removed);
 
   this->SetPaused(pauseState);
 }
@@ -913,6 +1138,18 @@ PresetManagerPtr World::GetPresetManager() const
   return this->dataPtr->presetManager;
 }
 
+//////////////////////////////////////////////////
+EntityRegistryPtr World::GetEntityRegistry() const
+{
+  return this->dataPtr->entityRegistry;
+}
+
+//////////////////////////////////////////////////
+TeardownQueuePtr World::GetTeardownQueue() const
+{
+  return this->dataPtr->teardownQueue;
+}
+
 //////////////////////////////////////////////////
 common::SphericalCoordinatesPtr World::GetSphericalCoordinates() const
 {
@@ -966,7 +1203,8 @@ ModelPtr World::LoadModel(sdf::ElementPtr _sdf , BasePtr _parent)
     model->FillMsg(msg);
     this->dataPtr->modelPub->Publish(msg);
 
-    this->EnableAllModels();
+    if (this->dataPtr->enableOnLoad)
+      this->EnableAllModels();
   }
   else
   {
@@ -1227,6 +1465,12 @@ void World::OnFactoryMsg(ConstFactoryPtr &_msg)
   this->dataPtr->factoryMsgs.push_back(*_msg);
 }
 
+//////////////////////////////////////////////////
+void World::OnFactoryBatchMsg(ConstFactoryBatchPtr &_msg)
+{
+  this->ApplyFactoryBatch(*_msg);
+}
+
 //////////////////////////////////////////////////
 void World::OnControl(ConstWorldControlPtr &_data)
 {
@@ -1293,11 +1537,11 @@ void World::OnPlaybackControl(ConstLogPlaybackControlPtr &_data)
     this->dataPtr->stepInc += _data->multi_step();
   }
 
+  // Seeking is handled in LogStep, which jumps to the target using the state
+  // index of the log file.
   if (_data->has_seek())
   {
     this->dataPtr->targetSimTime = msgs::Convert(_data->seek());
-    if (this->GetSimTime() > this->dataPtr->targetSimTime)
-      util::LogPlay::Instance()->Rewind();
     this->dataPtr->seekPending = true;
   }
 
@@ -1310,8 +1554,6 @@ void World::OnPlaybackControl(ConstLogPlaybackControlPtr &_data)
   if (_data->has_forward() && _data->forward())
   {
     this->dataPtr->targetSimTime = util::LogPlay::Instance()->GetLogEndTime();
-    if (this->GetSimTime() > this->dataPtr->targetSimTime)
-      util::LogPlay::Instance()->Rewind();
     this->dataPtr->seekPending = true;
   }
 }
@@ -1351,6 +1593,202 @@ void World::OnModelMsg(ConstModelPtr &_msg)
   this->dataPtr->modelMsgs.push_back(*_msg);
 }
 
+//////////////////////////////////////////////////
+void World::OnLockstepRequest(ConstLockstepRequestPtr &_msg)
+{
+  // A log playback world does not step, so the request would never be
+  // served.
+  if (util::LogPlay::Instance()->IsOpen())
+  {
+    gzerr << "Lockstep requests are not served during log playback\n";
+    return;
+  }
+
+  boost::shared_ptr<LockstepCall> call(new LockstepCall);
+  call->request = *_msg;
+  call->done = false;
+  call->publish = true;
+
+  boost::mutex::scoped_lock lock(this->dataPtr->lockstepMutex);
+  this->dataPtr->lockstepCalls.push_back(call);
+}
+
+//////////////////////////////////////////////////
+bool World::Lockstep(const msgs::LockstepRequest &_request,
+    msgs::LockstepObservation &_observation)
+{
+  if (util::LogPlay::Instance()->IsOpen())
+  {
+    gzerr << "Lockstep requests are not served during log playback\n";
+    return false;
+  }
+
+  boost::shared_ptr<LockstepCall> call(new LockstepCall);
+  call->request = _request;
+  call->done = false;
+  call->publish = false;
+
+  boost::mutex::scoped_lock lock(this->dataPtr->lockstepMutex);
+
+  // The simulation thread serves the requests, so it would wait forever
+  // for its own. This is the case of plugins and world update callbacks.
+  if (boost::this_thread::get_id() == this->dataPtr->loopThreadId)
+  {
+    gzerr << "World::Lockstep must not be called from the simulation "
+          << "thread of world[" << this->GetName() << "]\n";
+    return false;
+  }
+
+  this->dataPtr->lockstepCalls.push_back(call);
+
+  // Wake up periodically, in case the world stopped.
+  while (!call->done && this->GetRunning())
+  {
+    this->dataPtr->lockstepCondition.timed_wait(lock,
+        boost::posix_time::milliseconds(100));
+  }
+
+  if (!call->done)
+  {
+    std::deque<boost::shared_ptr<LockstepCall> >::iterator iter =
+      std::find(this->dataPtr->lockstepCalls.begin(),
+          this->dataPtr->lockstepCalls.end(), call);
+    if (iter != this->dataPtr->lockstepCalls.end())
+      this->dataPtr->lockstepCalls.erase(iter);
+    return false;
+  }
+
+  _observation.Swap(&call->observation);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void World::ProcessLockstep(bool _stepped)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->lockstepMutex);
+
+  if (this->dataPtr->lockstepActive && _stepped &&
+      this->dataPtr->lockstepSteps > 0)
+  {
+    this->dataPtr->lockstepSteps--;
+  }
+
+  while (true)
+  {
+    if (this->dataPtr->lockstepActive)
+    {
+      if (this->dataPtr->lockstepSteps > 0)
+        return;
+
+      boost::shared_ptr<LockstepCall> call = this->dataPtr->lockstepActive;
+      this->dataPtr->lockstepActive.reset();
+
+      this->FillLockstepObservation(call->request, call->observation);
+      call->done = true;
+      if (call->publish)
+        this->dataPtr->lockstepPub->Publish(call->observation);
+      else
+        this->dataPtr->lockstepCondition.notify_all();
+    }
+
+    if (this->dataPtr->lockstepCalls.empty())
+      return;
+
+    this->dataPtr->lockstepActive = this->dataPtr->lockstepCalls.front();
+    this->dataPtr->lockstepCalls.pop_front();
+
+    const msgs::LockstepRequest &request =
+      this->dataPtr->lockstepActive->request;
+    for (int i = 0; i < request.joint_cmd_size(); ++i)
+    {
+      const msgs::JointCmd &cmd = request.joint_cmd(i);
+      JointPtr joint = boost::dynamic_pointer_cast<Joint>(
+          this->GetByName(cmd.name()));
+      ModelPtr model;
+      if (joint)
+        model = boost::dynamic_pointer_cast<Model>(joint->Base::GetParent());
+
+      // The joint controller only knows joints by their scoped name,
+      // while the request may use any name the world resolves.
+      if (model)
+      {
+        msgs::JointCmd scopedCmd(cmd);
+        scopedCmd.set_name(joint->GetScopedName());
+        model->GetJointController()->ApplyJointCmd(scopedCmd);
+      }
+      else
+        gzerr << "Unable to find joint[" << cmd.name() << "]\n";
+    }
+
+    // A paused world takes the requested steps. The request is done
+    // immediately when no steps are requested.
+    this->dataPtr->lockstepSteps = request.steps();
+    if (this->IsPaused())
+    {
+      this->dataPtr->stepInc = std::max(this->dataPtr->stepInc,
+          static_cast<int>(request.steps()));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void World::FillLockstepObservation(const msgs::LockstepRequest &_request,
+    msgs::LockstepObservation &_observation)
+{
+  _observation.set_id(_request.id());
+  msgs::Set(_observation.mutable_time(), this->dataPtr->simTime);
+  _observation.set_iterations(this->dataPtr->iterations);
+
+  for (int i = 0; i < _request.link_size(); ++i)
+  {
+    LinkPtr link = boost::dynamic_pointer_cast<Link>(
+        this->GetByName(_request.link(i)));
+    if (!link)
+    {
+      _observation.add_missing(_request.link(i));
+      continue;
+    }
+
+    msgs::Pose *pose = _observation.add_link_pose();
+    msgs::Set(pose, link->GetWorldPose().Ign());
+    pose->set_name(link->GetScopedName());
+    pose->set_id(link->GetId());
+  }
+
+  for (int i = 0; i < _request.joint_size(); ++i)
+  {
+    JointPtr joint = boost::dynamic_pointer_cast<Joint>(
+        this->GetByName(_request.joint(i)));
+    if (!joint)
+    {
+      _observation.add_missing(_request.joint(i));
+      continue;
+    }
+
+    msgs::Joint *jointMsg = _observation.add_joint();
+    jointMsg->set_name(joint->GetScopedName());
+    jointMsg->set_id(joint->GetId());
+    for (unsigned int j = 0; j < joint->GetAngleCount(); ++j)
+      jointMsg->add_angle(joint->GetAngle(j).Radian());
+
+    // msgs::Joint holds a single velocity, so only the first axis' is
+    // reported.
+    if (joint->GetAngleCount() > 0)
+      jointMsg->set_velocity(joint->GetVelocity(0));
+  }
+
+  for (int i = 0; i < _request.sensor_size(); ++i)
+  {
+    sensors::SensorPtr sensor =
+      sensors::SensorManager::Instance()->GetSensor(_request.sensor(i));
+    msgs::SensorReading reading;
+    if (sensor && sensor->FillReadingMsg(reading))
+      _observation.add_sensor()->Swap(&reading);
+    else
+      _observation.add_missing(_request.sensor(i));
+  }
+}
+
 //////////////////////////////////////////////////
 void World::BuildSceneMsg(msgs::Scene &_scene, BasePtr _entity)
 {
@@ -1465,13 +1903,11 @@ void World::ProcessEntityMsgs()
 {
   boost::mutex::scoped_lock lock(this->dataPtr->entityDeleteMutex);
 
-  for (auto &entityName : this->dataPtr->deleteEntity)
-  {
-    this->RemoveModel(entityName);
-  }
-
   if (!this->dataPtr->deleteEntity.empty())
   {
+    this->RemoveModels(std::vector<std::string>(
+          this->dataPtr->deleteEntity.begin(),
+          this->dataPtr->deleteEntity.end()));
     this->EnableAllModels();
     this->dataPtr->deleteEntity.clear();
   }
@@ -1510,6 +1946,16 @@ void World::ProcessRequestMsgs()
       std::string *serializedData = response.mutable_serialized_data();
       modelVMsg.SerializeToString(serializedData);
     }
+    else if (requestMsg.request() == "pose_stream_thresholds")
+    {
+      double linear = 0;
+      double angular = 0;
+      std::istringstream stream(requestMsg.data());
+      if (stream >> linear >> angular)
+        this->SetPoseStreamThresholds(linear, angular);
+      else
+        response.set_response("invalid thresholds");
+    }
     else if (requestMsg.request() == "entity_delete")
     {
       boost::mutex::scoped_lock lock2(this->dataPtr->entityDeleteMutex);
@@ -1669,17 +2115,23 @@ void World::ProcessModelMsgs()
 void World::ProcessFactoryMsgs()
 {
   std::list<sdf::ElementPtr> modelsToLoad;
+  std::vector<std::string> modelsToDelete;
 
   {
     boost::recursive_mutex::scoped_lock lock(*this->dataPtr->receiveMutex);
+    modelsToDelete.swap(this->dataPtr->factoryDeletes);
+
     for (auto const &factoryMsg : this->dataPtr->factoryMsgs)
     {
-      this->dataPtr->factorySDF->Root()->ClearElements();
+      // Root of the parsed SDF. Parsed strings and files are cached, and
+      // must not be modified.
+      sdf::ElementPtr root;
 
       if (factoryMsg.has_sdf() && !factoryMsg.sdf().empty())
       {
-        // SDF Parsing happens here
-        if (!sdf::readString(factoryMsg.sdf(), this->dataPtr->factorySDF))
+        // SDF Parsing happens here, unless the string is cached
+        root = this->dataPtr->prototypeCache->FromString(factoryMsg.sdf());
+        if (!root)
         {
           gzerr << "Unable to read sdf string[" << factoryMsg.sdf() << "]\n";
           continue;
@@ -1691,7 +2143,8 @@ void World::ProcessFactoryMsgs()
         std::string filename = common::ModelDatabase::Instance()->GetModelFile(
             factoryMsg.sdf_filename());
 
-        if (!sdf::readFile(filename, this->dataPtr->factorySDF))
+        root = this->dataPtr->prototypeCache->FromFile(filename);
+        if (!root)
         {
           gzerr << "Unable to read sdf file.\n";
           continue;
@@ -1707,6 +2160,7 @@ void World::ProcessFactoryMsgs()
           continue;
         }
 
+        this->dataPtr->factorySDF->Root()->ClearElements();
         this->dataPtr->factorySDF->Root()->InsertElement(
             model->GetSDF()->Clone());
 
@@ -1721,6 +2175,7 @@ void World::ProcessFactoryMsgs()
 
         this->dataPtr->factorySDF->Root()->GetElement("model")->GetAttribute(
             "name")->Set(newName);
+        root = this->dataPtr->factorySDF->Root();
       }
       else
       {
@@ -1736,10 +2191,10 @@ void World::ProcessFactoryMsgs()
         if (base)
         {
           sdf::ElementPtr elem;
-          if (this->dataPtr->factorySDF->Root()->GetName() == "sdf")
-            elem = this->dataPtr->factorySDF->Root()->GetFirstElement();
+          if (root->GetName() == "sdf")
+            elem = root->GetFirstElement();
           else
-            elem = this->dataPtr->factorySDF->Root();
+            elem = root;
 
           base->UpdateParameters(elem);
         }
@@ -1750,7 +2205,7 @@ void World::ProcessFactoryMsgs()
         bool isModel = false;
         bool isLight = false;
 
-        sdf::ElementPtr elem = this->dataPtr->factorySDF->Root()->Clone();
+        sdf::ElementPtr elem = root->Clone();
 
         if (elem->HasElement("world"))
           elem = elem->GetElement("world");
@@ -1773,17 +2228,34 @@ void World::ProcessFactoryMsgs()
         else
         {
           gzerr << "Unable to find a model, light, or actor in:\n";
-          this->dataPtr->factorySDF->Root()->PrintValues("");
+          root->PrintValues("");
           continue;
         }
 
         if (!elem)
         {
           gzerr << "Invalid SDF:";
-          this->dataPtr->factorySDF->Root()->PrintValues("");
+          root->PrintValues("");
           continue;
         }
 
+        // Overrides apply to the clone, never to the cached prototype.
+        if (factoryMsg.has_name())
+          elem->GetAttribute("name")->Set(factoryMsg.name());
+
+        bool overridden = true;
+        for (auto const &param : factoryMsg.param())
+        {
+          if (!PrototypeCache::Override(elem, param.path(), param.value()))
+          {
+            gzerr << "Unable to set [" << param.path() << "] to ["
+                  << param.value() << "]\n";
+            overridden = false;
+          }
+        }
+        if (!overridden)
+          continue;
+
         elem->SetParent(this->dataPtr->sdf);
         elem->GetParent()->InsertElement(elem);
         if (factoryMsg.has_pose())
@@ -1814,21 +2286,35 @@ void World::ProcessFactoryMsgs()
     this->dataPtr->factoryMsgs.clear();
   }
 
-  for (auto const &elem : modelsToLoad)
+  // Models deleted by a batch are removed before the batch's models are
+  // loaded, which may reuse their names.
+  if (!modelsToDelete.empty())
+    this->RemoveModels(modelsToDelete);
+
+  if (!modelsToLoad.empty())
   {
-    try
-    {
-      boost::mutex::scoped_lock lock(this->dataPtr->factoryDeleteMutex);
+    boost::mutex::scoped_lock lock(this->dataPtr->factoryDeleteMutex);
 
-      ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
-      model->Init();
-      model->LoadPlugins();
-    }
-    catch(...)
+    // Enable the models once, after the whole batch is loaded.
+    this->dataPtr->enableOnLoad = false;
+    for (auto const &elem : modelsToLoad)
     {
-      gzerr << "Loading model from factory message failed\n";
+      try
+      {
+        ModelPtr model = this->LoadModel(elem, this->dataPtr->rootElement);
+        model->Init();
+        model->LoadPlugins();
+      }
+      catch(...)
+      {
+        gzerr << "Loading model from factory message failed\n";
+      }
     }
+    this->dataPtr->enableOnLoad = true;
   }
+
+  if (!modelsToDelete.empty() || !modelsToLoad.empty())
+    this->EnableAllModels();
 }
 
 //////////////////////////////////////////////////
@@ -1855,12 +2341,154 @@ EntityPtr World::GetEntityBelowPoint(const math::Vector3 &_pt)
   end = _pt;
   end.z -= 1000;
 
+  // Skip the ray cast if no model overlaps the column below the point.
+  if (this->GetModelsInBox(ignition::math::Box(end.Ign(), _pt.Ign())).empty())
+    return EntityPtr();
+
   this->dataPtr->physicsEngine->InitForThread();
   this->dataPtr->testRay->SetPoints(_pt, end);
   this->dataPtr->testRay->GetIntersection(dist, entityName);
   return this->GetEntity(entityName);
 }
 
+//////////////////////////////////////////////////
+static ignition::math::Box spatialBox(const ModelPtr &_model)
+{
+  // Include the origins of the model and its links, so that models without
+  // collisions still have a box.
+  ignition::math::Vector3d pos = _model->GetWorldPose().pos.Ign();
+  ignition::math::Vector3d min = pos;
+  ignition::math::Vector3d max = pos;
+
+  for (auto const &link : _model->GetLinks())
+  {
+    pos = link->GetWorldPose().pos.Ign();
+    min.Min(pos);
+    max.Max(pos);
+  }
+
+  // Model::GetBoundingBox returns an inverted box when there are no
+  // collisions.
+  math::Box box = _model->GetBoundingBox();
+  if (box.min.x <= box.max.x)
+  {
+    min.Min(box.min.Ign());
+    max.Max(box.max.Ign());
+  }
+
+  // Planes have infinite boxes, which would make the tree's surface area
+  // cost meaningless.
+  const double limit = 1e9;
+  min.Max(ignition::math::Vector3d(-limit, -limit, -limit));
+  max.Min(ignition::math::Vector3d(limit, limit, limit));
+
+  return ignition::math::Box(min, max);
+}
+
+//////////////////////////////////////////////////
+void World::UpdateSpatialIndex()
+{
+  // Build the index on first use, after which only moved models are
+  // refreshed.
+  if (!this->dataPtr->spatialEnabled)
+  {
+    this->dataPtr->spatialDirty.insert(this->dataPtr->models.begin(),
+        this->dataPtr->models.end());
+    this->dataPtr->spatialEnabled = true;
+  }
+
+  for (auto const &model : this->dataPtr->spatialDirty)
+  {
+    if (!model)
+      continue;
+
+    ignition::math::Box box = spatialBox(model);
+    auto iter = this->dataPtr->spatialProxies.find(model->GetId());
+    if (iter != this->dataPtr->spatialProxies.end())
+      this->dataPtr->spatialTree.Update(iter->second.proxy, box);
+    else
+    {
+      SpatialProxy proxy;
+      proxy.proxy = this->dataPtr->spatialTree.Insert(box, model->GetId());
+      proxy.model = model;
+      this->dataPtr->spatialProxies[model->GetId()] = proxy;
+    }
+  }
+  this->dataPtr->spatialDirty.clear();
+}
+
+//////////////////////////////////////////////////
+Model_V World::GetModelsFromIds(const std::vector<uint32_t> &_ids) const
+{
+  Model_V models;
+  models.reserve(_ids.size());
+  for (auto const &id : _ids)
+  {
+    auto iter = this->dataPtr->spatialProxies.find(id);
+    if (iter != this->dataPtr->spatialProxies.end())
+      models.push_back(iter->second.model);
+  }
+  return models;
+}
+
+//////////////////////////////////////////////////
+Model_V World::GetModelsInBox(const ignition::math::Box &_box)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->spatialMutex);
+  this->UpdateSpatialIndex();
+
+  std::vector<uint32_t> ids;
+  this->dataPtr->spatialTree.QueryBox(_box, ids);
+  return this->GetModelsFromIds(ids);
+}
+
+//////////////////////////////////////////////////
+Model_V World::GetModelsInSphere(const ignition::math::Vector3d &_center,
+    double _radius)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->spatialMutex);
+  this->UpdateSpatialIndex();
+
+  std::vector<uint32_t> ids;
+  this->dataPtr->spatialTree.QuerySphere(_center, _radius, ids);
+  return this->GetModelsFromIds(ids);
+}
+
+//////////////////////////////////////////////////
+Model_V World::GetModelsInFrustum(const ignition::math::Frustum &_frustum)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->spatialMutex);
+  this->UpdateSpatialIndex();
+
+  std::vector<uint32_t> ids;
+  this->dataPtr->spatialTree.QueryFrustum(_frustum, ids);
+  return this->GetModelsFromIds(ids);
+}
+
+//////////////////////////////////////////////////
+ModelPtr World::GetNearestModel(const ignition::math::Vector3d &_point,
+    ModelPtr _exclude)
+{
+  boost::mutex::scoped_lock lock(this->dataPtr->spatialMutex);
+  this->UpdateSpatialIndex();
+
+  // No entity has the largest id, so excluding it excludes nothing.
+  uint32_t exclude = _exclude ? _exclude->GetId() :
+    std::numeric_limits<uint32_t>::max();
+
+  uint32_t id;
+  double distance;
+  if (!this->dataPtr->spatialTree.QueryNearest(_point, exclude, id,
+        distance))
+  {
+    return ModelPtr();
+  }
+
+  auto iter = this->dataPtr->spatialProxies.find(id);
+  return iter != this->dataPtr->spatialProxies.end() ?
+    iter->second.model : ModelPtr();
+}
+
 //////////////////////////////////////////////////
 void World::SetState(const WorldState &_state)
 {
@@ -1879,6 +2507,151 @@ void World::SetState(const WorldState &_state)
   }
 }
 
+//////////////////////////////////////////////////
+void World::SaveSnapshot(WorldSnapshot &_snapshot)
+{
+  boost::recursive_mutex::scoped_lock lock(
+      *this->dataPtr->worldUpdateMutex);
+
+  _snapshot.Clear();
+  _snapshot.Write(snapshotVersion);
+  _snapshot.Write(this->dataPtr->simTime.sec);
+  _snapshot.Write(this->dataPtr->simTime.nsec);
+  _snapshot.Write(this->dataPtr->iterations);
+
+  // The names of the entities, checked on restore.
+  _snapshot.Write(static_cast<uint32_t>(this->dataPtr->models.size()));
+  for (auto const &model : this->dataPtr->models)
+  {
+    _snapshot.Write(model->GetName());
+
+    const Link_V &links = model->GetLinks();
+    _snapshot.Write(static_cast<uint32_t>(links.size()));
+    for (auto const &link : links)
+      _snapshot.Write(link->GetName());
+
+    const Joint_V &joints = model->GetJoints();
+    _snapshot.Write(static_cast<uint32_t>(joints.size()));
+    for (auto const &joint : joints)
+      _snapshot.Write(joint->GetName());
+  }
+
+  this->dataPtr->physicsEngine->SaveSnapshot(_snapshot);
+  for (auto const &model : this->dataPtr->models)
+  {
+    for (auto const &link : model->GetLinks())
+      link->SaveSnapshot(_snapshot);
+    for (auto const &joint : model->GetJoints())
+      joint->SaveSnapshot(_snapshot);
+  }
+}
+
+//////////////////////////////////////////////////
+bool World::RestoreSnapshot(const WorldSnapshot &_snapshot)
+{
+  boost::recursive_mutex::scoped_lock lock(
+      *this->dataPtr->worldUpdateMutex);
+
+  size_t offset = 0;
+  uint32_t version;
+  if (!_snapshot.Read(offset, version) || version != snapshotVersion)
+  {
+    gzerr << "Unsupported snapshot version\n";
+    return false;
+  }
+
+  common::Time simTime;
+  uint64_t iterations;
+  if (!_snapshot.Read(offset, simTime.sec) ||
+      !_snapshot.Read(offset, simTime.nsec) ||
+      !_snapshot.Read(offset, iterations))
+  {
+    gzerr << "Snapshot is truncated\n";
+    return false;
+  }
+
+  // Nothing is changed unless the world has the entities the snapshot
+  // was saved from.
+  if (!snapshotMatches(this->dataPtr->models, _snapshot, offset))
+  {
+    gzerr << "Snapshot does not match the entities of world["
+          << this->GetName() << "]\n";
+    return false;
+  }
+
+  boost::recursive_mutex::scoped_lock physicsLock(
+      *this->dataPtr->physicsEngine->GetPhysicsUpdateMutex());
+
+  bool result = this->dataPtr->physicsEngine->RestoreSnapshot(
+      _snapshot, offset);
+  for (auto const &model : this->dataPtr->models)
+  {
+    for (auto const &link : model->GetLinks())
+      result = result && link->RestoreSnapshot(_snapshot, offset);
+    for (auto const &joint : model->GetJoints())
+      result = result && joint->RestoreSnapshot(_snapshot, offset);
+  }
+
+  // Physics engines report the restored poses as dirty, as they do
+  // after an update.
+  for (auto &dirtyEntity : this->dataPtr->dirtyPoses)
+    dirtyEntity->SetWorldPose(dirtyEntity->GetDirtyPose(), false);
+  this->dataPtr->dirtyPoses.clear();
+
+  if (!result)
+  {
+    gzerr << "Snapshot is truncated\n";
+    return false;
+  }
+
+  this->dataPtr->simTime = simTime;
+  this->dataPtr->iterations = iterations;
+  return true;
+}
+
+//////////////////////////////////////////////////
+WorldPtr World::Clone(const std::string &_name, uint32_t _seed)
+{
+  if (has_world(_name))
+  {
+    gzerr << "Unable to clone world[" << this->GetName()
+          << "], a world named [" << _name << "] already exists\n";
+    return WorldPtr();
+  }
+
+  // The description and the state are taken between two steps, so that
+  // they agree with each other.
+  sdf::ElementPtr worldSDF;
+  WorldSnapshot snapshot;
+  {
+    boost::recursive_mutex::scoped_lock lock(
+        *this->dataPtr->worldUpdateMutex);
+    worldSDF = this->dataPtr->sdf->Clone();
+    this->SaveSnapshot(snapshot);
+  }
+  worldSDF->GetAttribute("name")->Set(_name);
+
+  // The description is already parsed, and meshes are shared through the
+  // mesh manager, so only the entities are built.
+  WorldPtr world = create_world(_name);
+  load_world(world, worldSDF);
+  init_world(world);
+
+  if (!world->RestoreSnapshot(snapshot))
+  {
+    gzerr << "Unable to clone world[" << this->GetName()
+          << "], its models changed while it was copied\n";
+    remove_world(_name);
+    return WorldPtr();
+  }
+
+  world->GetPhysicsEngine()->SetSeed(_seed);
+  world->SetPaused(this->IsPaused());
+  run_world(world);
+
+  return world;
+}
+
 //////////////////////////////////////////////////
 void World::InsertModelFile(const std::string &_sdfFilename)
 {
@@ -1906,6 +2679,16 @@ void World::InsertModelString(const std::string &_sdfString)
   this->dataPtr->factoryMsgs.push_back(msg);
 }
 
+//////////////////////////////////////////////////
+void World::ApplyFactoryBatch(const msgs::FactoryBatch &_batch)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->dataPtr->receiveMutex);
+  this->dataPtr->factoryDeletes.insert(this->dataPtr->factoryDeletes.end(),
+      _batch.delete_name().begin(), _batch.delete_name().end());
+  this->dataPtr->factoryMsgs.insert(this->dataPtr->factoryMsgs.end(),
+      _batch.factory().begin(), _batch.factory().end());
+}
+
 //////////////////////////////////////////////////
 std::string World::StripWorldName(const std::string &_name) const
 {
@@ -2010,6 +2793,113 @@ bool World::OnLog(std::ostringstream &_stream)
   return true;
 }
 
+//////////////////////////////////////////////////
+/// \brief Add the pose of an entity to a compact pose message, unless it
+/// moved less than the thresholds since it was last published.
+/// \param[in,out] _data World data holding the published poses.
+/// \param[in] _entity The entity.
+/// \param[in] _full True to add the pose even if it did not move.
+/// \param[out] _msg The message.
+static void packPose(WorldPrivate &_data, const EntityPtr &_entity,
+    bool _full, msgs::PosesPacked &_msg)
+{
+  uint32_t id = _entity->GetId();
+  ignition::math::Pose3d pose = _entity->GetRelativePose().Ign();
+
+  auto last = _data.packedPoses.find(id);
+  if (last == _data.packedPoses.end())
+  {
+    _data.poseNames[id] = _entity->GetScopedName();
+    _data.poseNamesDirty = true;
+    last = _data.packedPoses.insert(std::make_pair(id, pose)).first;
+  }
+  else if (!_full)
+  {
+    const ignition::math::Quaterniond &q0 = last->second.Rot();
+    const ignition::math::Quaterniond &q1 = pose.Rot();
+    double dot = std::min(1.0, std::abs(q0.W()*q1.W() + q0.X()*q1.X() +
+          q0.Y()*q1.Y() + q0.Z()*q1.Z()));
+
+    if (last->second.Pos().Distance(pose.Pos()) <=
+        _data.poseLinearThreshold &&
+        2.0 * acos(dot) <= _data.poseAngularThreshold)
+    {
+      return;
+    }
+  }
+  last->second = pose;
+
+  _msg.add_id(id);
+  _msg.add_pose(pose.Pos().X());
+  _msg.add_pose(pose.Pos().Y());
+  _msg.add_pose(pose.Pos().Z());
+  _msg.add_pose(pose.Rot().W());
+  _msg.add_pose(pose.Rot().X());
+  _msg.add_pose(pose.Rot().Y());
+  _msg.add_pose(pose.Rot().Z());
+}
+
+//////////////////////////////////////////////////
+void World::PublishPackedPoses()
+{
+  common::Time wallTime = common::Time::GetWallTime();
+  if (wallTime - this->dataPtr->prevPackedTime < common::Time(0, 16666667))
+    return;
+  this->dataPtr->prevPackedTime = wallTime;
+
+  // All poses are published once per second, for new subscribers and for
+  // entities that stopped within the thresholds of their last pose.
+  bool full = wallTime - this->dataPtr->prevPackedFullTime >= common::Time(1);
+  if (full)
+    this->dataPtr->prevPackedFullTime = wallTime;
+
+  msgs::PosesPacked msg;
+  msgs::Set(msg.mutable_time(), this->GetSimTime());
+  msg.set_full(full);
+
+  Model_V models;
+  if (full)
+    models = this->dataPtr->models;
+  else
+  {
+    models.assign(this->dataPtr->packedModelPoses.begin(),
+        this->dataPtr->packedModelPoses.end());
+  }
+  for (auto const &model : models)
+  {
+    packPose(*this->dataPtr, model, full, msg);
+    for (auto const &link : model->GetLinks())
+      packPose(*this->dataPtr, link, full, msg);
+  }
+  this->dataPtr->packedModelPoses.clear();
+
+  // The name table goes out before the poses that use it.
+  if (this->dataPtr->poseNamesDirty)
+  {
+    msgs::PoseNames namesMsg;
+    namesMsg.set_version(++this->dataPtr->poseNamesVersion);
+    for (auto const &name : this->dataPtr->poseNames)
+    {
+      namesMsg.add_id(name.first);
+      namesMsg.add_name(name.second);
+    }
+    this->dataPtr->poseNamesPub->Publish(namesMsg);
+    this->dataPtr->poseNamesDirty = false;
+  }
+
+  msg.set_names_version(this->dataPtr->poseNamesVersion);
+  if (full || msg.id_size() > 0)
+    this->dataPtr->posePackedPub->Publish(msg);
+}
+
+//////////////////////////////////////////////////
+void World::SetPoseStreamThresholds(double _linear, double _angular)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->dataPtr->receiveMutex);
+  this->dataPtr->poseLinearThreshold = std::max(0.0, _linear);
+  this->dataPtr->poseAngularThreshold = std::max(0.0, _angular);
+}
+
 //////////////////////////////////////////////////
 void World::ProcessMessages()
 {
@@ -2059,6 +2949,16 @@ void World::ProcessMessages()
         this->dataPtr->poseLocalPub->Publish(msg);
       }
     }
+
+    if (this->dataPtr->posePackedPub &&
+        this->dataPtr->posePackedPub->HasConnections())
+    {
+      this->dataPtr->packedModelPoses.insert(
+          this->dataPtr->publishModelPoses.begin(),
+          this->dataPtr->publishModelPoses.end());
+      this->PublishPackedPoses();
+    }
+
     this->dataPtr->publishModelPoses.clear();
   }
 
@@ -2118,6 +3018,12 @@ void World::PublishModelPose(physics::ModelPtr _model)
 
   // Only add if the model name is not in the list
   this->dataPtr->publishModelPoses.insert(_model);
+
+  if (this->dataPtr->spatialEnabled)
+  {
+    boost::mutex::scoped_lock spatialLock(this->dataPtr->spatialMutex);
+    this->dataPtr->spatialDirty.insert(_model);
+  }
 }
 
 //////////////////////////////////////////////////
@@ -2176,44 +3082,77 @@ uint32_t World::GetIterations() const
 //////////////////////////////////////////////////
 void World::RemoveModel(const std::string &_name)
 {
+  this->RemoveModels(std::vector<std::string>(1, _name));
+}
+
+//////////////////////////////////////////////////
+void World::RemoveModels(const std::vector<std::string> &_names)
+{
+  if (_names.empty())
+    return;
+
+  std::set<std::string> names(_names.begin(), _names.end());
+
   boost::mutex::scoped_lock flock(this->dataPtr->factoryDeleteMutex);
 
-  // Remove all the dirty poses from the delete entity.
+  // Resolve the top level entities to remove, so that the lists below
+  // are filtered by pointer instead of by name.
+  boost::shared_ptr<Base_V> reclaimed(new Base_V);
+  Base_V entities;
+  std::set<const Base *> removed;
+  for (auto const &name : names)
+  {
+    BasePtr entity = this->dataPtr->entityRegistry->GetByName(name,
+        this->dataPtr->rootElement.get());
+    if (entity && entity->GetParent() == this->dataPtr->rootElement &&
+        removed.insert(entity.get()).second)
+    {
+      entities.push_back(entity);
+    }
+  }
+
+  // Remove all the dirty poses from the delete entities.
+  for (auto entity = this->dataPtr->dirtyPoses.begin();
+       entity != this->dataPtr->dirtyPoses.end();)
   {
-    for (auto entity = this->dataPtr->dirtyPoses.begin();
-             entity != this->dataPtr->dirtyPoses.end(); ++entity)
+    if (removed.count(*entity) ||
+        ((*entity)->GetParent() &&
+         removed.count((*entity)->GetParent().get())))
     {
-      if ((*entity)->GetName() == _name ||
-         ((*entity)->GetParent() && (*entity)->GetParent()->GetName() == _name))
-      {
-        this->dataPtr->dirtyPoses.erase(entity++);
-      }
-      else
-        ++entity;
+      entity = this->dataPtr->dirtyPoses.erase(entity);
     }
+    else
+      ++entity;
   }
 
+  // Remove the first model or light element of each name from the SDF.
+  std::set<std::string> sdfModels = names;
+  sdf::ElementPtr childElem;
   if (this->dataPtr->sdf->HasElement("model"))
+    childElem = this->dataPtr->sdf->GetElement("model");
+  while (childElem && !sdfModels.empty())
   {
-    sdf::ElementPtr childElem = this->dataPtr->sdf->GetElement("model");
-    while (childElem && childElem->Get<std::string>("name") != _name)
-      childElem = childElem->GetNextElement("model");
-    if (childElem)
+    sdf::ElementPtr next = childElem->GetNextElement("model");
+    if (sdfModels.erase(childElem->Get<std::string>("name")))
       this->dataPtr->sdf->RemoveChild(childElem);
+    childElem = next;
   }
 
+  std::set<std::string> sdfLights = names;
+  childElem.reset();
   if (this->dataPtr->sdf->HasElement("light"))
+    childElem = this->dataPtr->sdf->GetElement("light");
+  while (childElem && !sdfLights.empty())
   {
-    sdf::ElementPtr childElem = this->dataPtr->sdf->GetElement("light");
-    while (childElem && childElem->Get<std::string>("name") != _name)
-      childElem = childElem->GetNextElement("light");
-    if (childElem)
+    sdf::ElementPtr next = childElem->GetNextElement("light");
+    std::string lightName = childElem->Get<std::string>("name");
+    if (sdfLights.erase(lightName))
     {
       this->dataPtr->sdf->RemoveChild(childElem);
       // Find the light by name in the scene msg, and remove it.
       for (int i = 0; i < this->dataPtr->sceneMsg.light_size(); ++i)
       {
-        if (this->dataPtr->sceneMsg.light(i).name() == _name)
+        if (this->dataPtr->sceneMsg.light(i).name() == lightName)
         {
           this->dataPtr->sceneMsg.mutable_light()->SwapElements(i,
               this->dataPtr->sceneMsg.light_size()-1);
@@ -2222,38 +3161,67 @@ void World::RemoveModel(const std::string &_name)
         }
       }
     }
+    childElem = next;
   }
 
   {
     boost::recursive_mutex::scoped_lock lock(
         *this->GetPhysicsEngine()->GetPhysicsUpdateMutex());
 
-    this->dataPtr->rootElement->RemoveChild(_name);
+    // Fini releases the physics engine objects now. The rest of the
+    // destruction is left to the teardown thread, so the entities are
+    // kept until they are handed over.
+    for (auto const &entity : entities)
+    {
+      collectEntities(entity, *reclaimed);
+      this->dataPtr->rootElement->RemoveChild(entity->GetId());
+    }
 
-    for (auto model = this->dataPtr->models.begin();
-             model != this->dataPtr->models.end(); ++model)
+    Model_V kept;
+    kept.reserve(this->dataPtr->models.size());
+    for (auto &model : this->dataPtr->models)
     {
-      if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
+      if (!removed.count(model.get()))
       {
-        this->dataPtr->models.erase(model);
-        break;
+        kept.push_back(model);
+        continue;
+      }
+
+      // Drop the model from the spatial index.
+      boost::mutex::scoped_lock spatialLock(this->dataPtr->spatialMutex);
+      auto proxy = this->dataPtr->spatialProxies.find(model->GetId());
+      if (proxy != this->dataPtr->spatialProxies.end())
+      {
+        this->dataPtr->spatialTree.Remove(proxy->second.proxy);
+        this->dataPtr->spatialProxies.erase(proxy);
       }
+      this->dataPtr->spatialDirty.erase(model);
     }
+    this->dataPtr->models.swap(kept);
   }
 
   // Cleanup the publishModelPoses list.
   {
     boost::recursive_mutex::scoped_lock lock2(*this->dataPtr->receiveMutex);
-    for (auto model = this->dataPtr->publishModelPoses.begin();
-             model != this->dataPtr->publishModelPoses.end(); ++model)
+    for (auto const &entity : entities)
     {
-      if ((*model)->GetName() == _name || (*model)->GetScopedName() == _name)
-      {
-        this->dataPtr->publishModelPoses.erase(model);
-        break;
-      }
+      this->dataPtr->publishModelPoses.erase(
+          boost::dynamic_pointer_cast<Model>(entity));
+      this->dataPtr->packedModelPoses.erase(
+          boost::dynamic_pointer_cast<Model>(entity));
+    }
+
+    // Drop the removed entities from the compact pose name table.
+    for (auto const &entity : *reclaimed)
+    {
+      this->dataPtr->packedPoses.erase(entity->GetId());
+      if (this->dataPtr->poseNames.erase(entity->GetId()))
+        this->dataPtr->poseNamesDirty = true;
     }
   }
+
+  entities.clear();
+  this->dataPtr->teardownQueue->Push(reclaimed);
 }
 
 /////////////////////////////////////////////////
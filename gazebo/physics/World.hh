@@ -34,6 +34,10 @@
 
 #include <sdf/sdf.hh>
 
+#include <ignition/math/Box.hh>
+#include <ignition/math/Frustum.hh>
+#include <ignition/math/Vector3.hh>
+
 #include "gazebo/transport/TransportTypes.hh"
 
 #include "gazebo/msgs/msgs.hh"
@@ -126,6 +130,15 @@ namespace gazebo
       /// \return Pointer to the preset manager.
       public: PresetManagerPtr GetPresetManager() const;
 
+      /// \brief Return the index of the world's entities by id and name.
+      /// \return Pointer to the entity registry.
+      public: EntityRegistryPtr GetEntityRegistry() const;
+
+      /// \brief Return the queue that destroys removed models on a
+      /// background thread.
+      /// \return Pointer to the teardown queue.
+      public: TeardownQueuePtr GetTeardownQueue() const;
+
       /// \brief Return the spherical coordinates converter.
       /// \return Pointer to the spherical coordinates converter.
       public: common::SphericalCoordinatesPtr GetSphericalCoordinates() const;
@@ -227,10 +240,70 @@ namespace gazebo
       /// \return A pointer to nearest Entity, NULL if none is found.
       public: EntityPtr GetEntityBelowPoint(const math::Vector3 &_pt);
 
+      /// \brief Get the models whose bounding box intersects a box.
+      /// The models are found with a bounding volume tree, so the cost
+      /// grows with the number of models found rather than the number of
+      /// models in the world.
+      /// \param[in] _box Box in world coordinates.
+      /// \return The intersecting models.
+      public: Model_V GetModelsInBox(const ignition::math::Box &_box);
+
+      /// \brief Get the models whose bounding box intersects a sphere.
+      /// \param[in] _center Center of the sphere in world coordinates.
+      /// \param[in] _radius Radius of the sphere.
+      /// \return The intersecting models.
+      public: Model_V GetModelsInSphere(
+                  const ignition::math::Vector3d &_center, double _radius);
+
+      /// \brief Get the models whose bounding box is in a frustum.
+      /// \param[in] _frustum Frustum in world coordinates.
+      /// \return The models in the frustum.
+      public: Model_V GetModelsInFrustum(
+                  const ignition::math::Frustum &_frustum);
+
+      /// \brief Get the model whose bounding box is nearest to a point.
+      /// \param[in] _point Point in world coordinates.
+      /// \param[in] _exclude Model to ignore, such as the model the point
+      /// belongs to.
+      /// \return The nearest model, NULL if there is none.
+      public: ModelPtr GetNearestModel(const ignition::math::Vector3d &_point,
+                  ModelPtr _exclude = ModelPtr());
+
       /// \brief Set the current world state.
       /// \param _state The state to set the World to.
       public: void SetState(const WorldState &_state);
 
+      /// \brief Save the dynamic state of the world and its physics
+      /// engine, such as the poses and velocities of the links and the
+      /// solver state of the joints, into a binary snapshot. Unlike
+      /// WorldState, a snapshot holds the state the way the physics engine
+      /// stores it, so that stepping after a restore gives the same
+      /// results as stepping after the save.
+      /// \param[out] _snapshot Snapshot to fill. Its memory is reused.
+      public: void SaveSnapshot(WorldSnapshot &_snapshot);
+
+      /// \brief Restore the world to the state saved in a snapshot. The
+      /// world must have the same models, links and joints it had when
+      /// the snapshot was saved; models added or removed since then make
+      /// the snapshot invalid.
+      /// \param[in] _snapshot Snapshot filled by SaveSnapshot.
+      /// \return False if the snapshot does not match the world.
+      public: bool RestoreSnapshot(const WorldSnapshot &_snapshot);
+
+      /// \brief Create a copy of this world, in its current state, that
+      /// runs in the same process. The copy has its own name, and so its
+      /// own topics, and diverges from this world from then on. It is
+      /// paused if this world is paused. Use physics::remove_world to
+      /// stop it. This function must not be called from the simulation
+      /// thread.
+      /// \param[in] _name Name of the copy, which must not be in use.
+      /// \param[in] _seed Random number seed of the copy's physics
+      /// engine. The random number generator of ODE is shared by every
+      /// world in the process, so this reseeds every world, not just the
+      /// copy.
+      /// \return The copy, NULL if it could not be created.
+      public: WorldPtr Clone(const std::string &_name, uint32_t _seed);
+
       /// \brief Insert a model from an SDF file.
       /// Spawns a model into the world base on and SDF file.
       /// \param[in] _sdfFilename The name of the SDF file (including path).
@@ -246,6 +319,15 @@ namespace gazebo
       /// \param[in] _sdf A reference to an SDF object.
       public: void InsertModelSDF(const sdf::SDF &_sdf);
 
+      /// \brief Delete and insert many models at once, such as to replace
+      /// a population of robots. The batch is applied in the next world
+      /// update: the deletes first, then the inserts, taking the world's
+      /// locks once for the whole batch and enabling the models once.
+      /// The same batch can be published on ~/factory/batch.
+      /// \param[in] _batch Names of the models to delete, and factory
+      /// messages of the models to insert.
+      public: void ApplyFactoryBatch(const msgs::FactoryBatch &_batch);
+
       /// \brief Return a version of the name with "<world_name>::" removed
       /// \param[in] _name Usually the name of an entity.
       /// \return The stripped world name.
@@ -310,6 +392,21 @@ namespace gazebo
       /// \param[in] _model Pointer to the model to publish.
       public: void PublishModelPose(physics::ModelPtr _model);
 
+      /// \brief Set the change thresholds of the compact pose stream.
+      ///
+      /// Besides ~/pose/info, the world publishes the poses of moving
+      /// models and their links on ~/pose/packed/info as packed arrays,
+      /// identified by id. The names of the ids are published on
+      /// ~/pose/packed/names whenever entities are added or removed, and
+      /// subscribers should latch that topic. Entities that moved less
+      /// than both thresholds since they were last published are skipped,
+      /// and the pose of every entity is published once per second. The
+      /// thresholds may also be set with a "pose_stream_thresholds"
+      /// request whose data holds the two values.
+      /// \param[in] _linear Distance threshold in meters.
+      /// \param[in] _angular Rotation threshold in radians.
+      public: void SetPoseStreamThresholds(double _linear, double _angular);
+
       /// \brief Get the total number of iterations.
       /// \return Number of iterations that simulation has taken.
       public: uint32_t GetIterations() const;
@@ -336,6 +433,36 @@ namespace gazebo
       /// \param[in] _name Name of the model to remove.
       public: void RemoveModel(const std::string &_name);
 
+      /// \brief Remove many models by name. The world's locks are taken
+      /// once for all the models. This function will block until the
+      /// physics engine is not locked.
+      /// \param[in] _names Names of the models to remove.
+      public: void RemoveModels(const std::vector<std::string> &_names);
+
+      /// \brief Apply joint commands, take a number of steps and observe
+      /// the world, in lockstep with the simulation loop.
+      ///
+      /// The joint commands are applied before the first step, and the
+      /// observation is filled right after the last one, so that no step
+      /// is taken between the two that the caller did not ask for. When
+      /// the world is paused, the requested steps are taken; otherwise the
+      /// observation is filled once the world has run that many steps.
+      /// Requests are served in order, and may also be published on
+      /// ~/lockstep/request, in which case the observation is published
+      /// on ~/lockstep/observation with the id of the request. Sensor
+      /// readings are the latest ones produced by the sensors, which may
+      /// be older than the observation. This function blocks. It returns
+      /// false at once when called from the simulation thread, such as
+      /// from a plugin or a world update callback, and during log
+      /// playback, since the request would never be served.
+      /// \param[in] _request Joint commands, steps and entities to observe.
+      /// \param[out] _observation The observation after the last step.
+      /// \return False if the request was not served: the world stopped
+      /// first, or the call came from the simulation thread or during log
+      /// playback.
+      public: bool Lockstep(const msgs::LockstepRequest &_request,
+                            msgs::LockstepObservation &_observation);
+
       /// \internal
       /// \brief Inform the World that an Entity has moved. The Entity
       /// is added to a list that will be processed by the World.
@@ -354,6 +481,18 @@ namespace gazebo
       private: ModelPtr GetModelById(unsigned int _id);
       /// \endcond
 
+      /// \brief Bring the spatial index up to date with the models that
+      /// moved. The index is built on the first call. Must be called with
+      /// the spatial mutex locked.
+      private: void UpdateSpatialIndex();
+
+      /// \brief Get the indexed models with the given ids. Must be called
+      /// with the spatial mutex locked.
+      /// \param[in] _ids Model ids.
+      /// \return The models.
+      private: Model_V GetModelsFromIds(const std::vector<uint32_t> &_ids)
+                   const;
+
       /// \brief Load all plugins.
       ///
       /// Load all plugins specified in the SDF for the model.
@@ -364,6 +503,10 @@ namespace gazebo
       /// \param[in] _parent Parent of the model to load.
       private: void LoadEntities(sdf::ElementPtr _sdf, BasePtr _parent);
 
+      /// \brief Load the meshes of the collisions in the world on a pool
+      /// of threads, before the entities that use them are loaded.
+      private: void LoadMeshes();
+
       /// \brief Load a model.
       /// \param[in] _sdf SDF element containing the Model description.
       /// \param[in] _parent Parent of the model.
@@ -427,10 +570,18 @@ namespace gazebo
       /// \param[in] _data The factory message.
       private: void OnFactoryMsg(ConstFactoryPtr &_data);
 
+      /// \brief Called when a factory batch message is received.
+      /// \param[in] _msg The factory batch message.
+      private: void OnFactoryBatchMsg(ConstFactoryBatchPtr &_msg);
+
       /// \brief Called when a model message is received.
       /// \param[in] _msg The model message.
       private: void OnModelMsg(ConstModelPtr &_msg);
 
+      /// \brief Called when a lockstep request is received.
+      /// \param[in] _msg The lockstep request.
+      private: void OnLockstepRequest(ConstLockstepRequestPtr &_msg);
+
       /// \brief TBB version of model updating.
       private: void ModelUpdateTBB();
 
@@ -468,6 +619,23 @@ namespace gazebo
       /// \brief Process all incoming messages.
       private: void ProcessMessages();
 
+      /// \brief Publish the compact pose stream, and its name table if it
+      /// changed.
+      private: void PublishPackedPoses();
+
+      /// \brief Finish the active lockstep request once its steps are
+      /// taken, and start the next one. Called by the simulation thread
+      /// with the world update mutex held.
+      /// \param[in] _stepped True if the world just took a step.
+      private: void ProcessLockstep(bool _stepped);
+
+      /// \brief Fill the observation of a lockstep request.
+      /// \param[in] _request The request.
+      /// \param[out] _observation The observation to fill.
+      private: void FillLockstepObservation(
+                   const msgs::LockstepRequest &_request,
+                   msgs::LockstepObservation &_observation);
+
       /// \brief Publish the world stats message.
       private: void PublishWorldStats();
 
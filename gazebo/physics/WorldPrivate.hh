@@ -17,11 +17,15 @@
 #ifndef _GAZEBO_WORLD_PRIVATE_HH_
 #define _GAZEBO_WORLD_PRIVATE_HH_
 
+#include <atomic>
 #include <deque>
 #include <vector>
 #include <list>
+#include <map>
 #include <set>
 #include <boost/thread.hpp>
+#include <boost/unordered/unordered_map.hpp>
+#include <ignition/math/Pose3.hh>
 #include <sdf/sdf.hh>
 #include <string>
 
@@ -32,6 +36,7 @@
 
 #include "gazebo/transport/TransportTypes.hh"
 
+#include "gazebo/physics/BoundingBoxTree.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/WorldState.hh"
 
@@ -39,6 +44,33 @@ namespace gazebo
 {
   namespace physics
   {
+    /// \brief A model in the world's spatial index.
+    class SpatialProxy
+    {
+      /// \brief Proxy of the model's leaf in the tree.
+      public: int proxy;
+
+      /// \brief The indexed model.
+      public: ModelPtr model;
+    };
+
+    /// \brief A lockstep request waiting to be served by the world.
+    class LockstepCall
+    {
+      /// \brief The request.
+      public: msgs::LockstepRequest request;
+
+      /// \brief The observation, filled once the steps are taken.
+      public: msgs::LockstepObservation observation;
+
+      /// \brief True once the observation is filled.
+      public: bool done;
+
+      /// \brief True to publish the observation, false to hand it to a
+      /// blocked World::Lockstep call.
+      public: bool publish;
+    };
+
     /// \brief Private data class for World.
     class WorldPrivate
     {
@@ -112,6 +144,40 @@ namespace gazebo
       /// \brief Publisher for local pose messages.
       public: transport::PublisherPtr poseLocalPub;
 
+      /// \brief Publisher for compact pose messages.
+      public: transport::PublisherPtr posePackedPub;
+
+      /// \brief Publisher for the names of the compact pose ids.
+      public: transport::PublisherPtr poseNamesPub;
+
+      /// \brief Models that moved since compact poses were published.
+      public: std::set<ModelPtr> packedModelPoses;
+
+      /// \brief Names of the entities in the compact pose stream, by id.
+      public: std::map<uint32_t, std::string> poseNames;
+
+      /// \brief Version of the compact pose name table.
+      public: uint32_t poseNamesVersion;
+
+      /// \brief True if the name table changed since it was published.
+      public: bool poseNamesDirty;
+
+      /// \brief Last published compact pose of each entity.
+      public: boost::unordered_map<uint32_t, ignition::math::Pose3d>
+              packedPoses;
+
+      /// \brief Distance below which compact poses are not published.
+      public: double poseLinearThreshold;
+
+      /// \brief Rotation below which compact poses are not published.
+      public: double poseAngularThreshold;
+
+      /// \brief Last time compact poses were published.
+      public: common::Time prevPackedTime;
+
+      /// \brief Last time all compact poses were published.
+      public: common::Time prevPackedFullTime;
+
       /// \brief Subscriber to world control messages.
       public: transport::SubscriberPtr controlSub;
 
@@ -121,6 +187,9 @@ namespace gazebo
       /// \brief Subscriber to factory messages.
       public: transport::SubscriberPtr factorySub;
 
+      /// \brief Subscriber to factory batch messages.
+      public: transport::SubscriberPtr factoryBatchSub;
+
       /// \brief Subscriber to joint messages.
       public: transport::SubscriberPtr jointSub;
 
@@ -190,6 +259,14 @@ namespace gazebo
       /// \brief Factory message buffer.
       public: std::list<msgs::Factory> factoryMsgs;
 
+      /// \brief Names of the models to delete before the factory messages
+      /// are processed, from factory batches.
+      public: std::vector<std::string> factoryDeletes;
+
+      /// \brief False while a batch of models is loaded, so that LoadModel
+      /// leaves enabling the models to the end of the batch.
+      public: bool enableOnLoad;
+
       /// \brief Model message buffer.
       public: std::list<msgs::Model> modelMsgs;
 
@@ -251,6 +328,10 @@ namespace gazebo
       /// objects are inserted via the factory.
       public: sdf::SDFPtr factorySDF;
 
+      /// \brief Parsed SDF of factory messages, so that spawning the same
+      /// model again does not parse its SDF. Shared by all the worlds.
+      public: PrototypeCachePtr prototypeCache;
+
       /// \brief The list of models that need to publish their pose.
       public: std::set<ModelPtr> publishModelPoses;
 
@@ -302,6 +383,56 @@ namespace gazebo
 
       /// \brief Class to manage preset simulation parameter profiles.
       public: PresetManagerPtr presetManager;
+
+      /// \brief Index of the world's entities by id and name.
+      public: EntityRegistryPtr entityRegistry;
+
+      /// \brief Destroys removed models outside of the simulation loop.
+      public: TeardownQueuePtr teardownQueue;
+
+      /// \brief Bounding boxes of the models, used by the spatial queries.
+      public: BoundingBoxTree spatialTree;
+
+      /// \brief Indexed models, by model id.
+      public: boost::unordered_map<uint32_t, SpatialProxy> spatialProxies;
+
+      /// \brief Models that moved since the spatial index was refreshed.
+      public: std::set<ModelPtr> spatialDirty;
+
+      /// \brief Protects the spatial index.
+      public: boost::mutex spatialMutex;
+
+      /// \brief True once a spatial query has built the index. Until then
+      /// moving models are not tracked.
+      public: std::atomic_bool spatialEnabled;
+
+      /// \brief True to clear all the models on the next step.
+      public: std::atomic_bool clearModels;
+
+      /// \brief Lockstep requests, in the order they were received.
+      public: std::deque<boost::shared_ptr<LockstepCall> > lockstepCalls;
+
+      /// \brief The lockstep request being served, if any.
+      public: boost::shared_ptr<LockstepCall> lockstepActive;
+
+      /// \brief Steps left before the active lockstep request is done.
+      public: unsigned int lockstepSteps;
+
+      /// \brief Protects the lockstep requests.
+      public: boost::mutex lockstepMutex;
+
+      /// \brief Id of the thread in the simulation loop, which serves the
+      /// lockstep requests. Protected by lockstepMutex.
+      public: boost::thread::id loopThreadId;
+
+      /// \brief Signaled when a lockstep observation is filled.
+      public: boost::condition_variable lockstepCondition;
+
+      /// \brief Subscriber to lockstep requests.
+      public: transport::SubscriberPtr lockstepSub;
+
+      /// \brief Publisher of lockstep observations.
+      public: transport::PublisherPtr lockstepPub;
     };
   }
 }
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo/physics/WorldSnapshot.hh"
+
+using namespace gazebo;
+using namespace physics;
+
+//////////////////////////////////////////////////
+WorldSnapshot::WorldSnapshot()
+{
+}
+
+//////////////////////////////////////////////////
+WorldSnapshot::~WorldSnapshot()
+{
+}
+
+//////////////////////////////////////////////////
+void WorldSnapshot::Clear()
+{
+  this->data.clear();
+}
+
+//////////////////////////////////////////////////
+void WorldSnapshot::Write(const void *_data, size_t _size)
+{
+  const char *bytes = static_cast<const char *>(_data);
+  this->data.insert(this->data.end(), bytes, bytes + _size);
+}
+
+//////////////////////////////////////////////////
+void WorldSnapshot::Write(const std::string &_value)
+{
+  this->Write(static_cast<uint32_t>(_value.size()));
+  this->Write(_value.data(), _value.size());
+}
+
+//////////////////////////////////////////////////
+bool WorldSnapshot::Read(size_t &_offset, void *_data, size_t _size) const
+{
+  if (_offset > this->data.size() || this->data.size() - _offset < _size)
+    return false;
+
+  if (_size > 0)
+    memcpy(_data, &this->data[_offset], _size);
+  _offset += _size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool WorldSnapshot::Read(size_t &_offset, std::string &_value) const
+{
+  uint32_t size;
+  size_t offset = _offset;
+  if (!this->Read(offset, size) || this->data.size() - offset < size)
+    return false;
+
+  _value.assign(this->data.begin() + offset,
+      this->data.begin() + offset + size);
+  _offset = offset + size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+const std::vector<char> &WorldSnapshot::GetData() const
+{
+  return this->data;
+}
+
+//////////////////////////////////////////////////
+void WorldSnapshot::SetData(const std::vector<char> &_data)
+{
+  this->data = _data;
+}
+
+//////////////////////////////////////////////////
+size_t WorldSnapshot::GetSize() const
+{
+  return this->data.size();
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+#define _GAZEBO_PHYSICS_WORLDSNAPSHOT_HH_
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gazebo/util/system.hh"
+
+namespace gazebo
+{
+  namespace physics
+  {
+    /// \addtogroup gazebo_physics
+    /// \{
+
+    /// \class WorldSnapshot WorldSnapshot.hh physics/physics.hh
+    /// \brief The dynamic state of a world, as a flat binary buffer.
+    ///
+    /// A snapshot is filled by World::SaveSnapshot and applied by
+    /// World::RestoreSnapshot. Values are stored in the native byte order
+    /// of the machine, so a snapshot is meant to be restored by the
+    /// process that saved it, or by one built the same way.
+    class GZ_PHYSICS_VISIBLE WorldSnapshot
+    {
+      /// \brief Constructor.
+      public: WorldSnapshot();
+
+      /// \brief Destructor.
+      public: virtual ~WorldSnapshot();
+
+      /// \brief Remove all the data, keeping the allocated memory.
+      public: void Clear();
+
+      /// \brief Append raw bytes.
+      /// \param[in] _data Bytes to append.
+      /// \param[in] _size Number of bytes.
+      public: void Write(const void *_data, size_t _size);
+
+      /// \brief Append a value of a plain type.
+      /// \param[in] _value Value to append.
+      public: template<typename T>
+              void Write(const T &_value)
+              {
+                this->Write(&_value, sizeof(T));
+              }
+
+      /// \brief Append a string, preceded by its length.
+      /// \param[in] _value String to append.
+      public: void Write(const std::string &_value);
+
+      /// \brief Read raw bytes.
+      /// \param[in,out] _offset Position to read from, advanced past the
+      /// bytes read.
+      /// \param[out] _data Destination of the bytes.
+      /// \param[in] _size Number of bytes.
+      /// \return False if the snapshot ends before _size bytes.
+      public: bool Read(size_t &_offset, void *_data, size_t _size) const;
+
+      /// \brief Read a value of a plain type.
+      /// \param[in,out] _offset Position to read from, advanced past the
+      /// value.
+      /// \param[out] _value Value read.
+      /// \return False if the snapshot ends before the value.
+      public: template<typename T>
+              bool Read(size_t &_offset, T &_value) const
+              {
+                return this->Read(_offset, &_value, sizeof(T));
+              }
+
+      /// \brief Read a string written by Write(const std::string &).
+      /// \param[in,out] _offset Position to read from, advanced past the
+      /// string.
+      /// \param[out] _value String read.
+      /// \return False if the snapshot ends before the string.
+      public: bool Read(size_t &_offset, std::string &_value) const;
+
+      /// \brief Get the data.
+      /// \return The bytes of the snapshot.
+      public: const std::vector<char> &GetData() const;
+
+      /// \brief Set the data, such as bytes of a snapshot written to a
+      /// file.
+      /// \param[in] _data The bytes of the snapshot.
+      public: void SetData(const std::vector<char> &_data);
+
+      /// \brief Get the size of the snapshot.
+      /// \return Number of bytes.
+      public: size_t GetSize() const;
+
+      /// \brief The bytes of the snapshot.
+      private: std::vector<char> data;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "test/util.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
+
+using namespace gazebo;
+
+class WorldSnapshotTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, WriteRead)
+{
+  physics::WorldSnapshot snapshot;
+  EXPECT_EQ(snapshot.GetSize(), 0u);
+
+  double values[3] = {0.1, -2.5, 1e-300};
+  snapshot.Write(static_cast<uint32_t>(42));
+  snapshot.Write(values);
+  snapshot.Write(static_cast<uint8_t>(1));
+  EXPECT_EQ(snapshot.GetSize(), sizeof(uint32_t) + sizeof(values) + 1u);
+
+  size_t offset = 0;
+  uint32_t number = 0;
+  double read[3] = {0, 0, 0};
+  uint8_t flag = 0;
+  EXPECT_TRUE(snapshot.Read(offset, number));
+  EXPECT_TRUE(snapshot.Read(offset, read));
+  EXPECT_TRUE(snapshot.Read(offset, flag));
+  EXPECT_EQ(offset, snapshot.GetSize());
+
+  EXPECT_EQ(number, 42u);
+  EXPECT_EQ(flag, 1u);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(read[i], values[i]);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, ReadPastEnd)
+{
+  physics::WorldSnapshot snapshot;
+  snapshot.Write(static_cast<uint16_t>(7));
+
+  // A value larger than the remaining bytes is not read.
+  size_t offset = 0;
+  uint32_t number = 0;
+  EXPECT_FALSE(snapshot.Read(offset, number));
+  EXPECT_EQ(offset, 0u);
+
+  uint16_t small = 0;
+  EXPECT_TRUE(snapshot.Read(offset, small));
+  EXPECT_EQ(small, 7u);
+  EXPECT_FALSE(snapshot.Read(offset, small));
+
+  offset = 100;
+  EXPECT_FALSE(snapshot.Read(offset, small));
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, String)
+{
+  physics::WorldSnapshot snapshot;
+  snapshot.Write(std::string("box"));
+  snapshot.Write(std::string());
+  snapshot.Write(std::string("link"));
+
+  size_t offset = 0;
+  std::string value;
+  EXPECT_TRUE(snapshot.Read(offset, value));
+  EXPECT_EQ(value, "box");
+  EXPECT_TRUE(snapshot.Read(offset, value));
+  EXPECT_TRUE(value.empty());
+  EXPECT_TRUE(snapshot.Read(offset, value));
+  EXPECT_EQ(value, "link");
+  EXPECT_EQ(offset, snapshot.GetSize());
+
+  // A string longer than the remaining bytes is not read.
+  physics::WorldSnapshot truncated;
+  truncated.Write(static_cast<uint32_t>(10));
+  truncated.Write("abc", 3);
+  offset = 0;
+  EXPECT_FALSE(truncated.Read(offset, value));
+  EXPECT_EQ(offset, 0u);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldSnapshotTest, Data)
+{
+  physics::WorldSnapshot snapshot;
+  snapshot.Write(3.5);
+
+  physics::WorldSnapshot copy;
+  copy.SetData(snapshot.GetData());
+  EXPECT_EQ(copy.GetSize(), sizeof(double));
+
+  size_t offset = 0;
+  double value = 0;
+  EXPECT_TRUE(copy.Read(offset, value));
+  EXPECT_EQ(value, 3.5);
+
+  copy.Clear();
+  EXPECT_EQ(copy.GetSize(), 0u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -104,6 +104,17 @@ void BulletJoint::Reset()
   Joint::Reset();
 }
 
+//////////////////////////////////////////////////
+void BulletJoint::Fini()
+{
+  // The constraint is stepped by the dynamics world, so it is removed
+  // here, on the simulation thread. The destructor deletes it.
+  if (this->constraint && this->bulletWorld)
+    this->bulletWorld->removeConstraint(this->constraint);
+
+  Joint::Fini();
+}
+
 //////////////////////////////////////////////////
 LinkPtr BulletJoint::GetJointLink(unsigned int _index) const
 {
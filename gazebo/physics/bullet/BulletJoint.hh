@@ -52,6 +52,9 @@ namespace gazebo
       /// \brief Reset the joint
       public: virtual void Reset();
 
+      // Documentation inherited.
+      public: virtual void Fini();
+
       /// \brief Get the body to which the joint is attached
       ///        according the _index
       public: LinkPtr GetJointLink(unsigned int _index) const;
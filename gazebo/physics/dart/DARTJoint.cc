@@ -44,8 +44,6 @@ DARTJoint::DARTJoint(BasePtr _parent)
 //////////////////////////////////////////////////
 DARTJoint::~DARTJoint()
 {
-  this->Detach();
-
   delete this->dataPtr;
 }
 
@@ -114,6 +112,16 @@ void DARTJoint::Reset()
   Joint::Reset();
 }
 
+//////////////////////////////////////////////////
+void DARTJoint::Fini()
+{
+  // Detaching updates the joint lists of the links, so it is done here,
+  // on the simulation thread, and not in the destructor.
+  this->Detach();
+
+  Joint::Fini();
+}
+
 //////////////////////////////////////////////////
 LinkPtr DARTJoint::GetJointLink(unsigned int _index) const
 {
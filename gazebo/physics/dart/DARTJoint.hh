@@ -53,6 +53,9 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void Reset();
 
+      // Documentation inherited.
+      public: virtual void Fini();
+
       // Documentation inherited.
       public: virtual LinkPtr GetJointLink(unsigned int _index) const;
 
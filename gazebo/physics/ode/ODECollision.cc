@@ -31,6 +31,7 @@
 #include "gazebo/common/Console.hh"
 #include "gazebo/math/Box.hh"
 
+#include "gazebo/physics/World.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
 #include "gazebo/physics/ode/ODELink.hh"
@@ -93,6 +94,21 @@ void ODECollision::Fini()
      this->spaceId = NULL;
      */
 
+  // Take the geom out of collision checking now. The geom itself is
+  // destroyed with this object, which may happen on another thread.
+  if (this->collisionId && dGeomGetSpace(this->collisionId))
+    dSpaceRemove(dGeomGetSpace(this->collisionId), this->collisionId);
+
+  // A collision created later at the same address must not warm start
+  // from the contacts of this one.
+  if (this->world)
+  {
+    ODEPhysicsPtr odePhysics = boost::dynamic_pointer_cast<ODEPhysics>(
+        this->world->GetPhysicsEngine());
+    if (odePhysics)
+      odePhysics->RemoveContactImpulses(this);
+  }
+
   Collision::Fini();
 }
 
@@ -21,12 +21,14 @@
 
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Link.hh"
+#include "gazebo/physics/Model.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEJoint.hh"
 #include "gazebo/physics/GearboxJoint.hh"
 #include "gazebo/physics/ScrewJoint.hh"
 #include "gazebo/physics/JointWrench.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 
 using namespace gazebo;
 using namespace physics;
@@ -59,10 +61,33 @@ ODEJoint::~ODEJoint()
     physics::Joint::DisconnectJointUpdate(this->applyDamping);
 
   delete this->feedback;
-  this->Detach();
 
   if (this->jointId)
+  {
+    this->Detach();
     dJointDestroy(this->jointId);
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEJoint::Fini()
+{
+  // The ODE joint is destroyed now rather than in the destructor, since
+  // the world's joint list must only be modified by the physics thread.
+  if (this->applyDamping)
+  {
+    physics::Joint::DisconnectJointUpdate(this->applyDamping);
+    this->applyDamping.reset();
+  }
+
+  if (this->jointId)
+  {
+    this->Detach();
+    dJointDestroy(this->jointId);
+    this->jointId = NULL;
+  }
+
+  Joint::Fini();
 }
 
 //////////////////////////////////////////////////
@@ -1117,17 +1142,56 @@ void ODEJoint::SetForce(unsigned int _index, double _force)
     this->parentLink->SetEnabled(true);
 }
 
+//////////////////////////////////////////////////
+void ODEJoint::SetForces(const double *_forces, const common::Time &_time)
+{
+  for (unsigned int i = 0; i < this->GetAngleCount(); ++i)
+  {
+    double force = Joint::CheckAndTruncateForce(i, _forces[i]);
+    this->SaveForce(i, force, _time);
+    this->SetForceImpl(i, force);
+  }
+
+  // for engines that supports auto-disable of links
+  if (this->childLink)
+    this->childLink->SetEnabled(true);
+  if (this->parentLink)
+    this->parentLink->SetEnabled(true);
+}
+
+//////////////////////////////////////////////////
+void ODEJoint::GetStates(double *_positions, double *_velocities) const
+{
+  // Joints of static models keep their angle outside of ODE.
+  ModelPtr model = this->model.lock();
+  bool isStatic = model && model->IsStatic();
+
+  for (unsigned int i = 0; i < this->GetAngleCount(); ++i)
+  {
+    _positions[i] = isStatic ? this->GetAngle(i).Radian() :
+      this->GetAngleImpl(i).Radian();
+    _velocities[i] = this->GetVelocity(i);
+  }
+}
+
 //////////////////////////////////////////////////
 void ODEJoint::SaveForce(unsigned int _index, double _force)
+{
+  this->SaveForce(_index, _force, this->GetWorld()->GetSimTime());
+}
+
+//////////////////////////////////////////////////
+void ODEJoint::SaveForce(unsigned int _index, double _force,
+    const common::Time &_time)
 {
   // this bit of code actually doesn't do anything physical,
   // it simply records the forces commanded inside forceApplied.
   if (_index < this->GetAngleCount())
   {
-    if (this->forceAppliedTime < this->GetWorld()->GetSimTime())
+    if (this->forceAppliedTime < _time)
     {
       // reset forces if time step is new
-      this->forceAppliedTime = this->GetWorld()->GetSimTime();
+      this->forceAppliedTime = _time;
       this->forceApplied[0] = this->forceApplied[1] = 0;
     }
 
@@ -1189,3 +1253,66 @@ bool ODEJoint::SetPosition(unsigned int _index, double _position)
 {
   return Joint::SetPositionMaximal(_index, _position);
 }
+
+//////////////////////////////////////////////////
+void ODEJoint::SaveSnapshot(WorldSnapshot &_snapshot) const
+{
+  uint8_t hasJoint = this->jointId != NULL;
+  _snapshot.Write(hasJoint);
+  if (hasJoint)
+  {
+    // Constraint impulses of the last step, used by quickstep to warm
+    // start the next one.
+    dReal lambda[6];
+    dReal lambdaErp[6];
+    dJointGetLambda(this->jointId, lambda, lambdaErp);
+
+    double values[12];
+    for (int i = 0; i < 6; ++i)
+    {
+      values[i] = lambda[i];
+      values[i + 6] = lambdaErp[i];
+    }
+    _snapshot.Write(values);
+  }
+
+  _snapshot.Write(this->forceApplied);
+  _snapshot.Write(this->forceAppliedTime.sec);
+  _snapshot.Write(this->forceAppliedTime.nsec);
+}
+
+//////////////////////////////////////////////////
+bool ODEJoint::RestoreSnapshot(const WorldSnapshot &_snapshot,
+    size_t &_offset)
+{
+  uint8_t hasJoint;
+  if (!_snapshot.Read(_offset, hasJoint))
+    return false;
+
+  if ((hasJoint != 0) != (this->jointId != NULL))
+  {
+    gzerr << "Snapshot does not match the ODE joint ["
+          << this->GetScopedName() << "]\n";
+    return false;
+  }
+
+  if (hasJoint)
+  {
+    double values[12];
+    if (!_snapshot.Read(_offset, values))
+      return false;
+
+    dReal lambda[6];
+    dReal lambdaErp[6];
+    for (int i = 0; i < 6; ++i)
+    {
+      lambda[i] = values[i];
+      lambdaErp[i] = values[i + 6];
+    }
+    dJointSetLambda(this->jointId, lambda, lambdaErp);
+  }
+
+  return _snapshot.Read(_offset, this->forceApplied) &&
+    _snapshot.Read(_offset, this->forceAppliedTime.sec) &&
+    _snapshot.Read(_offset, this->forceAppliedTime.nsec);
+}
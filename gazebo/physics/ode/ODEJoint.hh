@@ -49,6 +49,9 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~ODEJoint();
 
+      // Documentation inherited.
+      public: virtual void Fini();
+
       // Documentation inherited.
       public: virtual void Load(sdf::ElementPtr _sdf);
 
@@ -245,6 +248,28 @@ namespace gazebo
       // Documentation inherited.
       public: virtual void ApplyStiffnessDamping();
 
+      /// \brief Apply an effort to every axis, as SetForce does for a
+      /// single axis. The links are enabled once for all the axes.
+      /// \param[in] _forces One effort per axis.
+      /// \param[in] _time Current simulation time, read once by the
+      /// caller for a whole set of joints.
+      /// \sa ODEPhysics::SetJointForces
+      public: void SetForces(const double *_forces,
+                  const common::Time &_time);
+
+      /// \brief Get the position and velocity of every axis.
+      /// \param[out] _positions One position per axis.
+      /// \param[out] _velocities One velocity per axis.
+      /// \sa ODEPhysics::GetJointStates
+      public: void GetStates(double *_positions, double *_velocities) const;
+
+      // Documentation inherited.
+      public: virtual void SaveSnapshot(WorldSnapshot &_snapshot) const;
+
+      // Documentation inherited.
+      public: virtual bool RestoreSnapshot(const WorldSnapshot &_snapshot,
+                  size_t &_offset);
+
       // Documentation inherited.
       /// \brief Set the force applied to this physics::Joint.
       /// Note that the unit of force should be consistent with the rest
@@ -262,6 +287,13 @@ namespace gazebo
       /// \param[in] _force Force value.
       private: void SaveForce(unsigned int _index, double _force);
 
+      /// \brief Save external forces applied to this Joint.
+      /// \param[in] _index Index of the axis.
+      /// \param[in] _force Force value.
+      /// \param[in] _time Current simulation time.
+      private: void SaveForce(unsigned int _index, double _force,
+                   const common::Time &_time);
+
       /// \brief This is our ODE ID
       protected: dJointID jointId;
 
@@ -25,6 +25,7 @@
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/WorldPrivate.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODESurfaceParams.hh"
 #include "gazebo/physics/ode/ODEPhysics.hh"
@@ -791,3 +792,75 @@ void ODELink::SetLinkStatic(bool /*_static*/)
 {
   gzlog << "To be implemented\n";
 }
+
+//////////////////////////////////////////////////
+void ODELink::SaveSnapshot(WorldSnapshot &_snapshot) const
+{
+  uint8_t hasBody = this->linkId != NULL;
+  _snapshot.Write(hasBody);
+  if (!hasBody)
+    return;
+
+  // Save the body state as ODE holds it, so that it is restored bit for
+  // bit rather than through the pose of the link.
+  const dReal *state[6] = {dBodyGetPosition(this->linkId),
+    dBodyGetQuaternion(this->linkId), dBodyGetLinearVel(this->linkId),
+    dBodyGetAngularVel(this->linkId), dBodyGetForce(this->linkId),
+    dBodyGetTorque(this->linkId)};
+  const int sizes[6] = {3, 4, 3, 3, 3, 3};
+
+  double values[19];
+  int index = 0;
+  for (int i = 0; i < 6; ++i)
+  {
+    for (int j = 0; j < sizes[i]; ++j)
+      values[index++] = state[i][j];
+  }
+  _snapshot.Write(values);
+
+  uint8_t enabled = dBodyIsEnabled(this->linkId) != 0;
+  _snapshot.Write(enabled);
+}
+
+//////////////////////////////////////////////////
+bool ODELink::RestoreSnapshot(const WorldSnapshot &_snapshot,
+    size_t &_offset)
+{
+  uint8_t hasBody;
+  if (!_snapshot.Read(_offset, hasBody))
+    return false;
+
+  if ((hasBody != 0) != (this->linkId != NULL))
+  {
+    gzerr << "Snapshot does not match the ODE body of link ["
+          << this->GetScopedName() << "]\n";
+    return false;
+  }
+
+  if (!hasBody)
+    return true;
+
+  double values[19];
+  uint8_t enabled;
+  if (!_snapshot.Read(_offset, values) || !_snapshot.Read(_offset, enabled))
+    return false;
+
+  dQuaternion q = {values[3], values[4], values[5], values[6]};
+  dBodySetPosition(this->linkId, values[0], values[1], values[2]);
+  dBodySetQuaternion(this->linkId, q);
+  dBodySetLinearVel(this->linkId, values[7], values[8], values[9]);
+  dBodySetAngularVel(this->linkId, values[10], values[11], values[12]);
+  dBodySetForce(this->linkId, values[13], values[14], values[15]);
+  dBodySetTorque(this->linkId, values[16], values[17], values[18]);
+
+  if (enabled)
+    dBodyEnable(this->linkId);
+  else
+    dBodyDisable(this->linkId);
+
+  // Propagate the body state to the link the same way a physics update
+  // does. The world applies the dirty pose once all links are restored.
+  MoveCallback(this->linkId);
+
+  return true;
+}
@@ -176,6 +176,13 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetLinkStatic(bool _static);
 
+      // Documentation inherited
+      public: virtual void SaveSnapshot(WorldSnapshot &_snapshot) const;
+
+      // Documentation inherited
+      public: virtual bool RestoreSnapshot(const WorldSnapshot &_snapshot,
+                  size_t &_offset);
+
       /// \brief ODE link handle
       private: dBodyID linkId;
 
@@ -35,6 +35,18 @@ ODEModel::~ODEModel()
   this->spaceId = NULL;
 }
 
+//////////////////////////////////////////////////
+void ODEModel::Fini()
+{
+  // Detach the model's space from the world's space, so that the space
+  // can be destroyed later without touching the world's space.
+  dGeomID spaceGeom = reinterpret_cast<dGeomID>(this->spaceId);
+  if (this->spaceId && dGeomGetSpace(spaceGeom))
+    dSpaceRemove(dGeomGetSpace(spaceGeom), spaceGeom);
+
+  Model::Fini();
+}
+
 ///////////////////////////////////////////////////
 dSpaceID ODEModel::GetSpaceId()
 {
@@ -44,6 +44,9 @@ namespace gazebo
       /// \brief Destructor.
       public: virtual ~ODEModel();
 
+      // Documentation inherited.
+      public: virtual void Fini();
+
       /// \brief Get the ID of the collision space for this model
       /// \return The collision space ID for this model.
       public: dSpaceID GetSpaceId();
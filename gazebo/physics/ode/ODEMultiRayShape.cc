@@ -28,6 +28,25 @@
 using namespace gazebo;
 using namespace physics;
 
+/// \brief Number of neighbouring rays grouped in a packet.
+static const unsigned int kPacketSize = 8;
+
+/////////////////////////////////////////////////
+/// \brief Check whether a geom lies within a space, directly or through
+/// nested spaces.
+/// \param[in] _geom Geom to check.
+/// \param[in] _space Space to look for.
+/// \return True if _geom is in _space.
+static bool inSpace(dGeomID _geom, dSpaceID _space)
+{
+  for (dSpaceID space = dGeomGetSpace(_geom); space;
+       space = dGeomGetSpace(reinterpret_cast<dGeomID>(space)))
+  {
+    if (space == _space)
+      return true;
+  }
+  return false;
+}
 
 //////////////////////////////////////////////////
 ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
@@ -56,6 +75,12 @@ ODEMultiRayShape::ODEMultiRayShape(CollisionPtr _parent)
 //////////////////////////////////////////////////
 ODEMultiRayShape::~ODEMultiRayShape()
 {
+  for (auto const &packetSpaceId : this->packetSpaceIds)
+  {
+    dSpaceSetCleanup(packetSpaceId, 0);
+    dSpaceDestroy(packetSpaceId);
+  }
+
   dSpaceSetCleanup(this->raySpaceId, 0);
   dSpaceDestroy(this->raySpaceId);
 
@@ -92,15 +117,11 @@ void ODEMultiRayShape::UpdateCallback(void *_data, dGeomID _o1, dGeomID _o2)
 
   self = static_cast<ODEMultiRayShape*>(_data);
 
-  // Check space
+  // Check space. Descend into the ray packets, and into the world's
+  // spaces that overlap a packet or a ray.
   if (dGeomIsSpace(_o1) || dGeomIsSpace(_o2))
   {
-    if (dGeomGetSpace(_o1) == self->superSpaceId ||
-        dGeomGetSpace(_o2) == self->superSpaceId)
-      dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
-
-    if (dGeomGetSpace(_o1) == self->raySpaceId ||
-        dGeomGetSpace(_o2) == self->raySpaceId)
+    if (inSpace(_o1, self->superSpaceId) || inSpace(_o2, self->superSpaceId))
       dSpaceCollide2(_o1, _o2, self, &UpdateCallback);
   }
   else
@@ -187,10 +208,20 @@ void ODEMultiRayShape::AddRay(const math::Vector3 &_start,
 {
   MultiRayShape::AddRay(_start, _end);
 
+  // Start a new packet once the last one is full. Rays are added in scan
+  // order, so a packet holds neighbouring rays and has a thin bounding box.
+  if (this->rays.size() % kPacketSize == 0)
+  {
+    dSpaceID packetSpaceId = dSimpleSpaceCreate(this->raySpaceId);
+    dGeomSetCategoryBits((dGeomID) packetSpaceId, GZ_SENSOR_COLLIDE);
+    dGeomSetCollideBits((dGeomID) packetSpaceId, ~GZ_SENSOR_COLLIDE);
+    this->packetSpaceIds.push_back(packetSpaceId);
+  }
+
   ODECollisionPtr odeCollision(new ODECollision(
         this->collisionParent->GetLink()));
   odeCollision->SetName("ode_ray_collision");
-  odeCollision->SetSpaceId(this->raySpaceId);
+  odeCollision->SetSpaceId(this->packetSpaceIds.back());
 
   ODERayShapePtr ray(new ODERayShape(odeCollision));
   odeCollision->SetShape(ray);
@@ -17,6 +17,8 @@
 #ifndef _ODEMULTIRAYSHAPE_HH_
 #define _ODEMULTIRAYSHAPE_HH_
 
+#include <vector>
+
 #include "gazebo/physics/MultiRayShape.hh"
 #include "gazebo/util/system.hh"
 
@@ -55,6 +57,13 @@ namespace gazebo
 
       /// \brief Ray space for collision detector.
       private: dSpaceID raySpaceId;
+
+      /// \brief Spaces that each hold a packet of up to
+      /// eight neighbouring rays. The collision
+      /// detector tests a geom against a packet's bounding box before the
+      /// packet's rays, so a geom that misses a packet costs one test
+      /// instead of one per ray.
+      private: std::vector<dSpaceID> packetSpaceIds;
     };
   }
 }
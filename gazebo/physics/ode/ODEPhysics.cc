@@ -46,8 +46,10 @@
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/physics/PhysicsFactory.hh"
 #include "gazebo/physics/World.hh"
+#include "gazebo/physics/WorldSnapshot.hh"
 #include "gazebo/physics/Entity.hh"
 #include "gazebo/physics/Model.hh"
+#include "gazebo/physics/Link.hh"
 #include "gazebo/physics/SurfaceParams.hh"
 #include "gazebo/physics/Collision.hh"
 #include "gazebo/physics/MapShape.hh"
@@ -56,6 +58,7 @@
 #include "gazebo/physics/ode/ODECollision.hh"
 #include "gazebo/physics/ode/ODELink.hh"
 #include "gazebo/physics/ode/ODEModel.hh"
+#include "gazebo/physics/ode/ODEJoint.hh"
 #include "gazebo/physics/ode/ODEScrewJoint.hh"
 #include "gazebo/physics/ode/ODEHingeJoint.hh"
 #include "gazebo/physics/ode/ODEGearboxJoint.hh"
@@ -85,6 +88,10 @@ using namespace physics;
 
 GZ_REGISTER_PHYSICS_ENGINE("ode", ODEPhysics)
 
+/// \brief Largest distance, in meters, between contacts of consecutive
+/// steps for the impulses of one to warm start the other.
+static const double contactMatchDistance = 0.01;
+
 /*
 class ContactUpdate_TBB
 {
@@ -136,6 +143,8 @@ ODEPhysics::ODEPhysics(WorldPtr _world)
 {
   this->dataPtr->physicsStepFunc = NULL;
   this->dataPtr->maxContacts = 0;
+  this->dataPtr->warmStartContacts = false;
+  this->dataPtr->prevContactsRestored = false;
 
   // Collision detection init
   dInitODE2(0);
@@ -384,6 +393,9 @@ void ODEPhysics::UpdateCollision()
   DIAG_TIMER_START("ODEPhysics::UpdateCollision");
 
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  // Keep the impulses of the contact joints before they are destroyed.
+  this->SaveContactImpulses();
   dJointGroupEmpty(this->dataPtr->contactGroup);
 
   unsigned int i = 0;
@@ -480,6 +492,12 @@ void ODEPhysics::Reset()
   boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
   // Very important to clear out the contact group
   dJointGroupEmpty(this->dataPtr->contactGroup);
+
+  // The contacts refer to the destroyed joints.
+  this->dataPtr->contacts.clear();
+  this->dataPtr->prevContacts.clear();
+  this->dataPtr->prevContactRanges.clear();
+  this->dataPtr->prevContactsRestored = false;
 }
 
 ModelPtr ODEPhysics::CreateModel(BasePtr _parent)
@@ -1196,6 +1214,10 @@ void ODEPhysics::Collide(ODECollision *_collision1, ODECollision *_collision2,
     dJointID contactJoint = dJointCreateContact(this->dataPtr->worldId,
       this->dataPtr->contactGroup, &contact);
 
+    if (this->dataPtr->warmStartContacts)
+      this->WarmStartContact(_collision1, _collision2, contactJoint,
+          contact.geom);
+
     // Store contact information.
     if (contactFeedback && jointFeedback)
     {
@@ -1258,6 +1280,132 @@ void ODEPhysics::AddCollider(ODECollision *_collision1,
   this->dataPtr->collidersCount++;
 }
 
+//////////////////////////////////////////////////
+void ODEPhysics::SaveContactImpulses()
+{
+  // Only the quick step solver starts from the impulses of the joints.
+  this->dataPtr->warmStartContacts =
+    this->dataPtr->physicsStepFunc == &dWorldQuickStep &&
+    dWorldGetQuickStepWarmStartFactor(this->dataPtr->worldId) > 0;
+
+  if (!this->dataPtr->prevContactsRestored)
+  {
+    this->dataPtr->prevContacts.swap(this->dataPtr->contacts);
+    for (auto &contact : this->dataPtr->prevContacts)
+      dJointGetLambda(contact.joint, contact.lambda, contact.lambdaErp);
+  }
+  this->dataPtr->prevContactsRestored = false;
+  this->dataPtr->contacts.clear();
+  this->dataPtr->prevContactRanges.clear();
+
+  if (!this->dataPtr->warmStartContacts)
+  {
+    this->dataPtr->prevContacts.clear();
+    return;
+  }
+
+  this->IndexContactImpulses();
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::IndexContactImpulses()
+{
+  this->dataPtr->prevContactRanges.clear();
+
+  // The contacts of a pair of collisions are created together, so they
+  // are next to each other.
+  const std::vector<ODEContactImpulse> &prev = this->dataPtr->prevContacts;
+  size_t start = 0;
+  for (size_t i = 1; i <= prev.size(); ++i)
+  {
+    if (i == prev.size() ||
+        prev[i].collision1 != prev[start].collision1 ||
+        prev[i].collision2 != prev[start].collision2)
+    {
+      this->dataPtr->prevContactRanges[std::make_pair(
+          prev[start].collision1, prev[start].collision2)] =
+        std::make_pair(start, i);
+      start = i;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::RemoveContactImpulses(const ODECollision *_collision)
+{
+  boost::recursive_mutex::scoped_lock lock(*this->physicsUpdateMutex);
+
+  auto refers = [_collision](const ODEContactImpulse &_contact)
+  {
+    return _contact.collision1 == _collision ||
+      _contact.collision2 == _collision;
+  };
+
+  std::vector<ODEContactImpulse> &contacts = this->dataPtr->contacts;
+  contacts.erase(std::remove_if(contacts.begin(), contacts.end(), refers),
+      contacts.end());
+
+  std::vector<ODEContactImpulse> &prev = this->dataPtr->prevContacts;
+  size_t count = prev.size();
+  prev.erase(std::remove_if(prev.begin(), prev.end(), refers), prev.end());
+
+  // The ranges of the remaining pairs have moved.
+  if (prev.size() != count && !this->dataPtr->prevContactRanges.empty())
+    this->IndexContactImpulses();
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::WarmStartContact(ODECollision *_collision1,
+    ODECollision *_collision2, dJointID _joint, const dContactGeom &_geom)
+{
+  auto range = this->dataPtr->prevContactRanges.find(
+      std::make_pair(_collision1, _collision2));
+
+  if (range != this->dataPtr->prevContactRanges.end())
+  {
+    ODEContactImpulse *best = NULL;
+    double bestDistance = contactMatchDistance * contactMatchDistance;
+
+    for (size_t i = range->second.first; i < range->second.second; ++i)
+    {
+      ODEContactImpulse &prev = this->dataPtr->prevContacts[i];
+      if (prev.used || prev.side1 != _geom.side1 ||
+          prev.side2 != _geom.side2)
+      {
+        continue;
+      }
+
+      double dx = prev.pos[0] - _geom.pos[0];
+      double dy = prev.pos[1] - _geom.pos[1];
+      double dz = prev.pos[2] - _geom.pos[2];
+      double distance = dx*dx + dy*dy + dz*dz;
+      if (distance < bestDistance)
+      {
+        bestDistance = distance;
+        best = &prev;
+      }
+    }
+
+    if (best)
+    {
+      dJointSetLambda(_joint, best->lambda, best->lambdaErp);
+      best->used = true;
+    }
+  }
+
+  ODEContactImpulse contact;
+  contact.collision1 = _collision1;
+  contact.collision2 = _collision2;
+  contact.joint = _joint;
+  contact.pos[0] = _geom.pos[0];
+  contact.pos[1] = _geom.pos[1];
+  contact.pos[2] = _geom.pos[2];
+  contact.side1 = _geom.side1;
+  contact.side2 = _geom.side2;
+  contact.used = false;
+  this->dataPtr->contacts.push_back(contact);
+}
+
 /////////////////////////////////////////////////
 void ODEPhysics::DebugPrint() const
 {
@@ -1528,3 +1676,151 @@ bool ODEPhysics::GetParam(const std::string &_key, boost::any &_value) const
   }
   return true;
 }
+
+//////////////////////////////////////////////////
+void ODEPhysics::SetJointForces(const Joint_V &_joints,
+    const std::vector<double> &_forces)
+{
+  // Every joint of an ODE world is an ODEJoint.
+  common::Time simTime = this->world->GetSimTime();
+  size_t offset = 0;
+  for (auto const &joint : _joints)
+  {
+    ODEJoint *odeJoint = static_cast<ODEJoint *>(joint.get());
+    odeJoint->SetForces(&_forces[offset], simTime);
+    offset += odeJoint->GetAngleCount();
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::GetJointStates(const Joint_V &_joints,
+    std::vector<double> &_positions, std::vector<double> &_velocities) const
+{
+  size_t offset = 0;
+  for (auto const &joint : _joints)
+  {
+    const ODEJoint *odeJoint = static_cast<const ODEJoint *>(joint.get());
+    odeJoint->GetStates(&_positions[offset], &_velocities[offset]);
+    offset += odeJoint->GetAngleCount();
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Get the collisions of the models of a world.
+/// \param[in] _world The world.
+/// \param[out] _collisions Collisions by scoped name.
+static void collisionsByName(WorldPtr _world,
+    std::map<std::string, ODECollision *> &_collisions)
+{
+  Model_V models = _world->GetModels();
+  for (auto const &model : models)
+  {
+    for (auto const &link : model->GetLinks())
+    {
+      for (auto const &collision : link->GetCollisions())
+      {
+        _collisions[collision->GetScopedName()] =
+          static_cast<ODECollision *>(collision.get());
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void ODEPhysics::SaveSnapshot(WorldSnapshot &_snapshot) const
+{
+  // ODE draws from its random number generator when the solver
+  // reorders constraints, so the seed is part of the state of a step.
+  uint64_t seed = dRandGetSeed();
+  _snapshot.Write(seed);
+
+  // The contact impulses the next step warm starts from are part of its
+  // state too. Unless they were restored, they are still in the joints.
+  std::vector<ODEContactImpulse> impulses;
+  if (this->dataPtr->prevContactsRestored)
+    impulses = this->dataPtr->prevContacts;
+  else
+  {
+    impulses = this->dataPtr->contacts;
+    for (auto &impulse : impulses)
+      dJointGetLambda(impulse.joint, impulse.lambda, impulse.lambdaErp);
+  }
+
+  // Contacts are saved by the names of their collisions. A removed
+  // collision drops its contacts in ODECollision::Fini, so the cached
+  // collisions are all alive.
+  _snapshot.Write(static_cast<uint32_t>(impulses.size()));
+  for (auto const &impulse : impulses)
+  {
+    _snapshot.Write(impulse.collision1->GetScopedName());
+    _snapshot.Write(impulse.collision2->GetScopedName());
+    for (int i = 0; i < 3; ++i)
+      _snapshot.Write(static_cast<double>(impulse.pos[i]));
+    _snapshot.Write(static_cast<int32_t>(impulse.side1));
+    _snapshot.Write(static_cast<int32_t>(impulse.side2));
+    for (int i = 0; i < 6; ++i)
+      _snapshot.Write(static_cast<double>(impulse.lambda[i]));
+    for (int i = 0; i < 6; ++i)
+      _snapshot.Write(static_cast<double>(impulse.lambdaErp[i]));
+  }
+}
+
+//////////////////////////////////////////////////
+bool ODEPhysics::RestoreSnapshot(const WorldSnapshot &_snapshot,
+    size_t &_offset)
+{
+  uint64_t seed;
+  uint32_t count;
+  if (!_snapshot.Read(_offset, seed) || !_snapshot.Read(_offset, count))
+    return false;
+
+  std::map<std::string, ODECollision *> collisions;
+  if (count > 0)
+    collisionsByName(this->world, collisions);
+
+  std::vector<ODEContactImpulse> impulses(count);
+  for (auto &impulse : impulses)
+  {
+    std::string name1, name2;
+    double values[15];
+    int32_t side1, side2;
+    if (!_snapshot.Read(_offset, name1) || !_snapshot.Read(_offset, name2) ||
+        !_snapshot.Read(_offset, values, 3 * sizeof(double)) ||
+        !_snapshot.Read(_offset, side1) || !_snapshot.Read(_offset, side2) ||
+        !_snapshot.Read(_offset, values + 3, 12 * sizeof(double)))
+    {
+      return false;
+    }
+
+    auto collision1 = collisions.find(name1);
+    auto collision2 = collisions.find(name2);
+    if (collision1 == collisions.end() || collision2 == collisions.end())
+    {
+      gzerr << "Snapshot has a contact between unknown collisions ["
+            << name1 << "] and [" << name2 << "]\n";
+      return false;
+    }
+
+    impulse.collision1 = collision1->second;
+    impulse.collision2 = collision2->second;
+    impulse.joint = NULL;
+    for (int i = 0; i < 3; ++i)
+      impulse.pos[i] = values[i];
+    impulse.side1 = side1;
+    impulse.side2 = side2;
+    for (int i = 0; i < 6; ++i)
+    {
+      impulse.lambda[i] = values[3 + i];
+      impulse.lambdaErp[i] = values[9 + i];
+    }
+    impulse.used = false;
+  }
+
+  dRandSetSeed(static_cast<unsigned long>(seed));
+
+  // The next step warm starts from the restored impulses, instead of
+  // those of the current contact joints.
+  this->dataPtr->prevContacts.swap(impulses);
+  this->dataPtr->prevContactsRestored = true;
+  return true;
+}
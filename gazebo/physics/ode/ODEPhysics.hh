@@ -21,6 +21,7 @@
 #include <tbb/concurrent_vector.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/thread/thread.hpp>
 
@@ -211,6 +212,22 @@ namespace gazebo
       // Documentation inherited
       public: virtual void SetSeed(uint32_t _seed);
 
+      // Documentation inherited
+      public: virtual void SaveSnapshot(WorldSnapshot &_snapshot) const;
+
+      // Documentation inherited
+      public: virtual bool RestoreSnapshot(const WorldSnapshot &_snapshot,
+                  size_t &_offset);
+
+      // Documentation inherited
+      public: virtual void SetJointForces(const Joint_V &_joints,
+                  const std::vector<double> &_forces);
+
+      // Documentation inherited
+      public: virtual void GetJointStates(const Joint_V &_joints,
+                  std::vector<double> &_positions,
+                  std::vector<double> &_velocities) const;
+
       /// Documentation inherited
       public: virtual bool SetParam(const std::string &_key,
                   const boost::any &_value);
@@ -289,6 +306,11 @@ namespace gazebo
       /// \param[in] _feedback ODE Joint Contact feedback information.
       public: void ProcessJointFeedback(ODEJointFeedback *_feedback);
 
+      /// \brief Drop the contacts of a collision from the contact impulse
+      /// cache, so that no cached contact refers to a removed collision.
+      /// \param[in] _collision The collision being removed.
+      public: void RemoveContactImpulses(const ODECollision *_collision);
+
       protected: virtual void OnRequest(ConstRequestPtr &_msg);
 
       protected: virtual void OnPhysicsMsg(ConstPhysicsPtr &_msg);
@@ -313,6 +335,28 @@ namespace gazebo
       private: void AddCollider(ODECollision *_collision1,
                                 ODECollision *_collision2);
 
+      /// \brief Read the impulses of the contact joints of the last step,
+      /// before the contact group is emptied, to warm start the contact
+      /// joints of the next step.
+      private: void SaveContactImpulses();
+
+      /// \brief Find the range of the previous contacts of each pair of
+      /// collisions.
+      private: void IndexContactImpulses();
+
+      /// \brief Seed a new contact joint with the impulses of the matching
+      /// contact of the previous step, and record it for the next step.
+      /// Contacts match if they are between the same collisions, in the
+      /// same order, on the same geom features, and are the closest ones
+      /// within a short distance.
+      /// \param[in] _collision1 First collision of the contact.
+      /// \param[in] _collision2 Second collision of the contact.
+      /// \param[in] _joint The new contact joint.
+      /// \param[in] _geom Geometry of the contact.
+      private: void WarmStartContact(ODECollision *_collision1,
+                   ODECollision *_collision2, dJointID _joint,
+                   const dContactGeom &_geom);
+
       /// \internal
       /// \brief Private data pointer.
       private: ODEPhysicsPrivate *dataPtr;
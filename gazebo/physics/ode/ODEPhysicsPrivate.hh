@@ -45,6 +45,41 @@ namespace gazebo
       public: dJointFeedback feedbacks[MAX_CONTACT_JOINTS];
     };
 
+    /// \brief A contact joint and its constraint impulses, kept so that
+    /// the solver can warm start the joint of the same contact on the
+    /// next step.
+    class ODEContactImpulse
+    {
+      /// \brief First collision of the contact.
+      public: ODECollision *collision1;
+
+      /// \brief Second collision of the contact.
+      public: ODECollision *collision2;
+
+      /// \brief The contact joint, valid until the contact group is
+      /// emptied.
+      public: dJointID joint;
+
+      /// \brief Position of the contact in the world frame.
+      public: dVector3 pos;
+
+      /// \brief Contact feature of the first geom, such as the index of a
+      /// mesh triangle.
+      public: int side1;
+
+      /// \brief Contact feature of the second geom.
+      public: int side2;
+
+      /// \brief Constraint impulses of the contact joint.
+      public: dReal lambda[6];
+
+      /// \brief Error correction impulses of the contact joint.
+      public: dReal lambdaErp[6];
+
+      /// \brief True once the impulses seeded a new contact joint.
+      public: bool used;
+    };
+
     class ODEPhysicsPrivate
     {
       /// \brief Top-level world for all bodies
@@ -89,6 +124,25 @@ namespace gazebo
 
       /// \brief Maximum number of contact points per collision pair.
       public: unsigned int maxContacts;
+
+      /// \brief True if contact joints are seeded with the impulses of the
+      /// previous step, which is the case for the quick step solver with
+      /// a positive warm start factor.
+      public: bool warmStartContacts;
+
+      /// \brief Contact joints created during the current step.
+      public: std::vector<ODEContactImpulse> contacts;
+
+      /// \brief Contacts of the previous step, with their impulses.
+      public: std::vector<ODEContactImpulse> prevContacts;
+
+      /// \brief Range of prevContacts of each pair of collisions.
+      public: std::map<std::pair<ODECollision*, ODECollision*>,
+               std::pair<size_t, size_t> > prevContactRanges;
+
+      /// \brief True if prevContacts was restored from a snapshot, rather
+      /// than to be read from the contact joints.
+      public: bool prevContactsRestored;
     };
   }
 }
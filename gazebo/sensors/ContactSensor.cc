@@ -26,6 +26,7 @@
 #endif
 
 #include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
 #include <sstream>
 
 #include "gazebo/common/Exception.hh"
@@ -120,12 +121,13 @@ void ContactSensor::Load(const std::string &_worldName)
     // this sensor
     physics::ContactManager *mgr =
         this->world->GetPhysicsEngine()->GetContactManager();
-    std::string topic = mgr->CreateFilter(this->filterName, this->collisions);
-    if (!this->contactSub)
-    {
-      this->contactSub = this->node->Subscribe(topic,
-          &ContactSensor::OnContacts, this);
-    }
+    mgr->CreateFilter(this->filterName, this->collisions);
+
+    // Receive the filtered contacts directly, rather than serialized
+    // through the filter's topic.
+    boost::weak_ptr<Sensor> weakThis = shared_from_this();
+    mgr->SetFilterCallback(this->filterName,
+        boost::bind(&ContactSensor::DeliverContacts, weakThis, _1));
   }
 }
 
@@ -141,69 +143,25 @@ bool ContactSensor::UpdateImpl(bool /*_force*/)
   boost::mutex::scoped_lock lock(this->mutex);
 
   // Don't do anything if there is no new data to process.
-  if (this->incomingContacts.empty())
+  if (this->incomingCounts.empty())
     return false;
 
-  std::vector<std::string>::iterator collIter;
-  std::string collision1;
-
-  // Clear the outgoing contact message.
-  this->contactsMsg.clear_contact();
-
-  // Iterate over all the contact messages
-  for (ContactMsgs_L::iterator iter = this->incomingContacts.begin();
-      iter != this->incomingContacts.end(); ++iter)
-  {
-    // Iterate over all the contacts in the message
-    for (int i = 0; i < (*iter)->contact_size(); ++i)
-    {
-      collision1 = (*iter)->contact(i).collision1();
-
-      // Try to find the first collision's name
-      collIter = std::find(this->collisions.begin(),
-          this->collisions.end(), collision1);
-
-      // If unable to find the first collision's name, try the second
-      if (collIter == this->collisions.end())
-      {
-        collision1 = (*iter)->contact(i).collision2();
-        collIter = std::find(this->collisions.begin(),
-            this->collisions.end(), collision1);
-      }
-
-      // If this sensor is monitoring one of the collision's in the
-      // contact, then add the contact to our outgoing message.
-      if (collIter != this->collisions.end())
-      {
-        int count = (*iter)->contact(i).position_size();
-
-        // Check to see if the contact arrays all have the same size.
-        if (count != (*iter)->contact(i).normal_size() ||
-            count != (*iter)->contact(i).wrench_size() ||
-            count != (*iter)->contact(i).depth_size())
-        {
-          gzerr << "Contact message has invalid array sizes\n";
-          continue;
-        }
-
-        // Copy the contact message.
-        msgs::Contact *contactMsg = this->contactsMsg.add_contact();
-        contactMsg->CopyFrom((*iter)->contact(i));
-      }
-    }
-  }
-
-  // Clear the incoming contact list.
-  this->incomingContacts.clear();
+  // The incoming contacts become the output. Swapping avoids a copy.
+  this->contactsMsg.Swap(&this->incomingContacts);
+  this->incomingContacts.clear_contact();
+  this->incomingCounts.clear();
 
   this->lastMeasurementTime = this->world->GetSimTime();
+  msgs::Set(this->contactsMsg.mutable_time(), this->lastMeasurementTime);
+
+  std::shared_ptr<SensorHistory<msgs::Contacts> > samples =
+    std::atomic_load(&this->history);
+  if (samples)
+    samples->Push(this->lastMeasurementTime, this->contactsMsg);
 
   // Generate a outgoing message only if someone is listening.
   if (this->contactsPub && this->contactsPub->HasConnections())
-  {
-    msgs::Set(this->contactsMsg.mutable_time(), this->lastMeasurementTime);
     this->contactsPub->Publish(this->contactsMsg);
-  }
 
   return true;
 }
@@ -218,7 +176,6 @@ void ContactSensor::Fini()
     mgr->RemoveFilter(this->filterName);
   }
 
-  this->contactSub.reset();
   this->contactsPub.reset();
   Sensor::Fini();
 }
@@ -295,25 +252,83 @@ std::map<std::string, gazebo::physics::Contact> ContactSensor::GetContacts(
 }
 
 //////////////////////////////////////////////////
-void ContactSensor::OnContacts(ConstContactsPtr &_msg)
+void ContactSensor::DeliverContacts(boost::weak_ptr<Sensor> _sensor,
+    const std::vector<physics::Contact *> &_contacts)
+{
+  SensorPtr sensor = _sensor.lock();
+  if (sensor)
+    static_cast<ContactSensor *>(sensor.get())->OnContacts(_contacts);
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::OnContacts(
+    const std::vector<physics::Contact *> &_contacts)
 {
   boost::mutex::scoped_lock lock(this->mutex);
 
   // Only store information if the sensor is active
-  if (this->IsActive())
+  if (!this->IsActive())
+    return;
+
+  // The contact manager only passes contacts that involve this sensor's
+  // collisions, so each one can be converted without matching names.
+  int count = 0;
+  for (std::vector<physics::Contact *>::const_iterator iter =
+       _contacts.begin(); iter != _contacts.end(); ++iter)
   {
-    // Store the contacts message for processing in UpdateImpl
-    this->incomingContacts.push_back(_msg);
+    if ((*iter)->count == 0)
+      continue;
 
-    // Prevent the incomingContacts list to grow indefinitely.
-    if (this->incomingContacts.size() > 100)
-      this->incomingContacts.pop_front();
+    (*iter)->FillMsg(*this->incomingContacts.add_contact());
+    ++count;
+  }
+  this->incomingCounts.push_back(count);
+
+  // Prevent the incoming contacts to grow indefinitely, by dropping the
+  // oldest physics step.
+  if (this->incomingCounts.size() > 100)
+  {
+    this->incomingContacts.mutable_contact()->DeleteSubrange(
+        0, this->incomingCounts.front());
+    this->incomingCounts.pop_front();
   }
 }
 
 //////////////////////////////////////////////////
 bool ContactSensor::IsActive()
 {
-  return this->active ||
-         (this->contactsPub && this->contactsPub->HasConnections());
+  return Sensor::IsActive() ||
+         (this->contactsPub && this->contactsPub->HasConnections()) ||
+         std::atomic_load(&this->history) != NULL;
+}
+
+//////////////////////////////////////////////////
+void ContactSensor::EnableHistory(unsigned int _capacity)
+{
+  std::atomic_store(&this->history,
+      std::shared_ptr<SensorHistory<msgs::Contacts> >(
+        new SensorHistory<msgs::Contacts>(_capacity)));
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const SensorHistory<msgs::Contacts> >
+ContactSensor::History() const
+{
+  return std::atomic_load(&this->history);
+}
+
+//////////////////////////////////////////////////
+bool ContactSensor::FillReadingMsg(msgs::SensorReading &_msg)
+{
+  msgs::Contacts msg = this->GetContacts();
+
+  // Nothing is measured before the first update.
+  if (!msg.IsInitialized())
+    return false;
+
+  _msg.set_name(this->GetScopedName());
+  _msg.mutable_time()->CopyFrom(msg.time());
+  _msg.set_type(msg.GetTypeName());
+  msg.SerializeToString(_msg.mutable_data());
+  return true;
 }
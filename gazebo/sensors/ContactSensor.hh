@@ -17,14 +17,16 @@
 #ifndef _GAZEBO_CONTACTSENSOR_HH_
 #define _GAZEBO_CONTACTSENSOR_HH_
 
+#include <deque>
+#include <memory>
 #include <vector>
 #include <map>
-#include <list>
 #include <string>
 
 #include "gazebo/msgs/msgs.hh"
 
 #include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorHistory.hh"
 #include "gazebo/physics/Contact.hh"
 #include "gazebo/util/system.hh"
 
@@ -92,10 +94,10 @@ namespace gazebo
       /// to publish all contacts generated within a timestep onto
       /// Gazebo topic ~/physics/contacts.
       ///
-      /// Each ContactSensor subscribes to the Gazebo ~/physics/contacts topic,
-      /// retrieves all contact pairs in a time step and filters them wthin
-      /// ContactSensor::OnContacts against <collision> body name
-      /// specified by the ContactSensor SDF.
+      /// Each ContactSensor registers a filter with the ContactManager for
+      /// the <collision> bodies specified by the ContactSensor SDF. The
+      /// ContactManager matches contacts against the filter's collisions
+      /// and hands the matches directly to ContactSensor::OnContacts.
       /// All collision pairs between ContactSensor <collision> body and
       /// other bodies in the world are stored in an array inside
       /// contacts.proto.
@@ -128,11 +130,36 @@ namespace gazebo
       public: std::map<std::string, physics::Contact> GetContacts(
                   const std::string &_collisionName);
 
+      /// \brief Keep a history of the sensor's contacts, for in-process
+      /// readers. Replaces any previous history.
+      /// \param[in] _capacity Number of samples kept.
+      public: void EnableHistory(unsigned int _capacity);
+
+      /// \brief Get the history of the sensor's contacts.
+      /// \return The history, or NULL if EnableHistory has not been called.
+      public: std::shared_ptr<const SensorHistory<msgs::Contacts> >
+              History() const;
+
       // Documentation inherited.
       public: virtual bool IsActive();
 
-      /// \brief Callback for contact messages from the physics engine.
-      private: void OnContacts(ConstContactsPtr &_msg);
+      // Documentation inherited.
+      public: virtual bool FillReadingMsg(msgs::SensorReading &_msg);
+
+      /// \brief Callback for contacts from the contact manager. Called in
+      /// the physics thread with the contacts of the sensor's filter.
+      /// \param[in] _contacts Contacts that involve the sensor's
+      /// collisions. Only valid for the duration of the call.
+      private: void OnContacts(
+                  const std::vector<physics::Contact *> &_contacts);
+
+      /// \brief Forward contacts to a sensor, if it still exists. The
+      /// contact manager holds this callback, so it must not keep the
+      /// sensor alive.
+      /// \param[in] _sensor The contact sensor.
+      /// \param[in] _contacts Contacts for the sensor.
+      private: static void DeliverContacts(boost::weak_ptr<Sensor> _sensor,
+                  const std::vector<physics::Contact *> &_contacts);
 
       /// \brief Collisions this sensor monitors for contacts
       private: std::vector<std::string> collisions;
@@ -140,9 +167,6 @@ namespace gazebo
       /// \brief Output contact information.
       private: transport::PublisherPtr contactsPub;
 
-      /// \brief Subscription to contact messages from the physics engine
-      private: transport::SubscriberPtr contactSub;
-
       /// \brief Mutex to protect reads and writes.
       private: mutable boost::mutex mutex;
 
@@ -152,8 +176,16 @@ namespace gazebo
       /// \brief Name of the collision filter
       private: std::string filterName;
 
-      typedef std::list<boost::shared_ptr<msgs::Contacts const> > ContactMsgs_L;
-      private: ContactMsgs_L incomingContacts;
+      /// \brief Contacts received since the last update, filled directly
+      /// from the contact manager.
+      private: msgs::Contacts incomingContacts;
+
+      /// \brief Number of contacts in incomingContacts from each physics
+      /// step, oldest first. Used to bound the backlog.
+      private: std::deque<int> incomingCounts;
+
+      /// \brief History of samples, NULL unless enabled.
+      private: std::shared_ptr<SensorHistory<msgs::Contacts> > history;
     };
     /// \}
   }
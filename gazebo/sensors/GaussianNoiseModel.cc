@@ -150,7 +150,7 @@ void GaussianNoiseModel::Fini()
 double GaussianNoiseModel::ApplyImpl(double _in)
 {
   // Add independent (uncorrelated) Gaussian noise to each input value.
-  double whiteNoise = ignition::math::Rand::DblNormal(this->mean, this->stdDev);
+  double whiteNoise = this->SampleNormal(this->mean, this->stdDev);
   double output = _in + this->bias + whiteNoise;
   if (this->quantized)
   {
@@ -163,6 +163,25 @@ double GaussianNoiseModel::ApplyImpl(double _in)
   return output;
 }
 
+//////////////////////////////////////////////////
+void GaussianNoiseModel::ApplyBatchImpl(std::vector<double> &_data)
+{
+  // Draw all the white noise at once.
+  this->whiteNoise.resize(_data.size());
+  this->SampleNormals(this->mean, this->stdDev, this->whiteNoise);
+
+  size_t count = _data.size();
+  for (size_t i = 0; i < count; ++i)
+    _data[i] += this->bias + this->whiteNoise[i];
+
+  // Apply this->precision
+  if (this->quantized && !ignition::math::equal(this->precision, 0.0, 1e-6))
+  {
+    for (size_t i = 0; i < count; ++i)
+      _data[i] = std::round(_data[i] / this->precision) * this->precision;
+  }
+}
+
 //////////////////////////////////////////////////
 double GaussianNoiseModel::GetMean() const
 {
@@ -57,6 +57,9 @@ namespace gazebo
         // Documentation inherited.
         public: double ApplyImpl(double _in);
 
+        // Documentation inherited.
+        public: virtual void ApplyBatchImpl(std::vector<double> &_data);
+
         /// \brief Accessor for mean.
         /// \return Mean of Gaussian noise.
         public: double GetMean() const;
@@ -89,6 +92,9 @@ namespace gazebo
 
         /// \brief True if the type is GAUSSIAN_QUANTIZED
         protected: bool quantized;
+
+        /// \brief White noise samples, reused by ApplyBatchImpl.
+        private: std::vector<double> whiteNoise;
     };
 
     /// \class GaussianNoiseModel
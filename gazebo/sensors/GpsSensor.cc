@@ -216,3 +216,10 @@ double GpsSensor::GetAltitude() const
 {
   return this->lastGpsMsg.altitude();
 }
+
+//////////////////////////////////////////////////
+bool GpsSensor::IsActive()
+{
+  return Sensor::IsActive() ||
+    (this->gpsPub && this->gpsPub->HasConnections());
+}
@@ -61,6 +61,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Fini();
 
+      // Documentation inherited
+      public: virtual bool IsActive();
+
       /// \brief Accessor for current longitude angle
       /// \return Current longitude angle.
       /// \deprecated See Longitude() function that return an
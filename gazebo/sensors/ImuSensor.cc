@@ -493,8 +493,13 @@ bool ImuSensor::UpdateImpl(bool /*_force*/)
       }
     }
 
-    // Publish the message
-    if (this->pub)
+    std::shared_ptr<SensorHistory<msgs::IMU> > samples =
+      std::atomic_load(&this->history);
+    if (samples)
+      samples->Push(timestamp, this->imuMsg);
+
+    // Publish the message, only if someone is listening.
+    if (this->pub && this->pub->HasConnections())
       this->pub->Publish(this->imuMsg);
   }
 
@@ -504,6 +509,37 @@ bool ImuSensor::UpdateImpl(bool /*_force*/)
 //////////////////////////////////////////////////
 bool ImuSensor::IsActive()
 {
-  return this->active ||
-         (this->pub && this->pub->HasConnections());
+  return Sensor::IsActive() ||
+         (this->pub && this->pub->HasConnections()) ||
+         std::atomic_load(&this->history) != NULL;
+}
+
+//////////////////////////////////////////////////
+void ImuSensor::EnableHistory(unsigned int _capacity)
+{
+  std::atomic_store(&this->history,
+      std::shared_ptr<SensorHistory<msgs::IMU> >(
+        new SensorHistory<msgs::IMU>(_capacity)));
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const SensorHistory<msgs::IMU> > ImuSensor::History() const
+{
+  return std::atomic_load(&this->history);
+}
+
+//////////////////////////////////////////////////
+bool ImuSensor::FillReadingMsg(msgs::SensorReading &_msg)
+{
+  msgs::IMU msg = this->GetImuMessage();
+
+  // Nothing is measured before the first update.
+  if (!msg.IsInitialized())
+    return false;
+
+  _msg.set_name(this->GetScopedName());
+  _msg.mutable_time()->CopyFrom(msg.stamp());
+  _msg.set_type(msg.GetTypeName());
+  msg.SerializeToString(_msg.mutable_data());
+  return true;
 }
@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_IMUSENSOR_HH_
 #define _GAZEBO_IMUSENSOR_HH_
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <ignition/math/Pose3.hh>
@@ -25,6 +26,7 @@
 
 #include "gazebo/physics/PhysicsTypes.hh"
 #include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorHistory.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -105,9 +107,21 @@ namespace gazebo
       /// \brief Sets the current pose as the IMU reference pose
       public: void SetReferencePose();
 
+      /// \brief Keep a history of the sensor's measurements, for in-process
+      /// readers. Replaces any previous history.
+      /// \param[in] _capacity Number of samples kept.
+      public: void EnableHistory(unsigned int _capacity);
+
+      /// \brief Get the history of the sensor's measurements.
+      /// \return The history, or NULL if EnableHistory has not been called.
+      public: std::shared_ptr<const SensorHistory<msgs::IMU> > History() const;
+
       // Documentation inherited.
       public: virtual bool IsActive();
 
+      // Documentation inherited.
+      public: virtual bool FillReadingMsg(msgs::SensorReading &_msg);
+
       /// \brief Callback when link data is received
       /// \param[in] _msg Message containing link data
       private: void OnLinkData(ConstLinkDataPtr &_msg);
@@ -150,6 +164,9 @@ namespace gazebo
 
       /// \brief Noise free angular velocity.
       private: ignition::math::Vector3d angularVel;
+
+      /// \brief History of samples, NULL unless enabled.
+      private: std::shared_ptr<SensorHistory<msgs::IMU> > history;
     };
     /// \}
   }
@@ -128,8 +128,9 @@ bool LogicalCameraSensor::UpdateImpl(bool _force)
     // Set the camera's pose in the message.
     msgs::Set(this->dataPtr->msg.mutable_pose(), myPose);
 
-    // Check all models for inclusion in the frustum.
-    for (auto const &model : this->world->GetModels())
+    // Check the models near the frustum for inclusion in the frustum.
+    for (auto const &model :
+         this->world->GetModelsInFrustum(this->dataPtr->frustum))
     {
       // Add the the model to the output if it is in the frustum, and
       // we are not detecting ourselves.
@@ -175,3 +175,10 @@ ignition::math::Vector3d MagnetometerSensor::MagneticField() const
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
   return msgs::ConvertIgn(this->dataPtr->magMsg.field_tesla());
 }
+
+//////////////////////////////////////////////////
+bool MagnetometerSensor::IsActive()
+{
+  return Sensor::IsActive() ||
+    (this->dataPtr->magPub && this->dataPtr->magPub->HasConnections());
+}
@@ -66,6 +66,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Fini();
 
+      // Documentation inherited
+      public: virtual bool IsActive();
+
       /// \brief Accessor for current magnetic field in Tesla
       /// \return Current magnetic field
       public: ignition::math::Vector3d MagneticField() const;
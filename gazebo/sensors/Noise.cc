@@ -21,7 +21,12 @@
   #include <Winsock2.h>
 #endif
 
+#include <cmath>
+#include <limits>
+
 #include <boost/function.hpp>
+#include <ignition/math/Rand.hh>
+
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Console.hh"
 
@@ -31,6 +36,29 @@
 using namespace gazebo;
 using namespace sensors;
 
+/////////////////////////////////////////////////
+/// \brief Counter based random number generator. Returns number _index of
+/// the stream with the given seed, using the SplitMix64 mixing function.
+/// \param[in] _seed Seed of the stream.
+/// \param[in] _index Index of the number in the stream.
+/// \return The random number.
+static inline uint64_t streamValue(uint64_t _seed, uint64_t _index)
+{
+  uint64_t z = _seed + (_index + 1) * 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/////////////////////////////////////////////////
+/// \brief Convert a random number to a double in (0, 1].
+/// \param[in] _value Random number.
+/// \return The double.
+static inline double toUnit(uint64_t _value)
+{
+  return ((_value >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
 //////////////////////////////////////////////////
 NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
     const std::string &_sensorType)
@@ -80,8 +108,14 @@ NoisePtr NoiseFactory::NewNoiseModel(sdf::ElementPtr _sdf,
 //////////////////////////////////////////////////
 Noise::Noise(NoiseType _type)
   : type(_type),
+    counter(0),
     customNoiseCallback(NULL)
 {
+  // Sensors replace this seed with one derived from the world seed.
+  this->seed = static_cast<uint64_t>(ignition::math::Rand::IntUniform(
+        0, std::numeric_limits<int>::max())) << 32 |
+    static_cast<uint64_t>(ignition::math::Rand::IntUniform(
+        0, std::numeric_limits<int>::max()));
 }
 
 //////////////////////////////////////////////////
@@ -129,6 +163,82 @@ double Noise::ApplyImpl(double _in)
   return _in;
 }
 
+//////////////////////////////////////////////////
+void Noise::ApplyBatch(std::vector<double> &_data)
+{
+  if (this->type == NONE)
+    return;
+  else if (this->type == CUSTOM)
+  {
+    for (auto &value : _data)
+      value = this->Apply(value);
+  }
+  else
+    this->ApplyBatchImpl(_data);
+}
+
+//////////////////////////////////////////////////
+void Noise::ApplyBatchImpl(std::vector<double> &_data)
+{
+  for (auto &value : _data)
+    value = this->ApplyImpl(value);
+}
+
+//////////////////////////////////////////////////
+void Noise::SetSeed(uint64_t _seed)
+{
+  this->seed = _seed;
+  this->counter = 0;
+}
+
+//////////////////////////////////////////////////
+uint64_t Noise::GetSeed() const
+{
+  return this->seed;
+}
+
+//////////////////////////////////////////////////
+double Noise::SampleUniform()
+{
+  return toUnit(streamValue(this->seed, this->counter++));
+}
+
+//////////////////////////////////////////////////
+double Noise::SampleNormal(double _mean, double _stdDev)
+{
+  // Box-Muller transform. Only the cosine half is used, so that the
+  // stream position does not depend on earlier calls.
+  double u1 = this->SampleUniform();
+  double u2 = this->SampleUniform();
+  return _mean + _stdDev * std::sqrt(-2.0 * std::log(u1)) *
+    std::cos(2.0 * M_PI * u2);
+}
+
+//////////////////////////////////////////////////
+void Noise::SampleNormals(double _mean, double _stdDev,
+    std::vector<double> &_samples)
+{
+  size_t count = _samples.size();
+  size_t pairs = (count + 1) / 2;
+  uint64_t base = this->counter;
+  this->counter += 2 * pairs;
+
+  // Box-Muller transform on pairs of uniform numbers. Each number only
+  // depends on the seed and its index, so the loops have no dependencies
+  // between iterations and can be vectorized by the compiler.
+  for (size_t i = 0; i < pairs; ++i)
+  {
+    double u1 = toUnit(streamValue(this->seed, base + 2 * i));
+    double u2 = toUnit(streamValue(this->seed, base + 2 * i + 1));
+    double r = _stdDev * std::sqrt(-2.0 * std::log(u1));
+    double theta = 2.0 * M_PI * u2;
+
+    _samples[2 * i] = _mean + r * std::cos(theta);
+    if (2 * i + 1 < count)
+      _samples[2 * i + 1] = _mean + r * std::sin(theta);
+  }
+}
+
 //////////////////////////////////////////////////
 Noise::NoiseType Noise::GetNoiseType() const
 {
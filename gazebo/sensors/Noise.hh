@@ -18,6 +18,7 @@
 #ifndef _GAZEBO_NOISE_HH_
 #define _GAZEBO_NOISE_HH_
 
+#include <stdint.h>
 #include <vector>
 #include <string>
 
@@ -88,6 +89,31 @@ namespace gazebo
       /// \return Data with noise applied.
       public: virtual double ApplyImpl(double _in);
 
+      /// \brief Apply noise to an array of input data values, in place.
+      /// This is equivalent to calling Apply on each value, but lets noise
+      /// models draw their random numbers in batches.
+      /// \param[in,out] _data Input data values, replaced by the data with
+      /// noise applied.
+      public: void ApplyBatch(std::vector<double> &_data);
+
+      /// \brief Apply noise to an array of input data values. This gets
+      /// overriden by derived classes, and called by ApplyBatch. The
+      /// default calls ApplyImpl on each value.
+      /// \param[in,out] _data Input data values, replaced by the data with
+      /// noise applied.
+      public: virtual void ApplyBatchImpl(std::vector<double> &_data);
+
+      /// \brief Set the seed of the noise model's random number stream.
+      /// Sensors seed each of their noise models from the world's random
+      /// seed and the sensor's name, so that the noise does not depend on
+      /// the order in which sensors are updated.
+      /// \param[in] _seed Seed of the stream.
+      public: void SetSeed(uint64_t _seed);
+
+      /// \brief Get the seed of the noise model's random number stream.
+      /// \return Seed of the stream.
+      public: uint64_t GetSeed() const;
+
       /// \brief Finalize the noise model
       public: virtual void Fini();
 
@@ -112,9 +138,35 @@ namespace gazebo
       /// \param[in] _out Output stream
       public: virtual void Print(std::ostream &_out) const;
 
+      /// \brief Draw a uniform random number from the noise model's stream.
+      /// \return Number in the range (0, 1].
+      protected: double SampleUniform();
+
+      /// \brief Draw a normally distributed random number from the noise
+      /// model's stream.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      /// \return The random number.
+      protected: double SampleNormal(double _mean, double _stdDev);
+
+      /// \brief Fill an array with normally distributed random numbers from
+      /// the noise model's stream.
+      /// \param[in] _mean Mean of the distribution.
+      /// \param[in] _stdDev Standard deviation of the distribution.
+      /// \param[out] _samples Array to fill. Its size is kept.
+      protected: void SampleNormals(double _mean, double _stdDev,
+                     std::vector<double> &_samples);
+
       /// \brief Which type of noise we're applying
       private: NoiseType type;
 
+      /// \brief Seed of the random number stream.
+      private: uint64_t seed;
+
+      /// \brief Index of the next number in the random number stream. The
+      /// stream is counter based: number i is a hash of the seed and i.
+      private: uint64_t counter;
+
       /// \brief Noise sdf element.
       private: sdf::ElementPtr sdf;
 
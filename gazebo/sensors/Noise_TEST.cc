@@ -373,6 +373,56 @@ TEST_F(NoiseTest, OnApplyNoise)
   }
 }
 
+//////////////////////////////////////////////////
+// Test batch noise application and seeding
+TEST_F(NoiseTest, ApplyBatch)
+{
+  double mean = 1.5;
+  double stddev = 0.5;
+  std::vector<double> data(g_applyCount * 10 + 1, 42.0);
+
+  sensors::NoisePtr noise = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("gaussian", mean, stddev, 0, 0, 0));
+  noise->SetSeed(1234);
+  EXPECT_EQ(noise->GetSeed(), 1234u);
+  noise->ApplyBatch(data);
+
+  boost::accumulators::accumulator_set<double,
+    boost::accumulators::stats<boost::accumulators::tag::mean,
+                               boost::accumulators::tag::variance > > acc;
+  for (auto const &value : data)
+    acc(value);
+
+  double sampleStdDev = g_sigma * stddev / sqrt(data.size());
+  EXPECT_NEAR(boost::accumulators::mean(acc), 42.0 + mean, sampleStdDev);
+  double variance = stddev * stddev;
+  double sampleVariance2 = 2 * variance * variance / (data.size() - 1);
+  EXPECT_NEAR(boost::accumulators::variance(acc),
+              variance, g_sigma * sqrt(sampleVariance2));
+
+  // The same seed gives the same noise, regardless of the global random
+  // number generator.
+  std::vector<double> repeat(data.size(), 42.0);
+  ignition::math::Rand::DblNormal(0, 1);
+  noise->SetSeed(1234);
+  noise->ApplyBatch(repeat);
+  EXPECT_EQ(data, repeat);
+
+  // A different seed gives different noise.
+  std::vector<double> other(data.size(), 42.0);
+  noise->SetSeed(4321);
+  noise->ApplyBatch(other);
+  EXPECT_NE(data, other);
+
+  // No noise leaves the data unchanged.
+  sensors::NoisePtr none = sensors::NoiseFactory::NewNoiseModel(
+      NoiseSdf("none", 0, 0, 0, 0, 0));
+  std::vector<double> unchanged(10, 42.0);
+  none->ApplyBatch(unchanged);
+  for (auto const &value : unchanged)
+    EXPECT_DOUBLE_EQ(value, 42.0);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -25,8 +25,12 @@
   #include <Winsock2.h>
 #endif
 
+#include <set>
+#include <string>
+
 #include "gazebo/physics/World.hh"
 #include "gazebo/physics/Entity.hh"
+#include "gazebo/physics/Model.hh"
 
 #include "gazebo/common/Exception.hh"
 
@@ -46,6 +50,8 @@ using namespace sensors;
 
 GZ_REGISTER_STATIC_SENSOR("rfid", RFIDSensor)
 
+const double RFIDSensor::Range = 5.0;
+
 /////////////////////////////////////////////////
 RFIDSensor::RFIDSensor()
   : Sensor(sensors::OTHER)
@@ -149,9 +155,26 @@ void RFIDSensor::EvaluateTags()
 {
   std::vector<RFIDTag*>::const_iterator ci;
 
+  // Only tags on models within range of the sensor, as tested by
+  // CheckTagRange, can be detected.
+  std::set<std::string> nearModels;
+  for (auto const &model : this->world->GetModelsInSphere(
+        this->entity->GetWorldPose().Ign().Pos(), Range))
+  {
+    nearModels.insert(model->GetScopedName());
+  }
+
   // iterate through the tags contained given rfid tag manager
   for (ci = this->tags.begin(); ci != this->tags.end(); ++ci)
   {
+    // The tag's parent is a link, scoped by its model's name.
+    std::string parentName = (*ci)->GetParentName();
+    if (nearModels.find(parentName.substr(0, parentName.find("::"))) ==
+        nearModels.end())
+    {
+      continue;
+    }
+
     ignition::math::Pose3d pos = (*ci)->TagPose();
     // std::cout << "link: " << tagModelPtr->GetName() << std::endl;
     // std::cout << "link pos: x" << pos.pos.x
@@ -176,7 +199,7 @@ bool RFIDSensor::CheckTagRange(const ignition::math::Pose3d &_pose)
 
   // std::cout << v.GetLength() << std::endl;
 
-  if (v.Length() <= 5.0)
+  if (v.Length() <= Range)
   {
     // std::cout << "detected " <<  v.GetLength() << std::endl;
     return true;
@@ -191,3 +214,10 @@ void RFIDSensor::AddTag(RFIDTag *_tag)
 {
   this->tags.push_back(_tag);
 }
+
+//////////////////////////////////////////////////
+bool RFIDSensor::IsActive()
+{
+  return Sensor::IsActive() ||
+    (this->scanPub && this->scanPub->HasConnections());
+}
@@ -69,6 +69,12 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Fini();
 
+      // Documentation inherited
+      public: virtual bool IsActive();
+
+      /// \brief Distance, in meters, within which tags are detected.
+      public: static const double Range;
+
       /// \brief Iterates through all the RFID tags, and finds the ones which
       /// are in range of the sensor.
       private: void EvaluateTags();
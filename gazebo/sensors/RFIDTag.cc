@@ -136,3 +136,10 @@ ignition::math::Pose3d RFIDTag::TagPose() const
 {
   return entity->GetWorldPose().Ign();
 }
+
+//////////////////////////////////////////////////
+bool RFIDTag::IsActive()
+{
+  return Sensor::IsActive() ||
+    (this->scanPub && this->scanPub->HasConnections());
+}
@@ -61,6 +61,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Fini();
 
+      // Documentation inherited
+      public: virtual bool IsActive();
+
       /// \brief Returns pose of tag in world coordinate.
       /// \return Pose of object.
       /// \deprecated See TagPose() function that returns an
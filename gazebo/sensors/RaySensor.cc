@@ -393,8 +393,10 @@ bool RaySensor::UpdateImpl(bool /*_force*/)
   scan->set_vertical_angle_step(this->GetVerticalAngleResolution());
   scan->set_vertical_count(this->GetVerticalRangeCount());
 
-  scan->set_range_min(this->GetRangeMin());
-  scan->set_range_max(this->GetRangeMax());
+  double rangeMin = this->GetRangeMin();
+  double rangeMax = this->GetRangeMax();
+  scan->set_range_min(rangeMin);
+  scan->set_range_max(rangeMax);
 
   scan->clear_ranges();
   scan->clear_intensities();
@@ -404,6 +406,22 @@ bool RaySensor::UpdateImpl(bool /*_force*/)
   unsigned int verticalRayCount = this->GetVerticalRayCount();
   unsigned int verticalRangeCount = this->GetVerticalRangeCount();
 
+  scan->mutable_ranges()->Reserve(rangeCount * verticalRangeCount);
+  scan->mutable_intensities()->Reserve(rangeCount * verticalRangeCount);
+
+  // Read all the rays at once, rather than one lookup per sample.
+  this->laserShape->GetScan(this->rayRanges, this->rayRetros,
+      this->rayFiducials);
+  const std::vector<double> &ranges = this->rayRanges;
+  const std::vector<double> &retros = this->rayRetros;
+
+  // currently supports only one noise model per laser sensor
+  NoisePtr noise;
+  if (this->noises.find(RAY_NOISE) != this->noises.end())
+    noise = this->noises[RAY_NOISE];
+
+  this->sampleRanges.clear();
+
   // Interpolation: for every point in range count, compute interpolated value
   // using four bounding ray samples.
   // (vja, hja)   (vja, hjb)
@@ -477,47 +495,62 @@ bool RaySensor::UpdateImpl(bool /*_force*/)
         j4 = hjb + vjb * rayCount;
 
         // range readings of 4 corners
-        r1 = this->GetLaserShape()->GetRange(j1);
-        r2 = this->GetLaserShape()->GetRange(j2);
-        r3 = this->GetLaserShape()->GetRange(j3);
-        r4 = this->GetLaserShape()->GetRange(j4);
+        r1 = ranges[j1];
+        r2 = ranges[j2];
+        r3 = ranges[j3];
+        r4 = ranges[j4];
         range = (1-vb)*((1 - hb) * r1 + hb * r2)
             + vb *((1 - hb) * r3 + hb * r4);
 
         // intensity is averaged
-        intensity = 0.25 * (this->GetLaserShape()->GetRetro(j1)
-            + this->GetLaserShape()->GetRetro(j2)
-            + this->GetLaserShape()->GetRetro(j3)
-            + this->GetLaserShape()->GetRetro(j4));
+        intensity = 0.25 * (retros[j1] + retros[j2] + retros[j3] +
+            retros[j4]);
       }
       else
       {
-        range = this->laserShape->GetRange(j * this->GetRayCount() + i);
-        intensity = this->laserShape->GetRetro(j * this->GetRayCount() + i);
-      }
-
-      // Mask ranges outside of min/max to +/- inf, as per REP 117
-      if (range >= this->GetRangeMax())
-      {
-        range = GZ_DBL_INF;
-      }
-      else if (range <= this->GetRangeMin())
-      {
-        range = -GZ_DBL_INF;
-      }
-      else if (this->noises.find(RAY_NOISE) != this->noises.end())
-      {
-        // currently supports only one noise model per laser sensor
-        range = this->noises[RAY_NOISE]->Apply(range);
-        range = ignition::math::clamp(range,
-            this->GetRangeMin(), this->GetRangeMax());
+        range = ranges[j * rayCount + i];
+        intensity = retros[j * rayCount + i];
       }
 
-      scan->add_ranges(range);
+      this->sampleRanges.push_back(range);
       scan->add_intensities(intensity);
     }
   }
 
+  // Apply noise to all the samples at once. Samples outside of min/max
+  // are masked below, so their noise is discarded.
+  if (noise)
+  {
+    this->noisyRanges = this->sampleRanges;
+    noise->ApplyBatch(this->noisyRanges);
+  }
+
+  for (size_t i = 0; i < this->sampleRanges.size(); ++i)
+  {
+    double range = this->sampleRanges[i];
+
+    // Mask ranges outside of min/max to +/- inf, as per REP 117
+    if (range >= rangeMax)
+    {
+      range = GZ_DBL_INF;
+    }
+    else if (range <= rangeMin)
+    {
+      range = -GZ_DBL_INF;
+    }
+    else if (noise)
+    {
+      range = ignition::math::clamp(this->noisyRanges[i], rangeMin, rangeMax);
+    }
+
+    scan->add_ranges(range);
+  }
+
+  std::shared_ptr<SensorHistory<msgs::LaserScanStamped> > samples =
+    std::atomic_load(&this->history);
+  if (samples)
+    samples->Push(this->lastMeasurementTime, this->laserMsg);
+
   if (this->scanPub && this->scanPub->HasConnections())
     this->scanPub->Publish(this->laserMsg);
 
@@ -528,5 +561,36 @@ bool RaySensor::UpdateImpl(bool /*_force*/)
 bool RaySensor::IsActive()
 {
   return Sensor::IsActive() ||
-    (this->scanPub && this->scanPub->HasConnections());
+    (this->scanPub && this->scanPub->HasConnections()) ||
+    std::atomic_load(&this->history) != NULL;
+}
+
+//////////////////////////////////////////////////
+void RaySensor::EnableHistory(unsigned int _capacity)
+{
+  std::atomic_store(&this->history,
+      std::shared_ptr<SensorHistory<msgs::LaserScanStamped> >(
+        new SensorHistory<msgs::LaserScanStamped>(_capacity)));
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const SensorHistory<msgs::LaserScanStamped> >
+RaySensor::History() const
+{
+  return std::atomic_load(&this->history);
+}
+
+//////////////////////////////////////////////////
+bool RaySensor::FillReadingMsg(msgs::SensorReading &_msg)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  // Nothing is measured before the first update.
+  if (!this->laserMsg.IsInitialized())
+    return false;
+
+  _msg.set_name(this->GetScopedName());
+  _msg.mutable_time()->CopyFrom(this->laserMsg.time());
+  _msg.set_type(this->laserMsg.GetTypeName());
+  this->laserMsg.SerializeToString(_msg.mutable_data());
+  return true;
 }
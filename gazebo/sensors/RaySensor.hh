@@ -17,6 +17,7 @@
 #ifndef _GAZEBO_RAYSENSOR_HH_
 #define _GAZEBO_RAYSENSOR_HH_
 
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -27,6 +28,7 @@
 #include "gazebo/math/Pose.hh"
 #include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorHistory.hh"
 #include "gazebo/util/system.hh"
 
 namespace gazebo
@@ -189,9 +191,22 @@ namespace gazebo
       public: physics::MultiRayShapePtr GetLaserShape() const
               {return this->laserShape;}
 
+      /// \brief Keep a history of the sensor's scans, for in-process
+      /// readers. Replaces any previous history.
+      /// \param[in] _capacity Number of samples kept.
+      public: void EnableHistory(unsigned int _capacity);
+
+      /// \brief Get the history of the sensor's scans.
+      /// \return The history, or NULL if EnableHistory has not been called.
+      public: std::shared_ptr<const SensorHistory<msgs::LaserScanStamped> >
+              History() const;
+
       // Documentation inherited
       public: virtual bool IsActive();
 
+      // Documentation inherited.
+      public: virtual bool FillReadingMsg(msgs::SensorReading &_msg);
+
       private: physics::CollisionPtr laserCollision;
       private: physics::MultiRayShapePtr laserShape;
       private: physics::EntityPtr parentEntity;
@@ -199,6 +214,24 @@ namespace gazebo
       private: transport::PublisherPtr scanPub;
       private: boost::mutex mutex;
       private: msgs::LaserScanStamped laserMsg;
+
+      /// \brief Range of each ray from the last update.
+      private: std::vector<double> rayRanges;
+
+      /// \brief Retro value of each ray from the last update.
+      private: std::vector<double> rayRetros;
+
+      /// \brief Fiducial value of each ray from the last update.
+      private: std::vector<int> rayFiducials;
+
+      /// \brief Interpolated range of each sample, before noise.
+      private: std::vector<double> sampleRanges;
+
+      /// \brief Range of each sample with noise applied.
+      private: std::vector<double> noisyRanges;
+
+      /// \brief History of samples, NULL unless enabled.
+      private: std::shared_ptr<SensorHistory<msgs::LaserScanStamped> > history;
     };
     /// \}
   }
@@ -21,6 +21,7 @@
 #endif
 
 #include <sdf/sdf.hh>
+#include <ignition/math/Rand.hh>
 
 #include "gazebo/transport/transport.hh"
 
@@ -42,12 +43,34 @@
 #include "gazebo/sensors/Noise.hh"
 #include "gazebo/sensors/Sensor.hh"
 #include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/sensors/SensorsIface.hh"
 
 using namespace gazebo;
 using namespace sensors;
 
 sdf::ElementPtr Sensor::sdfSensor;
 
+//////////////////////////////////////////////////
+/// \brief Get the seed of a sensor's noise model. The seed only depends
+/// on the world seed, the sensor's name and the noise type, so it is the
+/// same for every run with the same world seed.
+/// \param[in] _name Scoped name of the sensor.
+/// \param[in] _noiseType Type of the noise model in the sensor.
+/// \return The seed.
+static uint64_t noiseSeed(const std::string &_name, int _noiseType)
+{
+  // FNV-1a hash of the world seed, the name and the noise type.
+  uint64_t hash = 14695981039346656037ULL;
+  uint64_t prime = 1099511628211ULL;
+
+  hash = (hash ^ ignition::math::Rand::Seed()) * prime;
+  for (auto const &c : _name)
+    hash = (hash ^ static_cast<unsigned char>(c)) * prime;
+  hash = (hash ^ static_cast<uint64_t>(_noiseType)) * prime;
+
+  return hash;
+}
+
 //////////////////////////////////////////////////
 Sensor::Sensor(SensorCategory _cat)
 {
@@ -68,6 +91,13 @@ Sensor::Sensor(SensorCategory _cat)
   this->updateDelay = common::Time(0.0);
   this->updatePeriod = common::Time(0.0);
 
+  this->updateCount = 0;
+  this->missedCount = 0;
+
+  this->lazy = false;
+  this->idle = false;
+  this->skippedCount = 0;
+
   this->id = physics::getUniqueId();
 }
 
@@ -103,6 +133,8 @@ void Sensor::Load(const std::string &_worldName)
   if (this->sdf->Get<bool>("always_on"))
     this->SetActive(true);
 
+  this->lazy = sensors::lazy_activation();
+
   this->world = physics::get_world(_worldName);
 
   if (this->category == IMAGE)
@@ -120,6 +152,14 @@ void Sensor::Init()
 {
   this->SetUpdateRate(this->sdf->Get<double>("update_rate"));
 
+  // Give each noise model its own random number stream, so that noise is
+  // reproducible regardless of the order in which sensors are updated.
+  for (auto const &noise : this->noises)
+  {
+    if (noise.second)
+      noise.second->SetSeed(noiseSeed(this->GetScopedName(), noise.first));
+  }
+
   // Load the plugins
   if (this->sdf->HasElement("plugin"))
   {
@@ -183,14 +223,14 @@ bool Sensor::NeedsUpdate()
 //////////////////////////////////////////////////
 void Sensor::Update(bool _force)
 {
+  common::Time simTime;
+  if (this->category == IMAGE && this->scene)
+    simTime = this->scene->GetSimTime();
+  else
+    simTime = this->world->GetSimTime();
+
   if (this->IsActive() || _force)
   {
-    common::Time simTime;
-    if (this->category == IMAGE && this->scene)
-      simTime = this->scene->GetSimTime();
-    else
-      simTime = this->world->GetSimTime();
-
     {
       boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
 
@@ -207,6 +247,22 @@ void Sensor::Update(bool _force)
       if (adjustedElapsed < this->updatePeriod && !_force)
         return;
 
+      // Deadline accounting. An update is due one period after the last
+      // one, less the delay being caught up, so the lateness is the amount
+      // by which the adjusted elapsed time overshoots the period. The
+      // first update after being idle is not late.
+      if (this->updatePeriod > common::Time::Zero &&
+          this->lastUpdateTime > common::Time::Zero && !this->idle)
+      {
+        common::Time lateness = std::max(common::Time::Zero,
+            adjustedElapsed - this->updatePeriod);
+        this->totalLateness += lateness;
+        this->maxLateness = std::max(this->maxLateness, lateness);
+        if (lateness >= this->updatePeriod)
+          this->missedCount++;
+      }
+      this->updateCount++;
+
       this->updateDelay = std::max(common::Time::Zero,
           adjustedElapsed - this->updatePeriod);
 
@@ -214,17 +270,42 @@ void Sensor::Update(bool _force)
       // to catch up. This happens normally when the sensor just changed from
       // an inactive to an active state, or the sensor just cannot hit its
       // target update rate (worst case).
-      if (this->updateDelay >= this->updatePeriod)
+      if (this->updateDelay >= this->updatePeriod || this->idle)
         this->updateDelay = common::Time::Zero;
+
+      this->idle = false;
     }
 
-    if (this->UpdateImpl(_force))
+    common::Time startTime = common::Time::GetWallTime();
+    bool result = this->UpdateImpl(_force);
+    common::Time updateTime = common::Time::GetWallTime() - startTime;
+
+    boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
+    this->updateWallTime += updateTime;
+    if (result)
     {
-      boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
       this->lastUpdateTime = simTime;
       this->updated();
     }
   }
+  else if (this->active && this->lazy)
+    this->SkipUpdate(simTime);
+}
+
+//////////////////////////////////////////////////
+void Sensor::SkipUpdate(const common::Time &_simTime)
+{
+  boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
+
+  // Count one skipped update per update period, as the sensor would have
+  // updated had it been consumed.
+  if (!this->idle || (_simTime > this->lastSkipTime &&
+      _simTime - this->lastSkipTime >= this->updatePeriod))
+  {
+    this->skippedCount++;
+    this->lastSkipTime = _simTime;
+  }
+  this->idle = true;
 }
 
 //////////////////////////////////////////////////
@@ -283,7 +364,29 @@ void Sensor::SetActive(bool _value)
 //////////////////////////////////////////////////
 bool Sensor::IsActive()
 {
-  return this->active;
+  if (!this->lazy || !this->active)
+    return this->active;
+
+  return !this->plugins.empty() || this->updated.ConnectionCount() > 0;
+}
+
+//////////////////////////////////////////////////
+void Sensor::SetLazy(bool _lazy)
+{
+  this->lazy = _lazy;
+}
+
+//////////////////////////////////////////////////
+bool Sensor::IsLazy() const
+{
+  return this->lazy;
+}
+
+//////////////////////////////////////////////////
+uint64_t Sensor::GetSkippedCount()
+{
+  boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
+  return this->skippedCount;
 }
 
 //////////////////////////////////////////////////
@@ -508,3 +611,44 @@ void Sensor::ResetLastUpdateTime()
   boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
   this->lastUpdateTime = 0.0;
 }
+
+//////////////////////////////////////////////////
+common::Time Sensor::GetNextUpdateTime()
+{
+  boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
+  return this->lastUpdateTime + this->updatePeriod - this->updateDelay;
+}
+
+//////////////////////////////////////////////////
+void Sensor::FillStatisticsMsg(msgs::SensorStatistics::Timing &_msg)
+{
+  boost::mutex::scoped_lock lock(this->mutexLastUpdateTime);
+
+  _msg.set_name(this->GetScopedName());
+  _msg.set_update_rate(this->updatePeriod > common::Time::Zero ?
+      1.0 / this->updatePeriod.Double() : 0.0);
+  _msg.set_update_count(this->updateCount);
+  _msg.set_missed_count(this->missedCount);
+
+  common::Time mean;
+  if (this->updateCount > 0)
+    mean.Set(this->totalLateness.Double() / this->updateCount);
+  msgs::Set(_msg.mutable_mean_lateness(), mean);
+  msgs::Set(_msg.mutable_max_lateness(), this->maxLateness);
+
+  // The time saved by skipped updates is estimated from the mean wall time
+  // of the updates that ran.
+  common::Time meanUpdateTime;
+  if (this->updateCount > 0)
+    meanUpdateTime.Set(this->updateWallTime.Double() / this->updateCount);
+  _msg.set_skipped_count(this->skippedCount);
+  msgs::Set(_msg.mutable_mean_update_time(), meanUpdateTime);
+  msgs::Set(_msg.mutable_saved_time(),
+      common::Time(meanUpdateTime.Double() * this->skippedCount));
+}
+
+//////////////////////////////////////////////////
+bool Sensor::FillReadingMsg(msgs::SensorReading &/*_msg*/)
+{
+  return false;
+}
@@ -152,10 +152,29 @@ namespace gazebo
       /// \param[in] _value True if active, false if not.
       public: virtual void SetActive(bool _value);
 
-      /// \brief Returns true if sensor generation is active.
+      /// \brief Returns true if sensor generation is active. A lazy
+      /// sensor is only active while something consumes its data: a
+      /// plugin, a connection to the updated signal, or, as added by
+      /// derived sensors, a topic subscriber or history reader.
       /// \return True if active, false if not.
       public: virtual bool IsActive();
 
+      /// \brief Set whether the sensor is lazy. A lazy sensor skips its
+      /// updates, including any noise sampling, while nothing consumes its
+      /// data, and resumes on the next update after a consumer appears.
+      /// \param[in] _lazy True to make the sensor lazy.
+      /// \sa set_lazy_activation
+      public: void SetLazy(bool _lazy);
+
+      /// \brief Get whether the sensor is lazy.
+      /// \return True if the sensor is lazy.
+      public: bool IsLazy() const;
+
+      /// \brief Get the number of updates skipped because the sensor was
+      /// lazy and nothing consumed its data.
+      /// \return Number of skipped updates.
+      public: uint64_t GetSkippedCount();
+
       /// \brief Get sensor type.
       /// \return Type of sensor.
       public: std::string GetType() const;
@@ -181,6 +200,12 @@ namespace gazebo
       /// \param[out] _msg Message to fill.
       public: void FillMsg(msgs::Sensor &_msg);
 
+      /// \brief Fill a message with the latest reading of the sensor.
+      /// \param[out] _msg Message to fill.
+      /// \return False if the sensor does not provide its readings as a
+      /// message.
+      public: virtual bool FillReadingMsg(msgs::SensorReading &_msg);
+
       /// \brief Returns the name of the world the sensor is in.
       /// \return Name of the world.
       public: std::string GetWorldName() const;
@@ -208,6 +233,16 @@ namespace gazebo
       /// \brief Reset the lastUpdateTime to zero.
       public: void ResetLastUpdateTime();
 
+      /// \brief Get the simulation time at which the sensor is next due
+      /// to update. This accounts for any delay the sensor is catching up.
+      /// \return Time of the next update.
+      public: common::Time GetNextUpdateTime();
+
+      /// \brief Fill a message with the sensor's update deadline
+      /// statistics.
+      /// \param[out] _msg Message to fill.
+      public: void FillStatisticsMsg(msgs::SensorStatistics::Timing &_msg);
+
       /// \brief Get the sensor's ID.
       /// \return The sensor's ID.
       public: uint32_t GetId() const;
@@ -235,6 +270,10 @@ namespace gazebo
       /// \return True when sensor should be updated.
       protected: bool NeedsUpdate();
 
+      /// \brief Count an update skipped while the sensor is idle.
+      /// \param[in] _simTime Current simulation time.
+      private: void SkipUpdate(const common::Time &_simTime);
+
       /// \brief Load a plugin for this sensor.
       /// \param[in] _sdf SDF parameters.
       private: void LoadPlugin(sdf::ElementPtr _sdf);
@@ -309,6 +348,34 @@ namespace gazebo
       /// \brief Keep track how much the update has been delayed.
       private: common::Time updateDelay;
 
+      /// \brief Number of updates, used for deadline statistics.
+      private: uint64_t updateCount;
+
+      /// \brief Number of updates that were a full period or more late.
+      private: uint64_t missedCount;
+
+      /// \brief Sum of the time by which updates missed their deadline.
+      private: common::Time totalLateness;
+
+      /// \brief Largest time by which an update missed its deadline.
+      private: common::Time maxLateness;
+
+      /// \brief Wall time spent in UpdateImpl.
+      private: common::Time updateWallTime;
+
+      /// \brief True if the sensor skips updates while nothing consumes
+      /// its data.
+      private: bool lazy;
+
+      /// \brief True while a lazy sensor is skipping updates.
+      private: bool idle;
+
+      /// \brief Number of updates skipped while idle.
+      private: uint64_t skippedCount;
+
+      /// \brief Simulation time of the last skipped update.
+      private: common::Time lastSkipTime;
+
       /// \brief The sensors unique ID.
       private: uint32_t id;
 
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef _GAZEBO_SENSOR_HISTORY_HH_
+#define _GAZEBO_SENSOR_HISTORY_HH_
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "gazebo/common/Time.hh"
+
+namespace gazebo
+{
+  namespace sensors
+  {
+    /// \addtogroup gazebo_sensors
+    /// \{
+
+    /// \class SensorHistory SensorHistory.hh sensors/sensors.hh
+    /// \brief A fixed capacity ring buffer of time stamped sensor samples.
+    ///
+    /// A sensor pushes a sample on each update, and in-process consumers
+    /// read the latest samples without subscribing to the sensor's topic.
+    /// Samples are immutable once pushed and are shared with the readers,
+    /// and a sample stays valid for as long as a reader holds it.
+    ///
+    /// The slots are accessed with std::atomic_load and std::atomic_store.
+    /// These are not lock-free for shared pointers: libstdc++ guards them
+    /// with a small pool of mutexes. A reader and the sensor may therefore
+    /// wait on each other, but only while a pointer is copied, never while
+    /// a sample is built or read.
+    ///
+    /// Push must only be called by one thread at a time, the sensor's
+    /// update thread. Latest and Since may be called from any thread.
+    template<typename T>
+    class SensorHistory
+    {
+      /// \brief A time stamped sample.
+      public: class Sample
+      {
+        /// \brief Simulation time of the sample.
+        public: common::Time time;
+
+        /// \brief Sample data.
+        public: T data;
+      };
+
+      /// \brief Shared pointer to a sample.
+      public: typedef std::shared_ptr<const Sample> SamplePtr;
+
+      /// \brief Constructor.
+      /// \param[in] _capacity Maximum number of samples kept. At least one
+      /// sample is kept.
+      public: explicit SensorHistory(unsigned int _capacity)
+              : samples(std::max(1u, _capacity)), count(0)
+      {
+      }
+
+      /// \brief Get the maximum number of samples kept.
+      /// \return The capacity.
+      public: unsigned int GetCapacity() const
+      {
+        return this->samples.size();
+      }
+
+      /// \brief Add a sample, replacing the oldest one if the buffer is
+      /// full.
+      /// \param[in] _time Simulation time of the sample.
+      /// \param[in] _data Sample data.
+      public: void Push(const common::Time &_time, const T &_data)
+      {
+        std::shared_ptr<Sample> sample(new Sample);
+        sample->time = _time;
+        sample->data = _data;
+
+        uint64_t index = this->count.load(std::memory_order_relaxed);
+        std::atomic_store(&this->samples[index % this->samples.size()],
+            SamplePtr(sample));
+        this->count.store(index + 1, std::memory_order_release);
+      }
+
+      /// \brief Get the latest sample.
+      /// \return The latest sample, or NULL if there is none.
+      public: SamplePtr Latest() const
+      {
+        uint64_t index = this->count.load(std::memory_order_acquire);
+        if (index == 0)
+          return SamplePtr();
+        return std::atomic_load(
+            &this->samples[(index - 1) % this->samples.size()]);
+      }
+
+      /// \brief Get the samples newer than a time, oldest first.
+      /// \param[in] _time Samples stamped after this time are returned.
+      /// \return The samples still in the buffer that are newer than _time.
+      public: std::vector<SamplePtr> Since(const common::Time &_time) const
+      {
+        std::vector<SamplePtr> result;
+
+        uint64_t index = this->count.load(std::memory_order_acquire);
+        uint64_t capacity = this->samples.size();
+        uint64_t oldest = index > capacity ? index - capacity : 0;
+
+        // Walk back from the latest sample. A sample that is newer than
+        // the previous one read has been overwritten by Push meanwhile,
+        // and so have all older slots.
+        while (index > oldest)
+        {
+          --index;
+          SamplePtr sample =
+            std::atomic_load(&this->samples[index % capacity]);
+          if (!sample || sample->time <= _time ||
+              (!result.empty() && sample->time > result.back()->time))
+          {
+            break;
+          }
+          result.push_back(sample);
+        }
+
+        std::reverse(result.begin(), result.end());
+        return result;
+      }
+
+      /// \brief Ring buffer of samples.
+      private: std::vector<SamplePtr> samples;
+
+      /// \brief Number of samples pushed so far.
+      private: std::atomic<uint64_t> count;
+    };
+    /// \}
+  }
+}
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2015 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <boost/thread.hpp>
+
+#include "test/util.hh"
+#include "gazebo/sensors/SensorHistory.hh"
+
+using namespace gazebo;
+
+class SensorHistoryTest : public gazebo::testing::AutoLogFixture { };
+
+/////////////////////////////////////////////////
+TEST_F(SensorHistoryTest, Empty)
+{
+  sensors::SensorHistory<int> history(0);
+  EXPECT_EQ(history.GetCapacity(), 1u);
+  EXPECT_TRUE(history.Latest() == NULL);
+  EXPECT_TRUE(history.Since(common::Time::Zero).empty());
+}
+
+/////////////////////////////////////////////////
+TEST_F(SensorHistoryTest, LatestAndSince)
+{
+  sensors::SensorHistory<int> history(4);
+
+  history.Push(common::Time(1), 10);
+  ASSERT_TRUE(history.Latest() != NULL);
+  EXPECT_EQ(history.Latest()->data, 10);
+
+  for (int i = 2; i <= 6; ++i)
+    history.Push(common::Time(i), i * 10);
+
+  EXPECT_EQ(history.Latest()->time, common::Time(6));
+  EXPECT_EQ(history.Latest()->data, 60);
+
+  // Only the last four samples are kept, oldest first.
+  std::vector<sensors::SensorHistory<int>::SamplePtr> samples =
+    history.Since(common::Time::Zero);
+  ASSERT_EQ(samples.size(), 4u);
+  for (unsigned int i = 0; i < samples.size(); ++i)
+    EXPECT_EQ(samples[i]->data, static_cast<int>(i + 3) * 10);
+
+  samples = history.Since(common::Time(4));
+  ASSERT_EQ(samples.size(), 2u);
+  EXPECT_EQ(samples[0]->data, 50);
+  EXPECT_EQ(samples[1]->data, 60);
+
+  EXPECT_TRUE(history.Since(common::Time(6)).empty());
+}
+
+/////////////////////////////////////////////////
+/// \brief Push samples with increasing times and values.
+void pushSamples(sensors::SensorHistory<int> *_history, int _count)
+{
+  for (int i = 1; i <= _count; ++i)
+    _history->Push(common::Time(0, i), i);
+}
+
+/////////////////////////////////////////////////
+// Readers running alongside the writer always see ordered samples.
+TEST_F(SensorHistoryTest, ConcurrentRead)
+{
+  sensors::SensorHistory<int> history(8);
+  boost::thread writer(boost::bind(&pushSamples, &history, 100000));
+
+  int last = 0;
+  while (last < 100000)
+  {
+    std::vector<sensors::SensorHistory<int>::SamplePtr> samples =
+      history.Since(common::Time::Zero);
+    for (unsigned int i = 0; i < samples.size(); ++i)
+    {
+      EXPECT_EQ(samples[i]->time, common::Time(0, samples[i]->data));
+      if (i > 0)
+        EXPECT_GT(samples[i]->data, samples[i-1]->data);
+    }
+    if (!samples.empty())
+    {
+      EXPECT_GE(samples.back()->data, last);
+      last = samples.back()->data;
+    }
+  }
+
+  writer.join();
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -20,9 +20,23 @@
   #include <Winsock2.h>
 #endif
 
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/atomic.h>
+#include <tbb/task_scheduler_init.h>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <boost/bind.hpp>
+#include <boost/thread/tss.hpp>
 #include "gazebo/common/Assert.hh"
 #include "gazebo/common/Time.hh"
+#include "gazebo/transport/Node.hh"
+#include "gazebo/transport/Publisher.hh"
 
 #include "gazebo/physics/PhysicsIface.hh"
 #include "gazebo/physics/PhysicsEngine.hh"
@@ -39,6 +53,146 @@ using namespace sensors;
 /// for timing coordination.
 boost::mutex g_sensorTimingMutex;
 
+/// \brief Physics engines that the current thread has been initialized
+/// for. Sensors of different worlds may run on the same thread. Weak
+/// pointers are held, so that an engine created at the address of a
+/// removed one is initialized again.
+static boost::thread_specific_ptr<
+    std::vector<boost::weak_ptr<physics::PhysicsEngine> > >
+    g_sensorThreadEngines;
+
+/// \brief A sensor and the simulation time at which it is due to update.
+typedef std::pair<common::Time, SensorPtr> DueSensor;
+
+/////////////////////////////////////////////////
+/// \brief Initialize the current thread for use by a physics engine, once
+/// per engine.
+/// \param[in] _engine The physics engine.
+static void initSensorThread(const physics::PhysicsEnginePtr &_engine)
+{
+  if (!_engine)
+    return;
+
+  if (!g_sensorThreadEngines.get())
+  {
+    g_sensorThreadEngines.reset(
+        new std::vector<boost::weak_ptr<physics::PhysicsEngine> >());
+  }
+
+  std::vector<boost::weak_ptr<physics::PhysicsEngine> > &engines =
+    *g_sensorThreadEngines;
+  for (size_t i = 0; i < engines.size();)
+  {
+    physics::PhysicsEnginePtr engine = engines[i].lock();
+    if (engine == _engine)
+      return;
+
+    // Forget the engines of removed worlds.
+    if (!engine)
+    {
+      engines[i] = engines.back();
+      engines.pop_back();
+    }
+    else
+      ++i;
+  }
+
+  _engine->InitForThread();
+  engines.push_back(_engine);
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the worlds of a list of sensors. Sensors whose world has
+/// been removed are skipped.
+/// \param[in] _sensors The sensors.
+/// \param[out] _worlds The worlds of the sensors, by name.
+static void sensorWorlds(const Sensor_V &_sensors,
+    std::map<std::string, physics::WorldPtr> &_worlds)
+{
+  physics::World_V worlds = physics::get_worlds();
+  for (Sensor_V::const_iterator iter = _sensors.begin();
+       iter != _sensors.end(); ++iter)
+  {
+    std::string worldName = (*iter)->GetWorldName();
+    if (_worlds.find(worldName) != _worlds.end())
+      continue;
+
+    for (physics::World_V::iterator world = worlds.begin();
+         world != worlds.end(); ++world)
+    {
+      if ((*world)->GetName() == worldName)
+      {
+        _worlds[worldName] = *world;
+        break;
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+static bool dueEarlier(const DueSensor &_a, const DueSensor &_b)
+{
+  return _a.first < _b.first;
+}
+
+/////////////////////////////////////////////////
+/// \brief Whether a sensor has to be updated on the sensor thread instead
+/// of the worker pool. The wireless sensors draw from the global
+/// ignition::math::Rand generator, which is not thread-safe, and a
+/// receiver casts rays through the transmitters that it reads.
+/// \param[in] _sensor The sensor.
+/// \return True if the sensor is updated serially.
+static bool serialSensor(const SensorPtr &_sensor)
+{
+  std::string type = _sensor->GetType();
+  return type == "wireless_transmitter" || type == "wireless_receiver";
+}
+
+/// \brief Updates sensors on the TBB worker pool. Each task repeatedly
+/// takes the next sensor from a shared counter, so sensors are dispatched
+/// in list order, which is sorted by due time, and a slow sensor does not
+/// hold back the sensors queued behind it.
+class SensorUpdate_TBB
+{
+  /// \brief Constructor.
+  /// \param[in] _sensors Sensors to update, earliest due first.
+  /// \param[in] _next Index of the next sensor to dispatch.
+  /// \param[in] _engines Physics engine of each sensor's world, used to
+  /// initialize worker threads.
+  /// \param[in] _force True to force the sensors to update.
+  public: SensorUpdate_TBB(const Sensor_V *_sensors,
+              tbb::atomic<size_t> *_next,
+              const std::vector<physics::PhysicsEnginePtr> *_engines,
+              bool _force)
+          : sensors(_sensors), next(_next), engines(_engines),
+            force(_force) {}
+
+  /// \brief Dispatch sensors until none are left.
+  /// \param[in] _r Unused; one task is created per worker.
+  public: void operator() (const tbb::blocked_range<size_t> &/*_r*/) const
+  {
+    size_t i;
+    while ((i = this->next->fetch_and_increment()) < this->sensors->size())
+    {
+      // Sensors may query the physics engine, which needs per-thread data.
+      initSensorThread((*this->engines)[i]);
+      (*this->sensors)[i]->Update(this->force);
+    }
+  }
+
+  /// \brief Sensors to update.
+  private: const Sensor_V *sensors;
+
+  /// \brief Index of the next sensor to dispatch.
+  private: tbb::atomic<size_t> *next;
+
+  /// \brief Physics engine of each sensor's world.
+  private: const std::vector<physics::PhysicsEnginePtr> *engines;
+
+  /// \brief True to force the sensors to update.
+  private: bool force;
+};
+
 //////////////////////////////////////////////////
 SensorManager::SensorManager()
   : initialized(false), removeAllSensors(false)
@@ -47,15 +201,20 @@ SensorManager::SensorManager()
   this->sensorContainers.push_back(new ImageSensorContainer());
 
   // sensors::RAY container
-  this->sensorContainers.push_back(new SensorContainer());
+  this->sensorContainers.push_back(new SensorContainer(true));
 
   // sensors::OTHER container
-  this->sensorContainers.push_back(new SensorContainer());
+  this->sensorContainers.push_back(new SensorContainer(true));
+
+  this->worldRemovedConnection = event::Events::ConnectWorldRemoved(
+      boost::bind(&SensorManager::OnWorldRemoved, this, _1));
 }
 
 //////////////////////////////////////////////////
 SensorManager::~SensorManager()
 {
+  this->worldRemovedConnection.reset();
+
   // Clean up the sensors.
   for (SensorContainer_V::iterator iter = this->sensorContainers.begin();
        iter != this->sensorContainers.end(); ++iter)
@@ -157,6 +316,95 @@ void SensorManager::Update(bool _force)
   // Only update if there are sensors
   if (this->sensorContainers[sensors::IMAGE]->sensors.size() > 0)
     this->sensorContainers[sensors::IMAGE]->Update(_force);
+
+  this->PublishStatistics();
+}
+
+//////////////////////////////////////////////////
+void SensorManager::PublishStatistics()
+{
+  common::Time wallTime = common::Time::GetWallTime();
+  if (wallTime - this->prevStatsTime < common::Time(1, 0))
+    return;
+  this->prevStatsTime = wallTime;
+
+  physics::World_V worlds = physics::get_worlds();
+  if (worlds.empty())
+    return;
+
+  if (!this->node)
+  {
+    this->node.reset(new transport::Node());
+    this->node->Init(worlds[0]->GetName());
+  }
+
+  // Drop the publishers of removed worlds.
+  std::map<std::string, transport::PublisherPtr> statsPubs;
+  for (physics::World_V::iterator iter = worlds.begin();
+       iter != worlds.end(); ++iter)
+  {
+    statsPubs[(*iter)->GetName()] = this->statsPubs[(*iter)->GetName()];
+  }
+  this->statsPubs.swap(statsPubs);
+
+  // Each world publishes the statistics of its own sensors.
+  for (physics::World_V::iterator iter = worlds.begin();
+       iter != worlds.end(); ++iter)
+  {
+    std::string worldName = (*iter)->GetName();
+    transport::PublisherPtr &pub = this->statsPubs[worldName];
+    if (!pub)
+    {
+      pub = this->node->Advertise<msgs::SensorStatistics>(
+          "/gazebo/" + worldName + "/sensor/statistics");
+    }
+
+    if (!pub->HasConnections())
+      continue;
+
+    msgs::SensorStatistics msg;
+    this->FillStatisticsMsg(worldName, msg);
+    pub->Publish(msg);
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::FillStatisticsMsg(msgs::SensorStatistics &_msg) const
+{
+  physics::WorldPtr world = physics::get_world();
+  msgs::Set(_msg.mutable_sim_time(),
+      world ? world->GetSimTime() : common::Time::Zero);
+
+  Sensor_V sensors = this->GetSensors();
+  for (Sensor_V::iterator iter = sensors.begin(); iter != sensors.end();
+       ++iter)
+  {
+    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
+    (*iter)->FillStatisticsMsg(*_msg.add_sensor());
+  }
+}
+
+//////////////////////////////////////////////////
+void SensorManager::FillStatisticsMsg(const std::string &_worldName,
+    msgs::SensorStatistics &_msg) const
+{
+  physics::World_V worlds = physics::get_worlds();
+  physics::World_V::iterator world = worlds.begin();
+  while (world != worlds.end() && (*world)->GetName() != _worldName)
+    ++world;
+  if (world == worlds.end())
+    return;
+
+  msgs::Set(_msg.mutable_sim_time(), (*world)->GetSimTime());
+
+  Sensor_V sensors = this->GetSensors();
+  for (Sensor_V::iterator iter = sensors.begin(); iter != sensors.end();
+       ++iter)
+  {
+    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
+    if ((*iter)->GetWorldName() == _worldName)
+      (*iter)->FillStatisticsMsg(*_msg.add_sensor());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -213,6 +461,11 @@ void SensorManager::Fini()
 
   this->removeSensors.clear();
 
+  this->statsPubs.clear();
+  if (this->node)
+    this->node->Fini();
+  this->node.reset();
+
   delete this->simTimeEventHandler;
   this->simTimeEventHandler = NULL;
 
@@ -341,6 +594,11 @@ void SensorManager::RemoveSensor(const std::string &_name)
 
   if (!sensor)
   {
+    // The sensors of a removed world are removed before its links ask
+    // for it.
+    if (this->worldRemovedSensors.erase(_name) > 0)
+      return;
+
     gzerr << "Unable to remove sensor[" << _name << "] because it "
           << "does not exist.\n";
   }
@@ -360,8 +618,54 @@ void SensorManager::RemoveSensors()
 }
 
 //////////////////////////////////////////////////
-SensorManager::SensorContainer::SensorContainer()
+void SensorManager::OnWorldRemoved(const std::string &_worldName)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  // Sensors that were never initialized can be dropped right away.
+  for (Sensor_V::iterator iter = this->initSensors.begin();
+       iter != this->initSensors.end();)
+  {
+    GZ_ASSERT((*iter) != NULL, "Sensor pointer is NULL");
+    if ((*iter)->GetWorldName() == _worldName)
+      iter = this->initSensors.erase(iter);
+    else
+      ++iter;
+  }
+
+  // The world is finalized once this returns, so the sensors that run in
+  // the sensor threads are removed now. This waits for an update in
+  // progress to finish.
+  for (SensorContainer_V::iterator iter = ++this->sensorContainers.begin();
+       iter != this->sensorContainers.end(); ++iter)
+  {
+    GZ_ASSERT((*iter) != NULL, "SensorContainer is NULL");
+    Sensor_V &sensors = (*iter)->sensors;
+    for (Sensor_V::iterator sensor = sensors.begin();
+         sensor != sensors.end(); ++sensor)
+    {
+      if ((*sensor)->GetWorldName() == _worldName)
+        this->worldRemovedSensors.insert((*sensor)->GetScopedName());
+    }
+    (*iter)->RemoveSensors(_worldName);
+  }
+
+  // Image sensors use rendering resources, and are removed by the main
+  // thread. They do not use the physics engine.
+  Sensor_V &imageSensors = this->sensorContainers[sensors::IMAGE]->sensors;
+  for (Sensor_V::iterator iter = imageSensors.begin();
+       iter != imageSensors.end(); ++iter)
+  {
+    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
+    if ((*iter)->GetWorldName() == _worldName)
+      this->removeSensors.push_back((*iter)->GetScopedName());
+  }
+}
+
+//////////////////////////////////////////////////
+SensorManager::SensorContainer::SensorContainer(bool _parallel)
 {
+  this->parallel = _parallel;
   this->stop = true;
   this->initialized = false;
   this->runThread = NULL;
@@ -438,14 +742,6 @@ void SensorManager::SensorContainer::RunLoop()
 {
   this->stop = false;
 
-  physics::WorldPtr world = physics::get_world();
-  GZ_ASSERT(world != NULL, "Pointer to World is NULL");
-
-  physics::PhysicsEnginePtr engine = world->GetPhysicsEngine();
-  GZ_ASSERT(engine != NULL, "Pointer to PhysicsEngine is NULL");
-
-  engine->InitForThread();
-
   common::Time sleepTime, startTime, eventTime, diffTime;
   double maxUpdateRate = 0;
 
@@ -490,15 +786,36 @@ void SensorManager::SensorContainer::RunLoop()
         return;
     }
 
+    // Sensors are timed by their own world, which is looked up on each
+    // pass since worlds may be added and removed.
+    std::map<std::string, physics::WorldPtr> worlds;
+    {
+      boost::recursive_mutex::scoped_lock lock(this->mutex);
+      sensorWorlds(this->sensors, worlds);
+    }
+
     // Get the start time of the update.
-    startTime = world->GetSimTime();
+    std::map<std::string, common::Time> startTimes;
+    for (std::map<std::string, physics::WorldPtr>::iterator iter =
+         worlds.begin(); iter != worlds.end(); ++iter)
+    {
+      initSensorThread(iter->second->GetPhysicsEngine());
+      startTimes[iter->first] = iter->second->GetSimTime();
+    }
 
     this->Update(false);
 
     // Compute the time it took to update the sensors.
     // It's possible that the world time was reset during the Update. This
     // would case a negative diffTime. Instead, just use a event time of zero
-    diffTime = std::max(common::Time::Zero, world->GetSimTime() - startTime);
+    diffTime = common::Time::Zero;
+    for (std::map<std::string, physics::WorldPtr>::iterator iter =
+         worlds.begin(); iter != worlds.end(); ++iter)
+    {
+      diffTime = std::max(diffTime,
+          iter->second->GetSimTime() - startTimes[iter->first]);
+    }
+    worlds.clear();
 
     // Set the default sleep time
     eventTime = std::max(common::Time::Zero, sleepTime - diffTime);
@@ -533,6 +850,12 @@ void SensorManager::SensorContainer::Update(bool _force)
   if (this->sensors.empty())
     gzlog << "Updating a sensor container without any sensors.\n";
 
+  if (this->parallel && this->sensors.size() > 1)
+  {
+    this->UpdateParallel(_force);
+    return;
+  }
+
   // Update all the sensors in this container.
   for (Sensor_V::iterator iter = this->sensors.begin();
        iter != this->sensors.end(); ++iter)
@@ -542,6 +865,106 @@ void SensorManager::SensorContainer::Update(bool _force)
   }
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::UpdateParallel(bool _force)
+{
+  std::map<std::string, physics::WorldPtr> worlds;
+  sensorWorlds(this->sensors, worlds);
+
+  // Each sensor is due by the time of its own world.
+  std::map<std::string, common::Time> simTimes;
+  for (std::map<std::string, physics::WorldPtr>::iterator iter =
+       worlds.begin(); iter != worlds.end(); ++iter)
+  {
+    simTimes[iter->first] = iter->second->GetSimTime();
+  }
+
+  // Collect the sensors that are due, so that no task is spent on a
+  // sensor that would return without updating.
+  std::vector<DueSensor> due;
+  due.reserve(this->sensors.size());
+  for (Sensor_V::iterator iter = this->sensors.begin();
+       iter != this->sensors.end(); ++iter)
+  {
+    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
+
+    // An inactive lazy sensor returns from Update at once, after counting
+    // the update it skipped.
+    if (!_force && !(*iter)->IsActive())
+    {
+      if ((*iter)->IsLazy())
+        (*iter)->Update(false);
+      continue;
+    }
+
+    // A sensor whose world is gone is not updated.
+    std::map<std::string, common::Time>::const_iterator simTime =
+      simTimes.find((*iter)->GetWorldName());
+    if (simTime == simTimes.end())
+      continue;
+
+    common::Time nextTime = (*iter)->GetNextUpdateTime();
+    if (_force || nextTime <= simTime->second)
+    {
+      due.push_back(std::make_pair(nextTime, *iter));
+    }
+  }
+
+  if (due.empty())
+    return;
+
+  // Earliest deadline first.
+  std::stable_sort(due.begin(), due.end(), dueEarlier);
+
+  Sensor_V dueSensors;
+  std::vector<physics::PhysicsEnginePtr> engines;
+  Sensor_V serialSensors;
+  dueSensors.reserve(due.size());
+  engines.reserve(due.size());
+  for (std::vector<DueSensor>::iterator iter = due.begin();
+       iter != due.end(); ++iter)
+  {
+    if (serialSensor(iter->second))
+    {
+      serialSensors.push_back(iter->second);
+      continue;
+    }
+
+    dueSensors.push_back(iter->second);
+    engines.push_back(
+        worlds[iter->second->GetWorldName()]->GetPhysicsEngine());
+  }
+
+  // Sensors that are not safe to run concurrently are updated on this
+  // thread, in due order, before any worker task starts.
+  for (Sensor_V::iterator iter = serialSensors.begin();
+       iter != serialSensors.end(); ++iter)
+  {
+    initSensorThread(worlds[(*iter)->GetWorldName()]->GetPhysicsEngine());
+    (*iter)->Update(_force);
+  }
+
+  if (dueSensors.empty())
+    return;
+
+  if (dueSensors.size() == 1)
+  {
+    initSensorThread(engines[0]);
+    dueSensors[0]->Update(_force);
+    return;
+  }
+
+  size_t workers = std::min(dueSensors.size(), static_cast<size_t>(
+        tbb::task_scheduler_init::default_num_threads()));
+
+  tbb::atomic<size_t> next;
+  next = 0;
+
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, workers, 1),
+      SensorUpdate_TBB(&dueSensors, &next, &engines, _force),
+      tbb::simple_partitioner());
+}
+
 //////////////////////////////////////////////////
 SensorPtr SensorManager::SensorContainer::GetSensor(const std::string &_name,
                                                     bool _useLeafName) const
@@ -644,6 +1067,27 @@ void SensorManager::SensorContainer::RemoveSensors()
   this->sensors.clear();
 }
 
+//////////////////////////////////////////////////
+void SensorManager::SensorContainer::RemoveSensors(
+    const std::string &_worldName)
+{
+  boost::recursive_mutex::scoped_lock lock(this->mutex);
+
+  // Remove the sensors of the world
+  for (Sensor_V::iterator iter = this->sensors.begin();
+       iter != this->sensors.end();)
+  {
+    GZ_ASSERT((*iter) != NULL, "Sensor is NULL");
+    if ((*iter)->GetWorldName() == _worldName)
+    {
+      (*iter)->Fini();
+      iter = this->sensors.erase(iter);
+    }
+    else
+      ++iter;
+  }
+}
+
 //////////////////////////////////////////////////
 void SensorManager::ImageSensorContainer::Update(bool _force)
 {
@@ -661,6 +1105,14 @@ void SensorManager::ImageSensorContainer::Update(bool _force)
 
 
 
+/////////////////////////////////////////////////
+/// \brief Heap ordering for SimTimeEvents, which puts the earliest event
+/// at the front of the heap.
+static bool laterEvent(const SimTimeEvent &_a, const SimTimeEvent &_b)
+{
+  return _a.time > _b.time;
+}
+
 /////////////////////////////////////////////////
 SimTimeEventHandler::SimTimeEventHandler()
 {
@@ -671,13 +1123,6 @@ SimTimeEventHandler::SimTimeEventHandler()
 /////////////////////////////////////////////////
 SimTimeEventHandler::~SimTimeEventHandler()
 {
-  // Cleanup the events.
-  for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
-       iter != this->events.end(); ++iter)
-  {
-    GZ_ASSERT(*iter != NULL, "SimTimeEvent is NULL");
-    delete *iter;
-  }
   this->events.clear();
 }
 
@@ -685,44 +1130,86 @@ SimTimeEventHandler::~SimTimeEventHandler()
 void SimTimeEventHandler::AddRelativeEvent(const common::Time &_time,
                                            boost::condition_variable *_var)
 {
-  boost::mutex::scoped_lock lock(this->mutex);
-
-  physics::WorldPtr world = physics::get_world();
-  GZ_ASSERT(world != NULL, "World pointer is NULL");
+  physics::World_V worlds = physics::get_worlds();
+  GZ_ASSERT(!worlds.empty(), "No worlds");
 
-  // Create the new event.
-  SimTimeEvent *event = new SimTimeEvent;
-  event->time = world->GetSimTime() + _time;
-  event->condition = _var;
+  boost::mutex::scoped_lock lock(this->mutex);
 
-  // Add the event to the list.
-  this->events.push_back(event);
+  // Sensors of every world share the condition, so it is notified when
+  // the time is reached in any of the worlds.
+  for (physics::World_V::iterator iter = worlds.begin();
+       iter != worlds.end(); ++iter)
+  {
+    // Create the new event.
+    SimTimeEvent event;
+    event.time = (*iter)->GetSimTime() + _time;
+    event.condition = _var;
+
+    // Add the event to the world's heap.
+    std::vector<SimTimeEvent> &heap = this->events[(*iter)->GetName()];
+    heap.push_back(event);
+    std::push_heap(heap.begin(), heap.end(), laterEvent);
+  }
 }
 
 /////////////////////////////////////////////////
 void SimTimeEventHandler::OnUpdate(const common::UpdateInfo &_info)
 {
+  // Most steps have no expired events. Check the earliest event without
+  // the timing mutex, so those steps do not contend with sensor threads.
+  {
+    boost::mutex::scoped_lock lock(this->mutex);
+    std::map<std::string, std::vector<SimTimeEvent> >::const_iterator
+      heap = this->events.find(_info.worldName);
+    if (heap == this->events.end() || heap->second.empty() ||
+        heap->second.front().time > _info.simTime)
+    {
+      return;
+    }
+  }
+
   boost::mutex::scoped_lock timingLock(g_sensorTimingMutex);
   boost::mutex::scoped_lock lock(this->mutex);
 
-  // Iterate over all the events.
-  for (std::list<SimTimeEvent*>::iterator iter = this->events.begin();
-      iter != this->events.end();)
+  std::vector<SimTimeEvent> &heap = this->events[_info.worldName];
+  std::set<boost::condition_variable *> notified;
+
+  // Pop events that have a time less than or equal to simulation time.
+  while (!heap.empty() && heap.front().time <= _info.simTime)
   {
-    GZ_ASSERT(*iter != NULL, "SimTimeEvent is NULL");
+    GZ_ASSERT(heap.front().condition != NULL,
+        "SimTimeEvent condition is NULL");
+
+    // Notify the event by triggering its condition.
+    heap.front().condition->notify_all();
+    notified.insert(heap.front().condition);
+
+    // Remove the event.
+    std::pop_heap(heap.begin(), heap.end(), laterEvent);
+    heap.pop_back();
+  }
 
-    // Find events that have a time less than or equal to simulation
-    // time.
-    if ((*iter)->time <= _info.simTime)
+  // The notified conditions no longer wait for the other worlds.
+  if (this->events.size() > 1)
+  {
+    for (std::map<std::string, std::vector<SimTimeEvent> >::iterator
+         iter = this->events.begin(); iter != this->events.end(); ++iter)
     {
-      // Notify the event by triggering its condition.
-      (*iter)->condition->notify_all();
+      std::vector<SimTimeEvent> &other = iter->second;
+      size_t size = other.size();
+      for (size_t i = 0; i < other.size();)
+      {
+        if (notified.count(other[i].condition))
+        {
+          other[i] = other.back();
+          other.pop_back();
+        }
+        else
+          ++i;
+      }
 
-      // Remove the event.
-      delete *iter;
-      this->events.erase(iter++);
+      if (other.size() != size)
+        std::make_heap(other.begin(), other.end(), laterEvent);
     }
-    else
-      ++iter;
   }
 }
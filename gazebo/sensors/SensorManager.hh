@@ -18,13 +18,16 @@
 #define _GAZEBO_SENSORMANAGER_HH_
 
 #include <boost/thread.hpp>
+#include <map>
+#include <set>
 #include <string>
 #include <vector>
-#include <list>
 
 #include <sdf/sdf.hh>
 
+#include "gazebo/msgs/msgs.hh"
 #include "gazebo/physics/PhysicsTypes.hh"
+#include "gazebo/transport/TransportTypes.hh"
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/UpdateInfo.hh"
 #include "gazebo/sensors/SensorTypes.hh"
@@ -59,7 +62,8 @@ namespace gazebo
 
       /// \brief Add a new event to the handler.
       /// \param[in] _time Time of the new event. The current sim time will
-      /// be add to this time.
+      /// be add to this time. The condition is notified when the time is
+      /// reached in any of the worlds.
       /// \param[in] _var Condition to notify when the time has been
       /// reached.
       public: void AddRelativeEvent(const common::Time &_time,
@@ -72,8 +76,11 @@ namespace gazebo
       /// \brief Mutex to mantain thread safety.
       private: boost::mutex mutex;
 
-      /// \brief The list of events to handle.
-      private: std::list<SimTimeEvent*> events;
+      /// \brief Pending events of each world, by world name, kept as
+      /// binary min-heaps on event time. Events are stored by value so
+      /// that the vector's storage is reused instead of allocating an
+      /// event per wakeup.
+      private: std::map<std::string, std::vector<SimTimeEvent> > events;
 
       /// \brief Connect to the World::UpdateBegin event.
       private: event::ConnectionPtr updateConnection;
@@ -152,10 +159,29 @@ namespace gazebo
       /// \brief Reset last update times in all sensors.
       public: void ResetLastUpdateTimes();
 
+      /// \brief Fill a message with the update deadline statistics of
+      /// all sensors.
+      /// \param[out] _msg Message to fill.
+      public: void FillStatisticsMsg(msgs::SensorStatistics &_msg) const;
+
+      /// \brief Fill a message with the update deadline statistics of
+      /// the sensors of one world.
+      /// \param[in] _worldName Name of the world.
+      /// \param[out] _msg Message to fill.
+      public: void FillStatisticsMsg(const std::string &_worldName,
+                  msgs::SensorStatistics &_msg) const;
+
       /// \brief Add a new sensor to a sensor container.
       /// \param[in] _sensor Pointer to a sensor to add.
       private: void AddSensor(SensorPtr _sensor);
 
+      /// \brief Publish sensor statistics, at most once a second.
+      private: void PublishStatistics();
+
+      /// \brief Remove the sensors of a world that is being removed.
+      /// \param[in] _worldName Name of the world.
+      private: void OnWorldRemoved(const std::string &_worldName);
+
       /// \cond
       /// \brief A container for sensors of a specific type. This is used to
       /// separate sensors which rely on the rendering engine from those
@@ -165,7 +191,9 @@ namespace gazebo
       private: class SensorContainer
                {
                  /// \brief Constructor
-                 public: SensorContainer();
+                 /// \param[in] _parallel True to update the sensors on
+                 /// the TBB worker pool instead of serially.
+                 public: explicit SensorContainer(bool _parallel = false);
 
                  /// \brief Destructor
                  public: virtual ~SensorContainer();
@@ -207,6 +235,10 @@ namespace gazebo
                  /// \brief Remove all sensors.
                  public: void RemoveSensors();
 
+                 /// \brief Remove and finalize the sensors of a world.
+                 /// \param[in] _worldName Name of the world.
+                 public: void RemoveSensors(const std::string &_worldName);
+
                  /// \brief Reset last update times in all sensors.
                  public: void ResetLastUpdateTimes();
 
@@ -214,12 +246,20 @@ namespace gazebo
                  /// runThread.
                  private: void RunLoop();
 
+                 /// \brief Update the sensors that are due on the TBB
+                 /// worker pool, earliest due first.
+                 /// \param[in] _force True to force all sensors to update.
+                 private: void UpdateParallel(bool _force);
+
                  /// \brief The set of sensors to maintain.
                  public: Sensor_V sensors;
 
                  /// \brief Flag to inidicate when to stop the runThread.
                  private: bool stop;
 
+                 /// \brief True to update sensors on the TBB worker pool.
+                 private: bool parallel;
+
                  /// \brief Flag to indicate that the sensors have been
                  /// initialized.
                  private: bool initialized;
@@ -278,6 +318,22 @@ namespace gazebo
 
       /// \brief Pointer to the sim time event handler.
       private: SimTimeEventHandler *simTimeEventHandler;
+
+      /// \brief Node used to publish sensor statistics.
+      private: transport::NodePtr node;
+
+      /// \brief Publishers of sensor statistics, by world name.
+      private: std::map<std::string, transport::PublisherPtr> statsPubs;
+
+      /// \brief Wall time at which statistics were last published.
+      private: common::Time prevStatsTime;
+
+      /// \brief Connection to the world removed event.
+      private: event::ConnectionPtr worldRemovedConnection;
+
+      /// \brief Sensors that were removed along with their world, before
+      /// their links asked for it.
+      private: std::set<std::string> worldRemovedSensors;
     };
     /// \}
   }
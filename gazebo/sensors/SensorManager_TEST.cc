@@ -96,6 +96,123 @@ TEST_F(SensorManager_TEST, Data)
   }
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that sensors updated on the worker pool report deadline
+/// statistics.
+TEST_F(SensorManager_TEST, Statistics)
+{
+  // Two lasers share the ray container, which updates in parallel.
+  Load("worlds/test_camera_laser.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  EXPECT_TRUE(mgr->SensorsInitialized());
+
+  common::Time time = physics::get_world()->GetSimTime();
+
+  // Wait for the sensors to update a few times.
+  int i = 0;
+  while (physics::get_world()->GetSimTime() - time < common::Time(0.5) &&
+         i < 100)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 100);
+
+  msgs::SensorStatistics msg;
+  mgr->FillStatisticsMsg(msg);
+  EXPECT_EQ(msg.sensor_size(), 4);
+
+  int lasers = 0;
+  for (int j = 0; j < msg.sensor_size(); ++j)
+  {
+    const msgs::SensorStatistics::Timing &timing = msg.sensor(j);
+    EXPECT_GE(timing.update_count(), timing.missed_count());
+
+    if (timing.name().find("laser") != std::string::npos)
+    {
+      ++lasers;
+      EXPECT_GT(timing.update_count(), 0u);
+      EXPECT_GT(timing.update_rate(), 0.0);
+    }
+  }
+  EXPECT_EQ(lasers, 2);
+}
+
+/////////////////////////////////////////////////
+/// \brief Count the updates of a sensor.
+void onUpdated(int *_count)
+{
+  ++(*_count);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test that a lazy sensor skips its updates until something
+/// consumes its data.
+TEST_F(SensorManager_TEST, LazyActivation)
+{
+  Load("worlds/test_camera_laser.world");
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+  EXPECT_TRUE(mgr->SensorsInitialized());
+
+  sensors::SensorPtr sensor = mgr->GetSensor("default::laser_1::link::laser");
+  ASSERT_TRUE(sensor != NULL);
+  EXPECT_FALSE(sensor->IsLazy());
+  EXPECT_TRUE(sensor->IsActive());
+
+  // Nothing consumes the laser's data, so a lazy laser is inactive.
+  sensor->SetLazy(true);
+  EXPECT_TRUE(sensor->IsLazy());
+  EXPECT_FALSE(sensor->IsActive());
+
+  common::Time time = physics::get_world()->GetSimTime();
+  int i = 0;
+  while (physics::get_world()->GetSimTime() - time < common::Time(0.5) &&
+         i < 100)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 100);
+
+  common::Time idleTime = sensor->GetLastMeasurementTime();
+  EXPECT_LE(idleTime, time + common::Time(0.1));
+  EXPECT_GT(sensor->GetSkippedCount(), 0u);
+
+  // A connection to the updated signal is a consumer.
+  int updates = 0;
+  event::ConnectionPtr connection =
+    sensor->ConnectUpdated(boost::bind(&onUpdated, &updates));
+  EXPECT_TRUE(sensor->IsActive());
+
+  i = 0;
+  while (updates < 5 && i < 100)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 100);
+  EXPECT_GT(sensor->GetLastMeasurementTime(), idleTime);
+
+  // The skipped updates are reported in the statistics.
+  msgs::SensorStatistics msg;
+  mgr->FillStatisticsMsg(msg);
+  bool found = false;
+  for (int j = 0; j < msg.sensor_size(); ++j)
+  {
+    if (msg.sensor(j).name() == sensor->GetScopedName())
+    {
+      found = true;
+      EXPECT_EQ(msg.sensor(j).skipped_count(), sensor->GetSkippedCount());
+      EXPECT_GT(msgs::Convert(msg.sensor(j).mean_update_time()),
+          common::Time::Zero);
+    }
+  }
+  EXPECT_TRUE(found);
+
+  sensor->DisconnectUpdated(connection);
+  sensor->SetLazy(false);
+}
+
 /////////////////////////////////////////////////
 /// \brief Test SensorManager init and removal of sensors
 TEST_F(SensorManager_TEST, InitRemove)
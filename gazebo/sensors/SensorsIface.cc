@@ -35,6 +35,7 @@
 using namespace gazebo;
 
 bool g_disable = false;
+bool g_lazyActivation = false;
 
 /////////////////////////////////////////////////
 bool sensors::load()
@@ -157,3 +158,15 @@ void sensors::enable()
 {
   g_disable = false;
 }
+
+/////////////////////////////////////////////////
+void sensors::set_lazy_activation(bool _lazy)
+{
+  g_lazyActivation = _lazy;
+}
+
+/////////////////////////////////////////////////
+bool sensors::lazy_activation()
+{
+  return g_lazyActivation;
+}
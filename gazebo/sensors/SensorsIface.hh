@@ -100,6 +100,18 @@ namespace gazebo
     /// \brief Enable sensors.
     GAZEBO_VISIBLE
     void enable();
+
+    /// \brief Set whether sensors created from now on are lazy. A lazy
+    /// sensor skips its updates while nothing consumes its data.
+    /// \param[in] _lazy True to make new sensors lazy.
+    /// \sa Sensor::SetLazy
+    GAZEBO_VISIBLE
+    void set_lazy_activation(bool _lazy);
+
+    /// \brief Get whether sensors created from now on are lazy.
+    /// \return True if new sensors are lazy.
+    GAZEBO_VISIBLE
+    bool lazy_activation();
     /// \}
   }
 }
@@ -167,3 +167,10 @@ void WirelessReceiver::Fini()
 {
   WirelessTransceiver::Fini();
 }
+
+//////////////////////////////////////////////////
+bool WirelessReceiver::IsActive()
+{
+  return Sensor::IsActive() ||
+    (this->pub && this->pub->HasConnections());
+}
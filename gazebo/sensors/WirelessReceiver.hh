@@ -50,6 +50,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Fini();
 
+      // Documentation inherited
+      public: virtual bool IsActive();
+
       // Documentation inherited
       private: virtual bool UpdateImpl(bool _force);
 
@@ -20,6 +20,12 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <ignition/math/Rand.hh>
 
 #include "gazebo/msgs/msgs.hh"
@@ -40,6 +46,7 @@ const double WirelessTransmitter::NObstacle = 12.0;
 const double WirelessTransmitter::ModelStdDesv = 6.0;
 const double WirelessTransmitter::Step = 1.0;
 const double WirelessTransmitter::MaxRadius = 10.0;
+const double WirelessTransmitter::MapResolution = 0.5;
 
 /////////////////////////////////////////////////
 WirelessTransmitter::WirelessTransmitter()
@@ -98,6 +105,8 @@ bool WirelessTransmitter::UpdateImpl(bool /*_force*/)
   this->referencePose =
       this->pose + this->parentEntity.lock()->GetWorldPose().Ign();
 
+  this->UpdatePropagationMap();
+
   if (this->visualize)
   {
     msgs::PropagationGrid msg;
@@ -161,15 +170,113 @@ double WirelessTransmitter::GetSignalStrength(
 double WirelessTransmitter::SignalStrength(
     const ignition::math::Pose3d &_receiver,
     const double _rxGain)
+{
+  // Compute the value of n depending on the obstacles between Tx and Rx
+  double n = this->PathExponent(_receiver.Pos());
+
+  double distance = std::max(1.0,
+      this->referencePose.Pos().Distance(_receiver.Pos()));
+  double x = std::abs(ignition::math::Rand::DblNormal(0.0, ModelStdDesv));
+  double wavelength = common::SpeedOfLight / (this->GetFreq() * 1000000);
+
+  // Hata-Okumara propagation model
+  double rxPower = this->GetPower() + this->GetGain() + _rxGain - x +
+      20 * log10(wavelength) - 20 * log10(4 * M_PI) - 10 * n * log10(distance);
+
+  return rxPower;
+}
+
+/////////////////////////////////////////////////
+void WirelessTransmitter::UpdatePropagationMap()
+{
+  // Collect the static models, whose geometry the map depends on.
+  std::vector<std::pair<uint32_t, ignition::math::Pose3d> > staticModels;
+  for (auto const &model : this->world->GetModels())
+  {
+    if (model->IsStatic())
+    {
+      staticModels.push_back(std::make_pair(model->GetId(),
+            model->GetWorldPose().Ign()));
+    }
+  }
+
+  boost::mutex::scoped_lock lock(this->mapMutex);
+
+  // Small moves of the transmitter do not change the map noticeably,
+  // compared to the random shadowing term of the propagation model.
+  if (!this->propagationMap.empty() &&
+      this->mapOrigin.Distance(this->referencePose.Pos()) <=
+      MapResolution * 0.25 &&
+      this->mapStaticModels == staticModels)
+  {
+    return;
+  }
+
+  int size = static_cast<int>(std::round(2 * MaxRadius / MapResolution)) + 1;
+  this->propagationMap.assign(size * size, -1.0);
+  this->mapOrigin = this->referencePose.Pos();
+  this->mapStaticModels.swap(staticModels);
+}
+
+/////////////////////////////////////////////////
+double WirelessTransmitter::PathExponent(
+    const ignition::math::Vector3d &_point)
+{
+  boost::mutex::scoped_lock lock(this->mapMutex);
+
+  // Use the map for points in its plane, within its extent.
+  int size = static_cast<int>(std::round(2 * MaxRadius / MapResolution)) + 1;
+  double fx = (_point.X() - this->mapOrigin.X() + MaxRadius) / MapResolution;
+  double fy = (_point.Y() - this->mapOrigin.Y() + MaxRadius) / MapResolution;
+
+  if (this->propagationMap.empty() ||
+      std::abs(_point.Z() - this->mapOrigin.Z()) > MapResolution ||
+      fx < 0 || fy < 0 || fx > size - 1 || fy > size - 1)
+  {
+    return this->Obstructed(this->referencePose.Pos(), _point) ?
+      NObstacle : NEmpty;
+  }
+
+  int x0 = std::min(static_cast<int>(fx), size - 2);
+  int y0 = std::min(static_cast<int>(fy), size - 2);
+  double tx = fx - x0;
+  double ty = fy - y0;
+
+  // Sample the four surrounding cells, if needed, and interpolate.
+  double corners[4];
+  for (int i = 0; i < 4; ++i)
+  {
+    int x = x0 + (i & 1);
+    int y = y0 + (i >> 1);
+    double &cell = this->propagationMap[y * size + x];
+    if (cell < 0)
+    {
+      ignition::math::Vector3d end = this->mapOrigin +
+        ignition::math::Vector3d(x * MapResolution - MaxRadius,
+            y * MapResolution - MaxRadius, 0);
+      cell = this->Obstructed(this->mapOrigin, end) ? 1.0 : 0.0;
+    }
+    corners[i] = cell;
+  }
+
+  double obstruction =
+    (1 - ty) * ((1 - tx) * corners[0] + tx * corners[1]) +
+    ty * ((1 - tx) * corners[2] + tx * corners[3]);
+
+  return NEmpty + obstruction * (NObstacle - NEmpty);
+}
+
+/////////////////////////////////////////////////
+bool WirelessTransmitter::Obstructed(const ignition::math::Vector3d &_start,
+    const ignition::math::Vector3d &_end)
 {
   std::string entityName;
   double dist;
-  ignition::math::Vector3d end = _receiver.Pos();
-  ignition::math::Vector3d start = this->referencePose.Pos();
+  ignition::math::Vector3d end = _end;
 
   // Avoid computing the intersection of coincident points
   // This prevents an assertion in bullet (issue #849)
-  if (start == end)
+  if (_start == end)
   {
     end.Z() += 0.00001;
   }
@@ -178,27 +285,19 @@ double WirelessTransmitter::SignalStrength(
   boost::recursive_mutex::scoped_lock lock(*(world->GetPhysicsEngine()->
       GetPhysicsUpdateMutex()));
 
-  // Compute the value of n depending on the obstacles between Tx and Rx
-  double n = NEmpty;
-
   // Looking for obstacles between start and end points
-  this->testRay->SetPoints(start, end);
+  this->testRay->SetPoints(_start, end);
   this->testRay->GetIntersection(dist, entityName);
 
   // ToDo: The ray intersects with my own collision model. Fix it.
-  if (entityName != "")
-  {
-    n = NObstacle;
-  }
-
-  double distance = std::max(1.0,
-      this->referencePose.Pos().Distance(_receiver.Pos()));
-  double x = std::abs(ignition::math::Rand::DblNormal(0.0, ModelStdDesv));
-  double wavelength = common::SpeedOfLight / (this->GetFreq() * 1000000);
-
-  // Hata-Okumara propagation model
-  double rxPower = this->GetPower() + this->GetGain() + _rxGain - x +
-      20 * log10(wavelength) - 20 * log10(4 * M_PI) - 10 * n * log10(distance);
+  return entityName != "";
+}
 
-  return rxPower;
+//////////////////////////////////////////////////
+bool WirelessTransmitter::IsActive()
+{
+  // Receivers read the transmitter's pose and propagation map, which
+  // are refreshed in UpdateImpl, so a transmitter is never lazy.
+  return this->active ||
+    (this->pub && this->pub->HasConnections());
 }
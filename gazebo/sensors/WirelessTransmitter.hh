@@ -18,6 +18,11 @@
 #define _GAZEBO_WIRELESS_TRANSMITTER_HH_
 
 #include <string>
+#include <utility>
+#include <vector>
+#include <boost/thread/mutex.hpp>
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Vector3.hh>
 #include "gazebo/physics/physics.hh"
 #include "gazebo/sensors/WirelessTransceiver.hh"
 #include "gazebo/transport/TransportTypes.hh"
@@ -61,6 +66,9 @@ namespace gazebo
       // Documentation inherited
       public: virtual void Init();
 
+      // Documentation inherited
+      public: virtual bool IsActive();
+
       /// \brief Returns the Service Set Identifier (network name).
       /// \return Service Set Identifier (network name).
       public: std::string GetESSID() const;
@@ -85,9 +93,30 @@ namespace gazebo
       public: double SignalStrength(const ignition::math::Pose3d &_receiver,
           const double _rxGain);
 
+      /// \brief Bring the propagation map up to date. The map is cleared
+      /// if the transmitter moved or the static models changed.
+      private: void UpdatePropagationMap();
+
+      /// \brief Get the path loss exponent between the transmitter and a
+      /// point. Inside the propagation map the exponent is interpolated
+      /// from the map, elsewhere a ray is cast.
+      /// \param[in] _point Point in world coordinates.
+      /// \return Path loss exponent, between NEmpty and NObstacle.
+      private: double PathExponent(const ignition::math::Vector3d &_point);
+
+      /// \brief Check for obstacles between two points with a ray.
+      /// \param[in] _start Start of the ray.
+      /// \param[in] _end End of the ray.
+      /// \return True if an obstacle is between the points.
+      private: bool Obstructed(const ignition::math::Vector3d &_start,
+          const ignition::math::Vector3d &_end);
+
       /// \brief Size of the grid used for visualization.
       private: static const double Step;
 
+      /// \brief Distance between the samples of the propagation map.
+      private: static const double MapResolution;
+
       /// \brief The visualization shows the propagation model using a circular
       /// grid, where the maximum radius covered is MaxRadius
       private: static const double MaxRadius;
@@ -104,6 +133,23 @@ namespace gazebo
       // \brief When true it will publish the propagation grid to be used
       // by the transmitter visual layer
       private: bool visualize;
+
+      /// \brief Propagation map. A horizontal grid of MapResolution cells
+      /// covering MaxRadius around the transmitter, holding 1 for cells
+      /// hidden from the transmitter by an obstacle, 0 for visible cells
+      /// and -1 for cells not sampled yet. Cells are sampled on first use.
+      private: std::vector<double> propagationMap;
+
+      /// \brief Transmitter position the propagation map was sampled from.
+      private: ignition::math::Vector3d mapOrigin;
+
+      /// \brief Ids and poses of the static models the propagation map was
+      /// sampled with.
+      private: std::vector<std::pair<uint32_t, ignition::math::Pose3d> >
+               mapStaticModels;
+
+      /// \brief Protects the propagation map.
+      private: boost::mutex mapMutex;
     };
     /// \}
   }
@@ -24,6 +24,7 @@ class WirelessTransmitter_TEST : public ServerFixture
     public: WirelessTransmitter_TEST();
     public: void TestCreateWirelessTransmitter();
     public: void TestSignalStrength();
+    public: void TestPropagationMap();
     public: void TestUpdateImpl();
     public: void TestUpdateImplNoVisual();
     public: void TestInvalidFreq();
@@ -159,6 +160,56 @@ void WirelessTransmitter_TEST::TestSignalStrength()
   EXPECT_NEAR(signStrengthAvg, -62.0, this->tx->ModelStdDesv);
 }
 
+/////////////////////////////////////////////////
+/// \brief Test that the propagation map follows changes of static models
+void WirelessTransmitter_TEST::TestPropagationMap()
+{
+  int samples = 100;
+  ignition::math::Pose3d rxPose(
+      ignition::math::Vector3d(5.0, 0.0, 0.055),
+      ignition::math::Quaterniond(0, 0, 0));
+
+  // Expected strength without and with an obstacle, less the mean of the
+  // random shadowing term.
+  double wavelength = common::SpeedOfLight / (this->tx->GetFreq() * 1000000);
+  double base = this->tx->GetPower() + 2 * this->tx->GetGain() -
+    this->tx->ModelStdDesv * sqrt(2 / M_PI) +
+    20 * log10(wavelength) - 20 * log10(4 * M_PI);
+  double clear = base - 10 * this->tx->NEmpty * log10(5.0);
+  double blocked = base - 10 * this->tx->NObstacle * log10(5.0);
+
+  double avg = 0.0;
+  for (int i = 0; i < samples; ++i)
+  {
+    this->tx->Update(true);
+    avg += this->tx->SignalStrength(rxPose, this->tx->GetGain());
+  }
+  EXPECT_NEAR(avg / samples, clear, 2.0);
+
+  // A static wall between the transmitter and the receiver.
+  SpawnBox("wall", math::Vector3(0.2, 4, 2), math::Vector3(2.5, 0, 1),
+      math::Vector3::Zero, true);
+
+  avg = 0.0;
+  for (int i = 0; i < samples; ++i)
+  {
+    this->tx->Update(true);
+    avg += this->tx->SignalStrength(rxPose, this->tx->GetGain());
+  }
+  EXPECT_NEAR(avg / samples, blocked, 2.0);
+
+  // Without the wall the map is sampled again.
+  physics::get_world("default")->RemoveModel("wall");
+
+  avg = 0.0;
+  for (int i = 0; i < samples; ++i)
+  {
+    this->tx->Update(true);
+    avg += this->tx->SignalStrength(rxPose, this->tx->GetGain());
+  }
+  EXPECT_NEAR(avg / samples, clear, 2.0);
+}
+
 /////////////////////////////////////////////////
 /// \brief Callback executed for every propagation grid message received
 void WirelessTransmitter_TEST::TxMsg(const ConstPropagationGridPtr &_msg)
@@ -254,6 +305,12 @@ TEST_F(WirelessTransmitter_TEST, TestSignalStrength)
   TestSignalStrength();
 }
 
+/////////////////////////////////////////////////
+TEST_F(WirelessTransmitter_TEST, TestPropagationMap)
+{
+  TestPropagationMap();
+}
+
 /////////////////////////////////////////////////
 TEST_F(WirelessTransmitter_TEST, TestUpdateImpl)
 {
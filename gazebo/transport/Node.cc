@@ -118,6 +118,22 @@ std::string Node::GetTopicNamespace() const
   return this->topicNamespace;
 }
 
+/////////////////////////////////////////////////
+PublisherPtr Node::Advertise(const std::string &_topic,
+    const std::string &_msgTypeName, unsigned int _queueLimit,
+    double _hzRate)
+{
+  std::string decodedTopic = this->DecodeTopicName(_topic);
+  PublisherPtr publisher = TopicManager::Instance()->Advertise(
+      decodedTopic, _msgTypeName, _queueLimit, _hzRate);
+
+  boost::mutex::scoped_lock lock(this->publisherMutex);
+  publisher->SetNode(shared_from_this());
+  this->publishers.push_back(publisher);
+
+  return publisher;
+}
+
 /////////////////////////////////////////////////
 std::string Node::DecodeTopicName(const std::string &_topic)
 {
@@ -166,6 +166,20 @@ namespace gazebo
         return publisher;
       }
 
+      /// \brief Advertise a topic using the name of the message type.
+      /// Used when the message type is only known at runtime.
+      /// \param[in] _topic The topic to advertise
+      /// \param[in] _msgTypeName Full protobuf name of the message type.
+      /// \param[in] _queueLimit The maximum number of outgoing messages to
+      /// queue for delivery
+      /// \param[in] _hzRate Update rate for the publisher. Units are
+      /// 1.0/seconds.
+      /// \return Pointer to new publisher object
+      public: transport::PublisherPtr Advertise(const std::string &_topic,
+                  const std::string &_msgTypeName,
+                  unsigned int _queueLimit = 1000,
+                  double _hzRate = 0);
+
       /// \brief Subscribe to a topic using a class method as the callback
       /// \param[in] _topic The topic to subscribe to
       /// \param[in] _fp Class method to be called on receipt of new message
@@ -392,6 +392,47 @@ PublicationPtr TopicManager::UpdatePublications(const std::string &_topic,
   return pub;
 }
 
+//////////////////////////////////////////////////
+PublisherPtr TopicManager::Advertise(const std::string &_topic,
+    const std::string &_msgTypeName, unsigned int _queueLimit,
+    double _hzRate)
+{
+  this->UpdatePublications(_topic, _msgTypeName);
+
+  PublisherPtr pub = PublisherPtr(new Publisher(_topic,
+        _msgTypeName, _queueLimit, _hzRate));
+
+  PublicationPtr publication = this->FindPublication(_topic);
+  GZ_ASSERT(publication != NULL, "FindPublication returned NULL");
+
+  publication->AddPublisher(pub);
+  if (!publication->GetLocallyAdvertised())
+  {
+    ConnectionManager::Instance()->Advertise(_topic, _msgTypeName);
+  }
+
+  publication->SetLocallyAdvertised(true);
+  pub->SetPublication(publication);
+
+  // Connect all local subscription to the publisher
+  SubNodeMap::iterator iter2;
+  SubNodeMap::iterator stEnd2 = this->subscribedNodes.end();
+  for (iter2 = this->subscribedNodes.begin(); iter2 != stEnd2; ++iter2)
+  {
+    if (iter2->first == _topic)
+    {
+      std::list<NodePtr>::iterator liter;
+      std::list<NodePtr>::iterator lEnd = iter2->second.end();
+      for (liter = iter2->second.begin(); liter != lEnd; ++liter)
+      {
+        publication->AddSubscription(*liter);
+      }
+    }
+  }
+
+  return pub;
+}
+
 //////////////////////////////////////////////////
 void TopicManager::Unadvertise(const std::string &_topic)
 {
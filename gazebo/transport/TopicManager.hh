@@ -112,50 +112,25 @@ namespace gazebo
                 if (!msg)
                   gzthrow("Advertise requires a google protobuf type");
 
-                this->UpdatePublications(_topic, msg->GetTypeName());
-
-                PublisherPtr pub = PublisherPtr(new Publisher(_topic,
-                      msg->GetTypeName(), _queueLimit, _hzRate));
-
-                std::string msgTypename;
-                PublicationPtr publication;
-
-                // Connect all local subscription to the publisher
-                msgTypename = msg->GetTypeName();
-
-                publication = this->FindPublication(_topic);
-                GZ_ASSERT(publication != NULL, "FindPublication returned NULL");
-
-                publication->AddPublisher(pub);
-                if (!publication->GetLocallyAdvertised())
-                {
-                  ConnectionManager::Instance()->Advertise(_topic, msgTypename);
-                }
-
-                publication->SetLocallyAdvertised(true);
-                pub->SetPublication(publication);
-
-
-                SubNodeMap::iterator iter2;
-                SubNodeMap::iterator stEnd2 = this->subscribedNodes.end();
-                for (iter2 = this->subscribedNodes.begin();
-                     iter2 != stEnd2; ++iter2)
-                {
-                  if (iter2->first == _topic)
-                  {
-                    std::list<NodePtr>::iterator liter;
-                    std::list<NodePtr>::iterator lEnd = iter2->second.end();
-                    for (liter = iter2->second.begin();
-                        liter != lEnd; ++liter)
-                    {
-                      publication->AddSubscription(*liter);
-                    }
-                  }
-                }
-
-                return pub;
+                return this->Advertise(_topic, msg->GetTypeName(),
+                    _queueLimit, _hzRate);
               }
 
+      /// \brief Advertise on a topic using the name of the message type.
+      /// Used when the message type is only known at runtime, such as
+      /// when replaying recorded topics.
+      /// \param[in] _topic The name of the topic
+      /// \param[in] _msgTypeName Full protobuf name of the message type.
+      /// \param[in] _queueLimit The maximum number of outgoing messages
+      /// to queue
+      /// \param[in] _hzRate Update rate for the publisher. Units are
+      /// 1.0/seconds.
+      /// \return Pointer to the newly created Publisher
+      public: PublisherPtr Advertise(const std::string &_topic,
+                                     const std::string &_msgTypeName,
+                                     unsigned int _queueLimit,
+                                     double _hzRate);
+
       /// \brief Unadvertise a topic
       /// \param[in] _topic The topic to be unadvertised
       public: void Unadvertise(const std::string &_topic);
@@ -20,6 +20,8 @@
   #include <Winsock2.h>
 #endif
 
+#include <algorithm>
+
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
@@ -43,10 +45,23 @@
 using namespace gazebo;
 using namespace util;
 
+/// \brief Number of decoded chunks kept in memory, so that jumping back and
+/// forth in a log file does not decompress the same chunks again.
+static const size_t kChunkCacheSize = 8;
+
+/// \brief Marker at the start of each entry in a chunk.
+static const std::string kStateStartMarker = "<sdf ";
+
+/// \brief Marker at the end of each entry in a chunk.
+static const std::string kStateEndMarker = "</sdf>";
+
 /////////////////////////////////////////////////
 LogPlay::LogPlay()
 {
   this->logStartXml = NULL;
+  this->currChunk = 0;
+  this->currOffset = 0;
+  this->indexedChunks = 0;
 }
 
 /////////////////////////////////////////////////
@@ -80,7 +95,21 @@ void LogPlay::Open(const std::string &_logFile)
   // Read in the header.
   this->ReadHeader();
 
-  this->logCurrXml = this->logStartXml;
+  // Index all the chunks.
+  this->chunks.clear();
+  for (TiXmlElement *xml = this->logStartXml->FirstChildElement("chunk");
+       xml; xml = xml->NextSiblingElement("chunk"))
+  {
+    this->chunks.push_back(xml);
+  }
+
+  // Reset the playback position, the state index and the chunk cache.
+  this->currChunk = 0;
+  this->currOffset = 0;
+  this->stateIndex.clear();
+  this->structuralStates.clear();
+  this->indexedChunks = 0;
+  this->chunkCache.clear();
   this->encoding.clear();
 
   // Extract the start/end log times from the log.
@@ -322,77 +351,297 @@ bool LogPlay::Step(std::string &_data)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
 
-  std::string startMarker = "<sdf ";
-  std::string endMarker = "</sdf>";
-  size_t start = this->currentChunk.find(startMarker);
-  size_t end = this->currentChunk.find(endMarker);
-
-  if (start == std::string::npos || end == std::string::npos)
+  while (this->currChunk < this->chunks.size())
   {
-    this->currentChunk.clear();
+    std::shared_ptr<const std::string> chunk =
+      this->GetCachedChunk(this->currChunk);
+    if (!chunk)
+    {
+      gzerr << "Unable to decode log file\n";
+      return false;
+    }
 
-    if (this->logCurrXml == this->logStartXml)
-      this->logCurrXml = this->logStartXml->FirstChildElement("chunk");
-    else if (this->logCurrXml)
+    size_t start = chunk->find(kStateStartMarker, this->currOffset);
+    size_t end = std::string::npos;
+    if (start != std::string::npos)
+      end = chunk->find(kStateEndMarker, start);
+
+    if (start != std::string::npos && end != std::string::npos)
     {
-      this->logCurrXml = this->logCurrXml->NextSiblingElement("chunk");
+      end += kStateEndMarker.size();
+      _data = chunk->substr(start, end - start);
+      this->currOffset = end;
+      return true;
     }
-    else
-      return false;
 
-    // Stop if there are no more chunks
-    if (!this->logCurrXml)
+    // Move to the next chunk.
+    ++this->currChunk;
+    this->currOffset = 0;
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::Rewind()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  if (this->chunks.empty())
+  {
+    gzerr << "Unable to jump to the beginning of the log file\n";
+    return false;
+  }
+
+  // The first chunk contains the world description, so playback restarts
+  // from the second chunk.
+  this->currChunk = 1;
+  this->currOffset = 0;
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::Seek(const common::Time &_time)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+
+  // Index forward until a state at or after the target time is found, or
+  // the end of the log file is reached.
+  while (this->indexedChunks < this->chunks.size() &&
+         (this->stateIndex.empty() ||
+          this->stateIndex.back().simTime < _time))
+  {
+    if (!this->IndexChunks(this->indexedChunks))
       return false;
+  }
 
-    if (!this->GetChunkData(this->logCurrXml, this->currentChunk))
+  // First state at or after the target time.
+  size_t target = this->stateIndex.size();
+  {
+    size_t low = 0;
+    size_t high = this->stateIndex.size();
+    while (low < high)
     {
-      gzerr << "Unable to decode log file\n";
-      return false;
+      size_t mid = low + (high - low) / 2;
+      if (this->stateIndex[mid].simTime < _time)
+        low = mid + 1;
+      else
+        high = mid;
     }
+    target = low;
+  }
 
-    start = this->currentChunk.find(startMarker);
-    end = this->currentChunk.find(endMarker);
+  if (target >= this->stateIndex.size())
+  {
+    // Nothing to play after the target time.
+    this->currChunk = this->chunks.size();
+    this->currOffset = 0;
+    return false;
   }
 
-  _data = this->currentChunk.substr(start, end+endMarker.size()-start);
+  // When moving forward, don't skip over states that insert or delete
+  // models.
+  size_t next = this->NextStateIndex();
+  if (target > next)
+  {
+    std::vector<size_t>::const_iterator iter = std::lower_bound(
+        this->structuralStates.begin(), this->structuralStates.end(), next);
+    if (iter != this->structuralStates.end() && *iter < target)
+      target = *iter;
+  }
 
-  this->currentChunk.erase(0, end + endMarker.size());
+  this->currChunk = this->stateIndex[target].chunk;
+  this->currOffset = this->stateIndex[target].offset;
 
   return true;
 }
 
 /////////////////////////////////////////////////
-bool LogPlay::Rewind()
+bool LogPlay::Skip(int _count)
 {
   std::lock_guard<std::mutex> lock(this->mutex);
 
-  this->currentChunk.clear();
-  this->logCurrXml = this->logStartXml->FirstChildElement("chunk");
-  if (!logCurrXml)
-  {
-    gzerr << "Unable to jump to the beginning of the log file\n";
+  if (this->stateIndex.empty())
     return false;
+
+  int64_t target = static_cast<int64_t>(this->NextStateIndex()) + _count;
+
+  // Index forward if needed.
+  while (target >= static_cast<int64_t>(this->stateIndex.size()) &&
+         this->indexedChunks < this->chunks.size())
+  {
+    if (!this->IndexChunks(this->indexedChunks))
+      return false;
   }
 
+  target = std::max(target, static_cast<int64_t>(0));
+  target = std::min(target,
+      static_cast<int64_t>(this->stateIndex.size()) - 1);
+
+  this->currChunk = this->stateIndex[target].chunk;
+  this->currOffset = this->stateIndex[target].offset;
+
   return true;
 }
 
 /////////////////////////////////////////////////
-bool LogPlay::GetChunk(unsigned int _index, std::string &_data)
+size_t LogPlay::NextStateIndex() const
+{
+  size_t low = 0;
+  size_t high = this->stateIndex.size();
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    const StateEntry &entry = this->stateIndex[mid];
+    if (entry.chunk < this->currChunk ||
+        (entry.chunk == this->currChunk && entry.offset < this->currOffset))
+    {
+      low = mid + 1;
+    }
+    else
+      high = mid;
+  }
+
+  return low;
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::IndexChunks(unsigned int _index)
+{
+  while (this->indexedChunks <= _index &&
+         this->indexedChunks < this->chunks.size())
+  {
+    // Decoding a chunk that has not been indexed also indexes it.
+    if (!this->GetCachedChunk(this->indexedChunks))
+    {
+      gzerr << "Unable to decode chunk[" << this->indexedChunks
+        << "] in log file\n";
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+std::shared_ptr<const std::string> LogPlay::GetCachedChunk(
+    unsigned int _index)
 {
-  unsigned int count = 0;
-  TiXmlElement *xml = this->logStartXml->FirstChildElement("chunk");
+  std::shared_ptr<const std::string> result;
 
-  while (xml && count < _index)
+  for (auto iter = this->chunkCache.begin();
+       iter != this->chunkCache.end(); ++iter)
   {
-    count++;
-    xml = xml->NextSiblingElement("chunk");
+    if (iter->first == _index)
+    {
+      // Move the chunk to the front of the cache.
+      result = iter->second;
+      this->chunkCache.splice(this->chunkCache.begin(), this->chunkCache,
+          iter);
+      this->encoding = this->chunks[_index]->Attribute("encoding");
+      return result;
+    }
   }
 
-  if (xml && count == _index)
-    return this->GetChunkData(xml, _data);
-  else
+  std::shared_ptr<std::string> data(new std::string);
+  if (!this->GetChunkData(this->chunks[_index], *data))
+    return result;
+
+  // Chunks are indexed in order, the first time they are decoded.
+  if (_index == this->indexedChunks)
+  {
+    this->IndexChunk(_index, *data);
+    ++this->indexedChunks;
+  }
+
+  result = data;
+  this->chunkCache.push_front(std::make_pair(_index, result));
+  if (this->chunkCache.size() > kChunkCacheSize)
+    this->chunkCache.pop_back();
+
+  return result;
+}
+
+/////////////////////////////////////////////////
+void LogPlay::IndexChunk(unsigned int _index, const std::string &_data)
+{
+  const std::string kStateElem = "<state";
+  const std::string kTimeStartDelim = "<sim_time>";
+  const std::string kTimeEndDelim = "</sim_time>";
+  const std::string kInsertions = "<insertions>";
+  const std::string kDeletions = "<deletions>";
+
+  size_t start = _data.find(kStateStartMarker);
+  while (start != std::string::npos)
+  {
+    size_t end = _data.find(kStateEndMarker, start);
+    if (end == std::string::npos)
+      break;
+
+    // Only index entries whose first element is <state>. This skips the
+    // world description.
+    size_t elem = _data.find('<', _data.find('>', start));
+    if (elem < end && _data.compare(elem, kStateElem.size(), kStateElem) == 0)
+    {
+      StateEntry entry;
+      entry.chunk = _index;
+      entry.offset = start;
+
+      size_t from = _data.find(kTimeStartDelim, elem);
+      size_t to = _data.find(kTimeEndDelim, from);
+      if (from < end && to < end)
+      {
+        from += kTimeStartDelim.size();
+        std::stringstream ss(_data.substr(from, to - from));
+        ss >> entry.simTime;
+      }
+      else if (!this->stateIndex.empty())
+        entry.simTime = this->stateIndex.back().simTime;
+
+      // Only search inside the state, to keep indexing linear in the size
+      // of the chunk.
+      std::string::const_iterator stateBegin = _data.begin() + elem;
+      std::string::const_iterator stateEnd = _data.begin() + end;
+      entry.structural =
+        std::search(stateBegin, stateEnd, kInsertions.begin(),
+            kInsertions.end()) != stateEnd ||
+        std::search(stateBegin, stateEnd, kDeletions.begin(),
+            kDeletions.end()) != stateEnd;
+
+      if (entry.structural)
+        this->structuralStates.push_back(this->stateIndex.size());
+      this->stateIndex.push_back(entry);
+    }
+
+    start = _data.find(kStateStartMarker, end + kStateEndMarker.size());
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::GetChunk(unsigned int _index, std::string &_data)
+{
+  if (_index >= this->chunks.size())
+    return false;
+
+  return this->GetChunkData(this->chunks[_index], _data);
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::DecodeChunk(unsigned int _index, std::string &_data) const
+{
+  if (_index >= this->chunks.size())
+    return false;
+
+  const char *encodingAttr = this->chunks[_index]->Attribute("encoding");
+  if (!encodingAttr)
+  {
+    gzerr << "Encoding missing for chunk[" << _index << "] in log file["
+      << this->filename << "]\n";
     return false;
+  }
+
+  return this->DecodeChunkData(this->chunks[_index], encodingAttr, _data);
 }
 
 /////////////////////////////////////////////////
@@ -410,9 +659,16 @@ bool LogPlay::GetChunkData(TiXmlElement *_xml, std::string &_data)
     gzthrow("Enconding missing for a chunk in log file[" +
         this->filename + "]");
 
-  if (this->encoding == "txt")
+  return this->DecodeChunkData(_xml, this->encoding, _data);
+}
+
+/////////////////////////////////////////////////
+bool LogPlay::DecodeChunkData(const TiXmlElement *_xml,
+    const std::string &_encoding, std::string &_data) const
+{
+  if (_encoding == "txt")
     _data = _xml->GetText();
-  else if (this->encoding == "bz2")
+  else if (_encoding == "bz2")
   {
     std::string data = _xml->GetText();
     std::string buffer;
@@ -431,7 +687,7 @@ bool LogPlay::GetChunkData(TiXmlElement *_xml, std::string &_data)
       _data += '\0';
     }
   }
-  else if (this->encoding == "zlib")
+  else if (_encoding == "zlib")
   {
     std::string data = _xml->GetText();
     std::string buffer;
@@ -452,7 +708,7 @@ bool LogPlay::GetChunkData(TiXmlElement *_xml, std::string &_data)
   }
   else
   {
-    gzerr << "Inavlid encoding[" << this->encoding << "] in log file["
+    gzerr << "Inavlid encoding[" << _encoding << "] in log file["
       << this->filename << "]\n";
     return false;
   }
@@ -469,14 +725,5 @@ std::string LogPlay::GetEncoding() const
 /////////////////////////////////////////////////
 unsigned int LogPlay::GetChunkCount() const
 {
-  unsigned int count = 0;
-  TiXmlElement *xml = this->logStartXml->FirstChildElement("chunk");
-
-  while (xml)
-  {
-    count++;
-    xml = xml->NextSiblingElement("chunk");
-  }
-
-  return count;
+  return this->chunks.size();
 }
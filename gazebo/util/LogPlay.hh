@@ -20,8 +20,11 @@
 #include <tinyxml.h>
 
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gazebo/common/SingletonT.hh"
 #include "gazebo/common/Time.hh"
@@ -108,6 +111,27 @@ namespace gazebo
       /// \return True If the function succeed or false otherwise.
       public: bool Rewind();
 
+      /// \brief Jump to a simulation time. The next Step() call will return
+      /// the first state with a simulation time greater than or equal to
+      /// _time. When seeking forward, the jump stops early at any state that
+      /// inserts or deletes models, so that these states are not skipped.
+      /// Call Seek again after stepping such a state to continue.
+      ///
+      /// States are indexed by simulation time the first time their chunk
+      /// is decoded, so only the part of the log that has not been played
+      /// yet needs to be scanned.
+      /// \param[in] _time Target simulation time.
+      /// \return True if the log file contains a state at or after _time.
+      public: bool Seek(const common::Time &_time);
+
+      /// \brief Move the playback position by a number of states. For
+      /// example, Skip(-2) makes the next Step() call return the state
+      /// before the last one that was returned. The position is clamped to
+      /// the first and last indexed states.
+      /// \param[in] _count Number of states to move, may be negative.
+      /// \return True if the position was changed.
+      public: bool Skip(int _count);
+
       /// \brief Get the number of chunks (steps) in the open log file.
       /// \return The number of recorded states in the log file.
       public: unsigned int GetChunkCount() const;
@@ -118,6 +142,15 @@ namespace gazebo
       /// \return True if the _index was valid.
       public: bool GetChunk(unsigned int _index, std::string &_data);
 
+      /// \brief Decode the data of a particular chunk index. Unlike
+      /// GetChunk, this function does not modify the playback position or
+      /// the current encoding, so it can be called from several threads at
+      /// once to decode chunks in parallel.
+      /// \param[in] _index Index of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the _index was valid and the chunk was decoded.
+      public: bool DecodeChunk(unsigned int _index, std::string &_data) const;
+
       /// \brief Get the type of encoding used for current chunck in the
       /// open log file.
       /// \return The type of encoding. An empty string will be returned if
@@ -145,6 +178,14 @@ namespace gazebo
       /// \return True if the chunk was successfully parsed.
       private: bool GetChunkData(TiXmlElement *_xml, std::string &_data);
 
+      /// \brief Helper function to decode the data of a chunk.
+      /// \param[in] _xml Pointer to an xml block that has state data.
+      /// \param[in] _encoding Encoding of the chunk.
+      /// \param[out] _data Storage for the chunk's data.
+      /// \return True if the chunk was successfully decoded.
+      private: bool DecodeChunkData(const TiXmlElement *_xml,
+                   const std::string &_encoding, std::string &_data) const;
+
       /// \brief Read the header from the log file.
       private: void ReadHeader();
 
@@ -156,14 +197,76 @@ namespace gazebo
       /// "iterations" value.
       private: bool ReadIterations();
 
+      /// \brief Get a decoded chunk from the cache of recently used chunks,
+      /// decoding and indexing it if needed.
+      /// \param[in] _index Index of the chunk.
+      /// \return The decoded chunk, or NULL on error.
+      private: std::shared_ptr<const std::string> GetCachedChunk(
+                   unsigned int _index);
+
+      /// \brief Add the states of a decoded chunk to the state index.
+      /// \param[in] _index Index of the chunk.
+      /// \param[in] _data Decoded chunk data.
+      private: void IndexChunk(unsigned int _index, const std::string &_data);
+
+      /// \brief Index each chunk up to and including _index.
+      /// \param[in] _index Index of the last chunk to index.
+      /// \return False if a chunk could not be decoded.
+      private: bool IndexChunks(unsigned int _index);
+
+      /// \brief Get the position in the state index of the state that the
+      /// next Step() call will return.
+      /// \return Index into stateIndex, equal to stateIndex.size() when the
+      /// next state has not been indexed yet.
+      private: size_t NextStateIndex() const;
+
       /// \brief The XML document of the log file.
       private: TiXmlDocument xmlDoc;
 
       /// \brief Start of the log.
       private: TiXmlElement *logStartXml;
 
-      /// \brief Current position in the log file.
-      private: TiXmlElement *logCurrXml;
+      /// \brief All the <chunk> elements of the log file, in order. Used
+      /// for constant time access to a chunk by index.
+      private: std::vector<TiXmlElement *> chunks;
+
+      /// \brief Index of the chunk that contains the current position.
+      private: unsigned int currChunk;
+
+      /// \brief Offset of the current position in the current chunk.
+      private: size_t currOffset;
+
+      /// \brief Location of a state in the log file.
+      private: struct StateEntry
+               {
+                 /// \brief Simulation time of the state.
+                 common::Time simTime;
+
+                 /// \brief Index of the chunk that contains the state.
+                 unsigned int chunk;
+
+                 /// \brief Offset of the state in the decoded chunk.
+                 size_t offset;
+
+                 /// \brief True if the state inserts or deletes models.
+                 bool structural;
+               };
+
+      /// \brief States of the chunks that have been decoded so far, sorted
+      /// by their position in the log file.
+      private: std::vector<StateEntry> stateIndex;
+
+      /// \brief Positions in stateIndex of the states that insert or delete
+      /// models.
+      private: std::vector<size_t> structuralStates;
+
+      /// \brief Number of chunks, from the start of the log file, whose
+      /// states are in stateIndex.
+      private: unsigned int indexedChunks;
+
+      /// \brief Recently decoded chunks, most recently used first.
+      private: std::list<std::pair<unsigned int,
+               std::shared_ptr<const std::string> > > chunkCache;
 
       /// \brief Name of the log file.
       private: std::string filename;
@@ -187,8 +290,6 @@ namespace gazebo
       /// \brief The encoding for the current chunk in the log file.
       private: std::string encoding;
 
-      private: std::string currentChunk;
-
       /// \brief Initial simulation iteration contained in the log file.
       private: uint64_t initialIterations;
 
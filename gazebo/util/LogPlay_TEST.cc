@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
 #include <string>
+#include <vector>
 #include "gazebo/common/CommonIface.hh"
 #include "gazebo/common/Time.hh"
 #include "gazebo/util/LogPlay.hh"
@@ -178,6 +179,121 @@ TEST_F(LogPlay_TEST, Rewind)
   EXPECT_EQ(entry, firstEntry);
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the simulation time of a log entry.
+/// \param[in] _entry Log entry returned by LogPlay::Step.
+/// \return Simulation time of the entry.
+gazebo::common::Time SimTime(const std::string &_entry)
+{
+  gazebo::common::Time time;
+  size_t from = _entry.find("<sim_time>");
+  size_t to = _entry.find("</sim_time>");
+  if (from != std::string::npos && to != std::string::npos)
+  {
+    std::stringstream ss(_entry.substr(from + 10, to - from - 10));
+    ss >> time;
+  }
+  return time;
+}
+
+/////////////////////////////////////////////////
+/// \brief Test Seek().
+TEST_F(LogPlay_TEST, Seek)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  // Open a correct log file.
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  // Consume the world description and read all the states.
+  std::string entry;
+  EXPECT_TRUE(player->Step(entry));
+  std::vector<std::string> entries;
+  while (player->Step(entry))
+    entries.push_back(entry);
+  ASSERT_GT(entries.size(), 10u);
+
+  // Seek backward to an existing state.
+  size_t middle = entries.size() / 2;
+  EXPECT_TRUE(player->Seek(SimTime(entries[middle])));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries[middle]);
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries[middle + 1]);
+
+  // Seek to a time between two states.
+  gazebo::common::Time time = SimTime(entries[2]) +
+    (SimTime(entries[3]) - SimTime(entries[2])) * 0.5;
+  EXPECT_TRUE(player->Seek(time));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries[3]);
+
+  // Seek forward to the last state.
+  EXPECT_TRUE(player->Seek(player->GetLogEndTime()));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries.back());
+  EXPECT_FALSE(player->Step(entry));
+
+  // Seek before the first state.
+  EXPECT_TRUE(player->Seek(gazebo::common::Time::Zero));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries.front());
+
+  // Seek past the end.
+  EXPECT_FALSE(player->Seek(player->GetLogEndTime() +
+      gazebo::common::Time(1, 0)));
+  EXPECT_FALSE(player->Step(entry));
+
+  // Seek on a log that has not been played yet.
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+  EXPECT_TRUE(player->Seek(SimTime(entries[middle])));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries[middle]);
+}
+
+/////////////////////////////////////////////////
+/// \brief Test Skip().
+TEST_F(LogPlay_TEST, Skip)
+{
+  gazebo::util::LogPlay *player = gazebo::util::LogPlay::Instance();
+
+  // Open a correct log file.
+  boost::filesystem::path logFilePath(TEST_PATH);
+  logFilePath /= boost::filesystem::path("logs");
+  logFilePath /= boost::filesystem::path("state.log");
+
+  EXPECT_NO_THROW(player->Open(logFilePath.string()));
+
+  // Consume the world description and read a few states.
+  std::string entry;
+  EXPECT_TRUE(player->Step(entry));
+  std::vector<std::string> entries;
+  for (int i = 0; i < 5; ++i)
+  {
+    EXPECT_TRUE(player->Step(entry));
+    entries.push_back(entry);
+  }
+
+  // Step back one state.
+  EXPECT_TRUE(player->Skip(-2));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries[3]);
+
+  // Step back past the first state.
+  EXPECT_TRUE(player->Skip(-100));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries[0]);
+
+  // Skip forward.
+  EXPECT_TRUE(player->Skip(2));
+  EXPECT_TRUE(player->Step(entry));
+  EXPECT_EQ(entry, entries[3]);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -20,6 +20,8 @@
   #include <Winsock2.h>
 #endif
 
+#include <set>
+
 #include <gazebo/common/Events.hh>
 #include <gazebo/common/Assert.hh>
 #include <gazebo/common/Console.hh>
@@ -107,19 +109,26 @@ void OccupiedEventSource::Load(const sdf::ElementPtr _sdf)
 /////////////////////////////////////////////////
 void OccupiedEventSource::Update()
 {
-  // Get all the models.
-  physics::Model_V models = this->world->GetModels();
+  RegionPtr region = this->regions[this->regionName];
+
+  // Get the models that overlap the region's boxes. A model can overlap
+  // more than one box, so collect them in a set.
+  std::set<physics::ModelPtr> models;
+  for (auto const &box : region->boxes)
+  {
+    physics::Model_V inBox = this->world->GetModelsInBox(box.Ign());
+    models.insert(inBox.begin(), inBox.end());
+  }
 
   // Process each model.
-  for (physics::Model_V::iterator iter = models.begin();
-       iter != models.end(); ++iter)
+  for (auto const &model : models)
   {
     // Skip models that are static
-    if ((*iter)->IsStatic())
+    if (model->IsStatic())
       continue;
 
     // If inside, then transmit the desired message.
-    if (this->regions[this->regionName]->Contains((*iter)->GetWorldPose().pos))
+    if (region->Contains(model->GetWorldPose().pos))
     {
       this->msgPub->Publish(this->msg);
     }
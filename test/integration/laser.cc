@@ -249,6 +249,21 @@ void LaserTest::LaserUnitBox(const std::string &_physicsEngine)
 
   EXPECT_DOUBLE_EQ(raySensor->GetRange(samples-1), GZ_DBL_INF);
 
+  // The bulk accessor matches the per ray accessors.
+  physics::MultiRayShapePtr shape = raySensor->GetLaserShape();
+  std::vector<double> ranges, retros;
+  std::vector<int> fiducials;
+  shape->GetScan(ranges, retros, fiducials);
+  ASSERT_EQ(ranges.size(), samples);
+  ASSERT_EQ(retros.size(), samples);
+  ASSERT_EQ(fiducials.size(), samples);
+  for (unsigned int i = 0; i < samples; ++i)
+  {
+    EXPECT_DOUBLE_EQ(ranges[i], shape->GetRange(i));
+    EXPECT_DOUBLE_EQ(retros[i], shape->GetRetro(i));
+    EXPECT_EQ(fiducials[i], shape->GetFiducial(i));
+  }
+
   // Move all boxes out of range
   world->GetModel(box01)->SetWorldPose(
       math::Pose(math::Vector3(maxRange + 1, 0, 0), math::Quaternion(0, 0, 0)));
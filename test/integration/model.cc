@@ -15,6 +15,8 @@
  *
 */
 #include <string.h>
+#include <algorithm>
+#include <vector>
 #include "gazebo/test/ServerFixture.hh"
 
 using namespace gazebo;
@@ -56,6 +58,60 @@ TEST_F(ModelTest, GetScopedName)
   EXPECT_EQ(modelName, std::string("default::simple_arm"));
 }
 
+/////////////////////////////////////////////////
+// This tests commanding and reading all the joints of a model at once.
+TEST_F(ModelTest, JointForcesAndStates)
+{
+  Load("worlds/simple_arm_test.world", true);
+
+  physics::ModelPtr model = GetModel("simple_arm");
+  ASSERT_TRUE(model != NULL);
+
+  const physics::Joint_V &joints = model->GetJoints();
+  unsigned int count = model->GetJointAxisCount();
+  EXPECT_GT(count, 0u);
+
+  // Efforts must cover every axis.
+  EXPECT_FALSE(model->SetJointForces(std::vector<double>(count + 1, 0.5)));
+
+  std::vector<double> forces(count);
+  for (unsigned int i = 0; i < count; ++i)
+    forces[i] = 0.1 * (i + 1);
+  EXPECT_TRUE(model->SetJointForces(forces));
+
+  unsigned int offset = 0;
+  for (auto const &joint : joints)
+  {
+    for (unsigned int i = 0; i < joint->GetAngleCount(); ++i, ++offset)
+    {
+      double expected = forces[offset];
+      if (joint->GetEffortLimit(i) >= 0)
+        expected = std::min(expected, joint->GetEffortLimit(i));
+      EXPECT_NEAR(joint->GetForce(i), expected, 1e-10);
+    }
+  }
+
+  // Move the arm, then compare with the states of each joint.
+  physics::WorldPtr world = physics::get_world("default");
+  world->Step(100);
+
+  std::vector<double> positions;
+  std::vector<double> velocities;
+  model->GetJointStates(positions, velocities);
+  ASSERT_EQ(positions.size(), count);
+  ASSERT_EQ(velocities.size(), count);
+
+  offset = 0;
+  for (auto const &joint : joints)
+  {
+    for (unsigned int i = 0; i < joint->GetAngleCount(); ++i, ++offset)
+    {
+      EXPECT_DOUBLE_EQ(positions[offset], joint->GetAngle(i).Radian());
+      EXPECT_DOUBLE_EQ(velocities[offset], joint->GetVelocity(i));
+    }
+  }
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -110,6 +110,86 @@ TEST_P(PhysicsTest, DropTest)
   DropTest("ode", "world", GetParam());
 }
 
+////////////////////////////////////////////////////////////////////////
+// Contact joints of a resting box start from the impulses of the
+// previous step, so few iterations keep the contacts converged.
+TEST_F(PhysicsTest, ContactWarmStart)
+{
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::PhysicsEnginePtr physics = world->GetPhysicsEngine();
+  ASSERT_TRUE(physics != NULL);
+
+  SpawnBox("box", math::Vector3(1, 1, 1), math::Vector3(0, 0, 0.5),
+      math::Vector3::Zero);
+  physics::ModelPtr model = world->GetModel("box");
+  ASSERT_TRUE(model != NULL);
+
+  // Let the box come to rest.
+  world->Step(1000);
+
+  physics->SetParam("iters", 5);
+  physics->SetParam("warm_start_factor", 1.0);
+  world->Step(10);
+  double warmResidual =
+    boost::any_cast<double>(physics->GetParam("constraint_residual"));
+
+  physics->SetParam("warm_start_factor", 0.0);
+  world->Step(10);
+  double coldResidual =
+    boost::any_cast<double>(physics->GetParam("constraint_residual"));
+
+  EXPECT_LT(warmResidual, coldResidual);
+  EXPECT_LT(fabs(model->GetWorldPose().pos.z - 0.5), PHYSICS_TOL);
+}
+
+////////////////////////////////////////////////////////////////////////
+// Removing a model drops its cached contacts, so a snapshot taken after
+// the removal only holds contacts of live collisions.
+TEST_F(PhysicsTest, ContactWarmStartRemoveModel)
+{
+  Load("worlds/empty.world", true, "ode");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::PhysicsEnginePtr physics = world->GetPhysicsEngine();
+  ASSERT_TRUE(physics != NULL);
+  physics->SetParam("warm_start_factor", 1.0);
+
+  SpawnBox("box", math::Vector3(1, 1, 1), math::Vector3(0, 0, 0.5),
+      math::Vector3::Zero);
+  ASSERT_TRUE(world->GetModel("box") != NULL);
+  world->Step(100);
+
+  // Save while the contacts of the box are cached, then remove the box
+  // before the next step reads them.
+  physics::WorldSnapshot snapshot;
+  world->SaveSnapshot(snapshot);
+  world->RemoveModel("box");
+  ASSERT_TRUE(world->GetModel("box") == NULL);
+
+  SpawnBox("box2", math::Vector3(1, 1, 1), math::Vector3(2, 0, 0.5),
+      math::Vector3::Zero);
+  physics::ModelPtr model = world->GetModel("box2");
+  ASSERT_TRUE(model != NULL);
+  world->Step(100);
+
+  // The box that the first snapshot refers to is gone.
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+
+  world->SaveSnapshot(snapshot);
+  math::Pose pose = model->GetWorldPose();
+  world->Step(50);
+  math::Pose later = model->GetWorldPose();
+
+  ASSERT_TRUE(world->RestoreSnapshot(snapshot));
+  EXPECT_EQ(model->GetWorldPose().pos, pose.pos);
+  world->Step(50);
+  EXPECT_NEAR(model->GetWorldPose().pos.Distance(later.pos), 0, 1e-9);
+}
+
 INSTANTIATE_TEST_CASE_P(WorldStepSolvers, PhysicsTest,
                         WORLD_STEP_SOLVERS);
 
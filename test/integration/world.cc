@@ -15,7 +15,12 @@
  *
 */
 #include "gazebo/test/ServerFixture.hh"
+#include "gazebo/common/Events.hh"
 #include "gazebo/physics/physics.hh"
+#include "gazebo/sensors/RFIDSensor.hh"
+#include "gazebo/sensors/Sensor.hh"
+#include "gazebo/sensors/SensorManager.hh"
+#include "gazebo/util/LogRecord.hh"
 
 using namespace gazebo;
 class WorldTest : public ServerFixture
@@ -242,6 +247,681 @@ TEST_F(WorldTest, RemoveModelUnPaused)
   EXPECT_FALSE(boxModel != NULL);
 }
 
+/////////////////////////////////////////////////
+TEST_F(WorldTest, RemoveModels)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  unsigned int modelCount = world->GetModelCount();
+
+  std::vector<std::string> names;
+  names.push_back("sphere");
+  names.push_back("box");
+  names.push_back("no_such_model");
+  world->RemoveModels(names);
+
+  EXPECT_TRUE(world->GetModel("sphere") == NULL);
+  EXPECT_TRUE(world->GetModel("box") == NULL);
+  EXPECT_TRUE(world->GetModel("cylinder") != NULL);
+  EXPECT_EQ(world->GetModelCount(), modelCount - 2);
+}
+
+/////////////////////////////////////////////////
+boost::mutex g_packedMutex;
+msgs::PoseNames g_poseNames;
+std::vector<msgs::PosesPacked> g_posesPacked;
+
+/////////////////////////////////////////////////
+void OnPoseNames(ConstPoseNamesPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_packedMutex);
+  g_poseNames.CopyFrom(*_msg);
+}
+
+/////////////////////////////////////////////////
+void OnPosesPacked(ConstPosesPackedPtr &_msg)
+{
+  boost::mutex::scoped_lock lock(g_packedMutex);
+  g_posesPacked.push_back(*_msg);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, PackedPoses)
+{
+  Load("worlds/shapes.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr box = world->GetModel("box");
+  ASSERT_TRUE(box != NULL);
+
+  transport::SubscriberPtr namesSub =
+    this->node->Subscribe("~/pose/packed/names", &OnPoseNames, true);
+  transport::SubscriberPtr posesSub =
+    this->node->Subscribe("~/pose/packed/info", &OnPosesPacked);
+
+  // Skip all but large motions, then move the box far enough.
+  world->SetPoseStreamThresholds(0.5, 0.5);
+  box->SetWorldPose(math::Pose(3, 3, 0.5, 0, 0, 0));
+
+  bool found = false;
+  for (int i = 0; i < 100 && !found; ++i)
+  {
+    common::Time::MSleep(50);
+    boost::mutex::scoped_lock lock(g_packedMutex);
+    for (auto const &msg : g_posesPacked)
+    {
+      EXPECT_EQ(msg.pose_size(), msg.id_size() * 7);
+      for (int j = 0; j < msg.id_size() && !found; ++j)
+      {
+        if (msg.id(j) == box->GetId() &&
+            math::equal(msg.pose(j * 7), 3.0f, 1e-3f))
+        {
+          found = true;
+        }
+      }
+    }
+  }
+  EXPECT_TRUE(found);
+
+  // The name table holds the box.
+  boost::mutex::scoped_lock lock(g_packedMutex);
+  ASSERT_EQ(g_poseNames.id_size(), g_poseNames.name_size());
+  bool named = false;
+  for (int i = 0; i < g_poseNames.id_size(); ++i)
+  {
+    if (g_poseNames.id(i) == box->GetId())
+    {
+      EXPECT_EQ(g_poseNames.name(i), "box");
+      named = true;
+    }
+  }
+  EXPECT_TRUE(named);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, DeferredTeardown)
+{
+  Load("worlds/shapes.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  physics::ModelPtr model = world->GetModel("box");
+  ASSERT_TRUE(model != NULL);
+  physics::LinkPtr link = model->GetLink("link");
+  ASSERT_TRUE(link != NULL);
+
+  boost::weak_ptr<physics::Model> weakModel = model;
+  boost::weak_ptr<physics::Link> weakLink = link;
+  model.reset();
+  link.reset();
+
+  // The model is detached at once, and destroyed by the teardown thread.
+  uint64_t reclaimed = world->GetTeardownQueue()->GetReclaimedCount();
+  world->RemoveModel("box");
+  EXPECT_TRUE(world->GetModel("box") == NULL);
+  EXPECT_TRUE(world->GetEntity("box::link") == NULL);
+
+  world->GetTeardownQueue()->Flush();
+  EXPECT_EQ(world->GetTeardownQueue()->GetPendingCount(), 0u);
+  EXPECT_GT(world->GetTeardownQueue()->GetReclaimedCount(), reclaimed);
+  EXPECT_TRUE(weakModel.expired());
+  EXPECT_TRUE(weakLink.expired());
+
+  // The simulation keeps running.
+  world->Step(10);
+  EXPECT_TRUE(world->GetModel("sphere") != NULL);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, RemoveModelRunning)
+{
+  Load("worlds/shapes.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  // Connect every model to the world updates: its link publishes data,
+  // and the model is animated.
+  std::vector<std::string> names = {"box", "sphere", "cylinder"};
+  std::vector<boost::weak_ptr<physics::Model> > weakModels;
+  for (auto const &name : names)
+  {
+    physics::ModelPtr model = world->GetModel(name);
+    ASSERT_TRUE(model != NULL);
+    physics::LinkPtr link = model->GetLink("link");
+    ASSERT_TRUE(link != NULL);
+    link->SetPublishData(true);
+
+    common::PoseAnimationPtr anim(
+        new common::PoseAnimation(name + "_anim", 10.0, true));
+    anim->CreateKeyFrame(0.0)->Translation(
+        ignition::math::Vector3d(0, 0, 1));
+    anim->CreateKeyFrame(10.0)->Translation(
+        ignition::math::Vector3d(1, 0, 1));
+    model->SetAnimation(anim);
+
+    weakModels.push_back(model);
+  }
+
+  // Remove the models one at a time while the world keeps updating.
+  for (auto const &name : names)
+  {
+    common::Time simTime = world->GetSimTime();
+    world->RemoveModel(name);
+    EXPECT_TRUE(world->GetModel(name) == NULL);
+
+    int i = 0;
+    while (world->GetSimTime() <= simTime && i < 100)
+    {
+      common::Time::MSleep(10);
+      ++i;
+    }
+    EXPECT_LT(i, 100);
+  }
+
+  world->GetTeardownQueue()->Flush();
+  for (auto const &weakModel : weakModels)
+    EXPECT_TRUE(weakModel.expired());
+
+  EXPECT_TRUE(world->GetRunning());
+  EXPECT_FALSE(world->IsPaused());
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, FactoryBatch)
+{
+  Load("worlds/shapes.world");
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  unsigned int modelCount = world->GetModelCount();
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='robot'>"
+    << "  <link name='link'>"
+    << "    <collision name='collision'>"
+    << "      <geometry><box><size>1 1 1</size></box></geometry>"
+    << "    </collision>"
+    << "  </link>"
+    << "</model>"
+    << "</sdf>";
+
+  // Replace the box and the sphere by five robots, one of which reuses
+  // the box's name.
+  msgs::FactoryBatch batch;
+  batch.add_delete_name("box");
+  batch.add_delete_name("sphere");
+  for (int i = 0; i < 5; ++i)
+  {
+    msgs::Factory *factory = batch.add_factory();
+    factory->set_sdf(sdfStr.str());
+    factory->set_name(i == 0 ? "box" : "robot_" + std::to_string(i));
+    msgs::Set(factory->mutable_pose(),
+        ignition::math::Pose3d(i * 2.0, 5, 0.5, 0, 0, 0));
+  }
+  world->ApplyFactoryBatch(batch);
+
+  int i = 0;
+  while (world->GetModelCount() != modelCount + 3 && i < 50)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 50);
+
+  EXPECT_TRUE(world->GetModel("sphere") == NULL);
+  physics::ModelPtr box = world->GetModel("box");
+  ASSERT_TRUE(box != NULL);
+  EXPECT_TRUE(box->GetLink("link") != NULL);
+  for (int j = 1; j < 5; ++j)
+  {
+    physics::ModelPtr robot = world->GetModel("robot_" + std::to_string(j));
+    ASSERT_TRUE(robot != NULL);
+    EXPECT_NEAR(robot->GetWorldPose().pos.x, j * 2.0, 1e-3);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, Lockstep)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<model name='arm'>"
+    << "  <pose>0 0 1 0 0 0</pose>"
+    << "  <link name='base'/>"
+    << "  <link name='arm'>"
+    << "    <inertial><mass>1</mass></inertial>"
+    << "  </link>"
+    << "  <joint name='fix' type='fixed'>"
+    << "    <parent>world</parent><child>base</child>"
+    << "  </joint>"
+    << "  <joint name='hinge' type='revolute'>"
+    << "    <parent>base</parent><child>arm</child>"
+    << "    <axis><xyz>0 0 1</xyz></axis>"
+    << "  </joint>"
+    << "</model>"
+    << "</sdf>";
+  SpawnSDF(sdfStr.str());
+
+  int i = 0;
+  while (!world->GetModel("arm") && i < 50)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  ASSERT_LT(i, 50);
+
+  // Only observing does not step the world.
+  msgs::LockstepRequest request;
+  request.set_id(1);
+  request.set_steps(0);
+  request.add_link("arm::arm");
+  request.add_joint("arm::hinge");
+  request.add_joint("arm::missing");
+
+  msgs::LockstepObservation first;
+  ASSERT_TRUE(world->Lockstep(request, first));
+  EXPECT_EQ(first.id(), 1u);
+  EXPECT_EQ(first.iterations(), world->GetIterations());
+  ASSERT_EQ(first.link_pose_size(), 1);
+  EXPECT_EQ(first.link_pose(0).name(), "arm::arm");
+  EXPECT_NEAR(first.link_pose(0).position().z(), 1.0, 1e-3);
+  ASSERT_EQ(first.joint_size(), 1);
+  ASSERT_EQ(first.missing_size(), 1);
+  EXPECT_EQ(first.missing(0), "arm::missing");
+
+  // Push the hinge for exactly 100 steps of the paused world.
+  request.set_id(2);
+  request.set_steps(100);
+  msgs::JointCmd *cmd = request.add_joint_cmd();
+  cmd->set_name("arm::hinge");
+  cmd->set_force(1.0);
+
+  msgs::LockstepObservation second;
+  ASSERT_TRUE(world->Lockstep(request, second));
+  EXPECT_EQ(second.id(), 2u);
+  EXPECT_EQ(second.iterations(), first.iterations() + 100);
+  EXPECT_NEAR((msgs::Convert(second.time()) -
+        msgs::Convert(first.time())).Double(),
+      100 * world->GetPhysicsEngine()->GetMaxStepSize(), 1e-6);
+  ASSERT_EQ(second.joint_size(), 1);
+  ASSERT_EQ(second.joint(0).angle_size(), 1);
+  EXPECT_GT(second.joint(0).angle(0), first.joint(0).angle(0));
+  EXPECT_GT(second.joint(0).velocity(), 0.0);
+  EXPECT_TRUE(world->IsPaused());
+
+  // Commands and observations also take unscoped names.
+  request.set_id(3);
+  request.clear_joint();
+  request.add_joint("hinge");
+  request.mutable_joint_cmd(0)->set_name("hinge");
+  request.mutable_joint_cmd(0)->set_force(-5.0);
+
+  msgs::LockstepObservation third;
+  ASSERT_TRUE(world->Lockstep(request, third));
+  EXPECT_EQ(third.id(), 3u);
+  EXPECT_EQ(third.missing_size(), 0);
+  ASSERT_EQ(third.joint_size(), 1);
+  EXPECT_EQ(third.joint(0).name(), "arm::hinge");
+  EXPECT_LT(third.joint(0).velocity(), second.joint(0).velocity());
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, LockstepFromUpdate)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  msgs::LockstepRequest request;
+  request.set_id(1);
+  request.set_steps(1);
+
+  // A request made from a world update callback would wait for the
+  // simulation thread that runs the callback.
+  int calls = 0;
+  bool served = true;
+  event::ConnectionPtr connection = event::Events::ConnectWorldUpdateBegin(
+      [&](const common::UpdateInfo &)
+      {
+        msgs::LockstepObservation observation;
+        served = world->Lockstep(request, observation);
+        ++calls;
+      });
+
+  world->Step(1);
+  event::Events::DisconnectWorldUpdateBegin(connection);
+
+  EXPECT_GT(calls, 0);
+  EXPECT_FALSE(served);
+
+  // Requests from other threads are still served.
+  msgs::LockstepObservation observation;
+  EXPECT_TRUE(world->Lockstep(request, observation));
+  EXPECT_EQ(observation.id(), 1u);
+}
+
+/////////////////////////////////////////////////
+/// \brief Create, load, init and run a world with a box five meters up,
+/// which carries an imu.
+/// \param[in] _name Name of the world.
+/// \return The world.
+static physics::WorldPtr addWorld(const std::string &_name)
+{
+  std::ostringstream sdfStr;
+  sdfStr << "<sdf version='" << SDF_VERSION << "'>"
+    << "<world name='" << _name << "'>"
+    << "  <model name='box'>"
+    << "    <pose>0 0 5 0 0 0</pose>"
+    << "    <link name='link'>"
+    << "      <collision name='collision'>"
+    << "        <geometry><box><size>1 1 1</size></box></geometry>"
+    << "      </collision>"
+    << "      <sensor name='imu' type='imu'>"
+    << "        <always_on>1</always_on>"
+    << "        <update_rate>100</update_rate>"
+    << "      </sensor>"
+    << "    </link>"
+    << "  </model>"
+    << "</world>"
+    << "</sdf>";
+
+  sdf::SDFPtr sdf(new sdf::SDF);
+  if (!sdf::init(sdf) || !sdf::readString(sdfStr.str(), sdf))
+    return physics::WorldPtr();
+
+  physics::WorldPtr world = physics::create_world();
+  physics::load_world(world, sdf->Root()->GetElement("world"));
+  physics::init_world(world);
+  physics::run_world(world);
+  return world;
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, MultipleWorlds)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  // The second world runs in its own thread, while the first is paused.
+  uint32_t iterations = world->GetIterations();
+  physics::WorldPtr second = addWorld("second");
+  ASSERT_TRUE(second != NULL);
+
+  EXPECT_EQ(physics::get_worlds().size(), 2u);
+  EXPECT_TRUE(physics::has_world("second"));
+  EXPECT_EQ(physics::get_world("second"), second);
+  EXPECT_TRUE(world->GetModel("box") == NULL);
+
+  int i = 0;
+  while (second->GetIterations() < 100 && i < 50)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 50);
+  EXPECT_EQ(world->GetIterations(), iterations);
+
+  // The box falls in the second world only.
+  physics::ModelPtr box = second->GetModel("box");
+  ASSERT_TRUE(box != NULL);
+  EXPECT_LT(box->GetWorldPose().pos.z, 5.0);
+
+  // Removing the second world leaves the first one.
+  EXPECT_TRUE(physics::remove_world("second"));
+  EXPECT_FALSE(physics::remove_world("second"));
+  EXPECT_FALSE(physics::has_world("second"));
+  EXPECT_EQ(physics::get_worlds().size(), 1u);
+  EXPECT_EQ(physics::get_world(), world);
+
+  world->Step(10);
+  EXPECT_EQ(world->GetIterations(), iterations + 10);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, ReAddWorld)
+{
+  Load("worlds/empty.world", true);
+  util::LogRecord *recorder = util::LogRecord::Instance();
+
+  physics::WorldPtr second = addWorld("second");
+  ASSERT_TRUE(second != NULL);
+  EXPECT_TRUE(physics::remove_world("second"));
+  second.reset();
+
+  // The removed world took its log, and its callback, along.
+  EXPECT_FALSE(recorder->Remove("second"));
+
+  // A world of the same name gets a log of its own.
+  second = addWorld("second");
+  ASSERT_TRUE(second != NULL);
+  int i = 0;
+  while (second->GetIterations() < 100 && i < 50)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 50);
+  EXPECT_TRUE(recorder->Remove("second"));
+
+  EXPECT_TRUE(physics::remove_world("second"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, RemoveWorldSensors)
+{
+  Load("worlds/empty.world", false);
+  sensors::SensorManager *mgr = sensors::SensorManager::Instance();
+
+  physics::WorldPtr second = addWorld("second");
+  ASSERT_TRUE(second != NULL);
+
+  // The imu is created with the world, and updated by the sensor threads.
+  sensors::SensorPtr imu;
+  int i = 0;
+  while ((!(imu = mgr->GetSensor("second::box::link::imu")) ||
+          imu->GetLastUpdateTime() == common::Time::Zero) && i < 50)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 50);
+  ASSERT_TRUE(imu != NULL);
+  EXPECT_EQ(imu->GetWorldName(), "second");
+
+  // The sensor is gone as soon as its world is.
+  EXPECT_TRUE(physics::remove_world("second"));
+  second.reset();
+  EXPECT_TRUE(mgr->GetSensor("second::box::link::imu") == NULL);
+
+  sensors::Sensor_V all = mgr->GetSensors();
+  for (sensors::Sensor_V::iterator iter = all.begin(); iter != all.end();
+       ++iter)
+  {
+    EXPECT_NE((*iter)->GetWorldName(), "second");
+  }
+
+  // The remaining world keeps running.
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+  uint32_t iterations = world->GetIterations();
+  i = 0;
+  while (world->GetIterations() < iterations + 100 && i < 50)
+  {
+    common::Time::MSleep(100);
+    ++i;
+  }
+  EXPECT_LT(i, 50);
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, SpatialQueries)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  // Boxes just inside and just outside of RFID range of the origin, and
+  // one to the side.
+  double range = sensors::RFIDSensor::Range;
+  SpawnBox("near", math::Vector3(1, 1, 1), math::Vector3(range - 1, 0, 0),
+      math::Vector3::Zero, true);
+  SpawnBox("far", math::Vector3(1, 1, 1), math::Vector3(range + 1, 0, 0),
+      math::Vector3::Zero, true);
+  SpawnBox("side", math::Vector3(1, 1, 1), math::Vector3(0, 20, 0),
+      math::Vector3::Zero, true);
+
+  // The RFID sensor only checks the tags of models in range.
+  physics::Model_V models = world->GetModelsInSphere(
+      ignition::math::Vector3d::Zero, range);
+  std::set<std::string> names;
+  for (auto const &model : models)
+    names.insert(model->GetName());
+  EXPECT_TRUE(names.count("near"));
+  EXPECT_FALSE(names.count("far"));
+  EXPECT_FALSE(names.count("side"));
+
+  // A frustum looking down the x axis sees the boxes on the axis, which
+  // the logical camera then tests exactly.
+  ignition::math::Frustum frustum;
+  frustum.SetNear(0.1);
+  frustum.SetFar(20);
+  frustum.SetFOV(IGN_DTOR(30));
+  frustum.SetAspectRatio(1.0);
+
+  models = world->GetModelsInFrustum(frustum);
+  names.clear();
+  for (auto const &model : models)
+    names.insert(model->GetName());
+  EXPECT_TRUE(names.count("near"));
+  EXPECT_TRUE(names.count("far"));
+  EXPECT_FALSE(names.count("side"));
+
+  // Moving a box is seen by the next query.
+  world->GetModel("side")->SetWorldPose(math::Pose(1, 0, 0, 0, 0, 0));
+  models = world->GetModelsInSphere(ignition::math::Vector3d::Zero, range);
+  names.clear();
+  for (auto const &model : models)
+    names.insert(model->GetName());
+  EXPECT_TRUE(names.count("side"));
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, Snapshot)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  SpawnBox("box", math::Vector3(1, 1, 1), math::Vector3(0, 0, 2),
+      math::Vector3(0.3, 0.2, 0));
+  SpawnSphere("sphere", math::Vector3(3, 0, 1), math::Vector3::Zero);
+  physics::ModelPtr box = world->GetModel("box");
+  physics::ModelPtr sphere = world->GetModel("sphere");
+  ASSERT_TRUE(box != NULL);
+  ASSERT_TRUE(sphere != NULL);
+  sphere->SetLinearVel(math::Vector3(1, 0.5, 0));
+
+  world->Step(50);
+  math::Pose boxPose = box->GetWorldPose();
+  math::Vector3 boxVel = box->GetWorldLinearVel();
+  math::Pose spherePose = sphere->GetWorldPose();
+  common::Time simTime = world->GetSimTime();
+  uint64_t iterations = world->GetIterations();
+
+  physics::WorldSnapshot snapshot;
+  world->SaveSnapshot(snapshot);
+  EXPECT_GT(snapshot.GetSize(), 0u);
+
+  // The box lands and tumbles after the snapshot.
+  world->Step(200);
+  math::Pose boxLater = box->GetWorldPose();
+  math::Pose sphereLater = sphere->GetWorldPose();
+  EXPECT_NE(boxLater, boxPose);
+
+  ASSERT_TRUE(world->RestoreSnapshot(snapshot));
+  EXPECT_EQ(world->GetSimTime(), simTime);
+  EXPECT_EQ(world->GetIterations(), iterations);
+  EXPECT_EQ(box->GetWorldPose().pos, boxPose.pos);
+  EXPECT_EQ(box->GetWorldLinearVel(), boxVel);
+  EXPECT_EQ(sphere->GetWorldPose().pos, spherePose.pos);
+  EXPECT_NEAR(box->GetWorldPose().rot.w, boxPose.rot.w, 1e-15);
+
+  // Stepping again from the snapshot gives the same trajectory.
+  world->Step(200);
+  EXPECT_NEAR(box->GetWorldPose().pos.Distance(boxLater.pos), 0, 1e-9);
+  EXPECT_NEAR(sphere->GetWorldPose().pos.Distance(sphereLater.pos), 0,
+      1e-9);
+
+  // A snapshot is not restored into a world whose models changed.
+  SpawnSphere("other", math::Vector3(-3, 0, 1), math::Vector3::Zero);
+  math::Pose current = box->GetWorldPose();
+  EXPECT_FALSE(world->RestoreSnapshot(snapshot));
+  EXPECT_EQ(box->GetWorldPose(), current);
+
+  physics::WorldSnapshot truncated;
+  std::vector<char> data(snapshot.GetData().begin(),
+      snapshot.GetData().begin() + 8);
+  truncated.SetData(data);
+  EXPECT_FALSE(world->RestoreSnapshot(truncated));
+}
+
+/////////////////////////////////////////////////
+TEST_F(WorldTest, Clone)
+{
+  Load("worlds/empty.world", true);
+  physics::WorldPtr world = physics::get_world("default");
+  ASSERT_TRUE(world != NULL);
+
+  SpawnBox("box", math::Vector3(1, 1, 1), math::Vector3(0, 0, 2),
+      math::Vector3(0.3, 0.2, 0));
+  physics::ModelPtr box = world->GetModel("box");
+  ASSERT_TRUE(box != NULL);
+
+  world->Step(50);
+  math::Pose pose = box->GetWorldPose();
+  uint64_t iterations = world->GetIterations();
+
+  EXPECT_TRUE(world->Clone("default", 1) == NULL);
+
+  physics::WorldPtr clone = world->Clone("rollout", 1);
+  ASSERT_TRUE(clone != NULL);
+  EXPECT_EQ(clone->GetName(), "rollout");
+  EXPECT_TRUE(physics::has_world("rollout"));
+  EXPECT_TRUE(clone->IsPaused());
+  EXPECT_EQ(clone->GetIterations(), iterations);
+  EXPECT_EQ(clone->GetSimTime(), world->GetSimTime());
+
+  physics::ModelPtr cloneBox = clone->GetModel("box");
+  ASSERT_TRUE(cloneBox != NULL);
+  EXPECT_NE(cloneBox, box);
+  EXPECT_EQ(cloneBox->GetWorldPose().pos, pose.pos);
+
+  // Both worlds take the same steps from the same state.
+  world->Step(100);
+  clone->Step(100);
+  EXPECT_NEAR(cloneBox->GetWorldPose().pos.Distance(
+      box->GetWorldPose().pos), 0, 1e-9);
+
+  // A push in the copy does not reach the original.
+  cloneBox->SetLinearVel(math::Vector3(2, 0, 0));
+  clone->Step(100);
+  world->Step(100);
+  EXPECT_GT(cloneBox->GetWorldPose().pos.x,
+      box->GetWorldPose().pos.x + 0.1);
+
+  EXPECT_TRUE(physics::remove_world("rollout"));
+  EXPECT_EQ(physics::get_world(), world);
+}
+
 /////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -37,6 +37,7 @@ using namespace gazebo;
 
 boost::mutex Command::sigMutex;
 boost::condition_variable Command::sigCondition;
+bool Command::sigReceived = false;
 
 std::map<std::string, Command *> g_commandMap;
 
@@ -59,9 +60,16 @@ Command::~Command()
 void Command::Signal()
 {
   boost::mutex::scoped_lock lock(sigMutex);
+  sigReceived = true;
   sigCondition.notify_all();
 }
 
+/////////////////////////////////////////////////
+bool Command::Interrupted()
+{
+  return sigReceived;
+}
+
 /////////////////////////////////////////////////
 void Command::ListOptions()
 {
@@ -839,10 +847,13 @@ bool StatsCommand::RunImpl()
 
   boost::mutex::scoped_lock lock(this->sigMutex);
   if (this->vm.count("duration"))
+  {
     this->sigCondition.timed_wait(lock,
-        boost::posix_time::seconds(this->vm["duration"].as<uint64_t>()));
+        boost::posix_time::seconds(this->vm["duration"].as<uint64_t>()),
+        &Command::Interrupted);
+  }
   else
-    this->sigCondition.wait(lock);
+    this->sigCondition.wait(lock, &Command::Interrupted);
 
   return true;
 }
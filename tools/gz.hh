@@ -59,6 +59,12 @@ namespace gazebo
     /// \brief Process signal interrupt.
     public: static void Signal();
 
+    /// \brief Get whether a signal interrupt has been received. Used as
+    /// the predicate of waits on sigCondition, which may wake spuriously.
+    /// Must be called with sigMutex locked.
+    /// \return True if a signal interrupt has been received.
+    protected: static bool Interrupted();
+
     /// \brief List all the command options.
     public: void ListOptions();
 
@@ -96,6 +102,9 @@ namespace gazebo
     /// \breif Signal condition.
     protected: static boost::condition_variable sigCondition;
 
+    /// \brief True once a signal interrupt has been received.
+    protected: static bool sigReceived;
+
     /// \brief Save argc for use by child commands.
     protected: int argc;
 
@@ -27,6 +27,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <fstream>
 #include <string>
 
 #include "test/util.hh"
@@ -606,6 +607,76 @@ TEST_F(gzTest, Topic)
   fini();
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the message count that gz topic prints for a topic.
+/// \param[in] _output Output of gz topic.
+/// \param[in] _prefix Text in front of the count.
+/// \return The count, -1 if not found.
+int topicMsgCount(const std::string &_output, const std::string &_prefix)
+{
+  size_t pos = _output.find(_prefix);
+  if (pos == std::string::npos)
+    return -1;
+  return atoi(_output.c_str() + pos + _prefix.size());
+}
+
+/////////////////////////////////////////////////
+TEST_F(gzTest, TopicRecord)
+{
+  init();
+
+  boost::filesystem::path dir = boost::filesystem::temp_directory_path() /
+    boost::filesystem::unique_path("gz_topic_%%%%");
+  boost::filesystem::create_directories(dir);
+  std::string filename = (dir / "stats.rec").string();
+  std::string truncated = (dir / "truncated.rec").string();
+
+  // Record
+  std::string output = custom_exec_str("gz topic -r " + filename +
+      " -t /gazebo/default/world_stats -d 2");
+  int recorded = topicMsgCount(output, "/gazebo/default/world_stats: ");
+  EXPECT_GT(recorded, 1);
+
+  // Play back from the index, as fast as possible.
+  output = custom_exec_str("gz topic -p " + filename + " -s 0");
+  EXPECT_EQ(output.find("Scanning file"), std::string::npos);
+  EXPECT_EQ(topicMsgCount(output, "Published "), recorded);
+
+  // Cut the file one byte into the index, which also loses the last byte
+  // of the last message. The index is at the offset stored in front of
+  // the final magic string.
+  {
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    in.seekg(-16, std::ios::end);
+    uint64_t indexOffset = 0;
+    in.read(reinterpret_cast<char *>(&indexOffset), sizeof(indexOffset));
+    ASSERT_TRUE(in.good());
+    ASSERT_GT(indexOffset, 1u);
+
+    std::string data(indexOffset - 1, '\0');
+    in.seekg(0);
+    in.read(&data[0], data.size());
+    ASSERT_TRUE(in.good());
+
+    std::ofstream out(truncated.c_str(), std::ios::out | std::ios::binary);
+    out.write(data.data(), data.size());
+  }
+
+  // Play back the recovered messages. The cut message is dropped.
+  output = custom_exec_str("gz topic -p " + truncated + " -s 0");
+  EXPECT_NE(output.find("Scanning file"), std::string::npos);
+  EXPECT_EQ(topicMsgCount(output, "Published "), recorded - 1);
+
+  // A file that is not a record file is rejected.
+  output = custom_exec_str("gz topic -p " + std::string(TEST_PATH) +
+      "/worlds/simple_arm_test.world");
+  EXPECT_NE(output.find("is not a topic record file"), std::string::npos);
+
+  boost::filesystem::remove_all(dir);
+
+  fini();
+}
+
 /////////////////////////////////////////////////
 TEST_F(gzTest, SDF)
 {
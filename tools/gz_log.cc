@@ -21,10 +21,18 @@
   #include <Winsock2.h>
 #endif
 
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/date_time/posix_time/posix_time_io.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+
 #include <gazebo/util/util.hh>
 #include "gz_log.hh"
 
@@ -32,6 +40,48 @@ sdf::ElementPtr g_stateSdf;
 
 using namespace gazebo;
 
+/// \brief Number of chunks decoded in parallel before the extracted rows
+/// are written out.
+static const unsigned int g_extractBatchSize = 64;
+
+/// \brief Magic string at the start of binary extraction files.
+static const char g_extractMagic[8] = {'G', 'Z', 'L', 'O', 'G', 'C', 'O', 'L'};
+
+/// \brief Version of the binary extraction file format.
+static const uint32_t g_extractVersion = 1;
+
+/// \brief Decodes and extracts a range of log chunks in parallel.
+class ChunkExtract_TBB
+{
+  /// \brief Constructor.
+  /// \param[in] _extractor The extractor to use.
+  /// \param[in] _first Index of the first chunk in the batch.
+  /// \param[out] _rows Extracted rows, one vector per chunk in the batch.
+  public: ChunkExtract_TBB(const LogExtractor *_extractor,
+              unsigned int _first,
+              std::vector<std::vector<std::vector<double> > > *_rows)
+          : extractor(_extractor), first(_first), rows(_rows) {}
+
+  /// \brief Extract a range of chunks.
+  /// \param[in] _r Range of chunks, relative to the first chunk.
+  public: void operator() (const tbb::blocked_range<size_t> &_r) const
+  {
+    for (size_t i = _r.begin(); i != _r.end(); ++i)
+    {
+      this->extractor->ExtractChunk(this->first + i, (*this->rows)[i]);
+    }
+  }
+
+  /// \brief The extractor.
+  private: const LogExtractor *extractor;
+
+  /// \brief Index of the first chunk in the batch.
+  private: unsigned int first;
+
+  /// \brief Extracted rows.
+  private: std::vector<std::vector<std::vector<double> > > *rows;
+};
+
 /////////////////////////////////////////////////
 FilterBase::FilterBase(bool _xmlOutput, const std::string &_stamp)
 : xmlOutput(_xmlOutput), stamp(_stamp)
@@ -568,6 +618,437 @@ std::string StateFilter::Filter(const std::string &_stateString)
   return result.str();
 }
 
+/////////////////////////////////////////////////
+LogExtractor::LogExtractor(Format _format, double _hz)
+: format(_format), hz(_hz), prevTime(-1), modelPose(true)
+{
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::Init(const std::string &_filter)
+{
+  this->modelRegex = ".*";
+  this->linkRegex.clear();
+  this->jointRegex.clear();
+  this->linkPart = "pose";
+  this->modelPose = true;
+
+  if (_filter.empty())
+    return;
+
+  std::vector<std::string> mainParts;
+  boost::split(mainParts, _filter, boost::is_any_of("/"));
+
+  // Model part: name[.pose]
+  std::vector<std::string> parts;
+  boost::split(parts, mainParts[0], boost::is_any_of("."));
+  if (!parts[0].empty() && parts[0] != "*")
+  {
+    this->modelRegex = parts[0];
+    boost::replace_all(this->modelRegex, "*", ".*");
+  }
+  bool explicitPose = parts.size() > 1 && parts[1] == "pose";
+
+  // Link part: name[.pose|velocity|acceleration|wrench]
+  if (mainParts.size() > 1 && !mainParts[1].empty())
+  {
+    boost::split(parts, mainParts[1], boost::is_any_of("."));
+    this->linkRegex = parts[0];
+    boost::replace_all(this->linkRegex, "*", ".*");
+    if (parts.size() > 1 && !parts[1].empty())
+      this->linkPart = parts[1];
+  }
+
+  // Joint part: name
+  if (mainParts.size() > 2 && !mainParts[2].empty())
+  {
+    boost::split(parts, mainParts[2], boost::is_any_of("."));
+    this->jointRegex = parts[0];
+    boost::replace_all(this->jointRegex, "*", ".*");
+  }
+
+  // Only output the model pose when nothing else was requested, or when
+  // it was asked for explicitly.
+  this->modelPose = explicitPose ||
+    (this->linkRegex.empty() && this->jointRegex.empty());
+}
+
+/////////////////////////////////////////////////
+bool LogExtractor::Extract(const std::string &_filename)
+{
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+
+  if (!this->InitColumns())
+  {
+    std::cerr << "No state in the log file matches the filter.\n";
+    return false;
+  }
+
+  std::ofstream out(_filename.c_str(), std::ios::out | std::ios::binary);
+  if (!out)
+  {
+    std::cerr << "Unable to open output file[" << _filename << "]\n";
+    return false;
+  }
+
+  if (this->format == CSV)
+  {
+    out << boost::algorithm::join(this->columnNames, ",") << "\n";
+    out << std::fixed << std::setprecision(6);
+  }
+  else
+    this->columns.assign(this->columnNames.size(), std::vector<double>());
+
+  // Decode and extract the chunks in parallel, in batches. The rows of each
+  // batch are written in log order before moving to the next batch.
+  unsigned int chunkCount = play->GetChunkCount();
+  std::vector<std::vector<std::vector<double> > > rows;
+  for (unsigned int first = 0; first < chunkCount;
+       first += g_extractBatchSize)
+  {
+    unsigned int count = std::min(g_extractBatchSize, chunkCount - first);
+    rows.assign(count, std::vector<std::vector<double> >());
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, count, 1),
+        ChunkExtract_TBB(this, first, &rows));
+
+    for (unsigned int i = 0; i < count; ++i)
+      this->Write(rows[i], out);
+  }
+
+  if (this->format == BINARY)
+    this->WriteBinary(out);
+
+  return out.good();
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::ExtractChunk(unsigned int _index,
+    std::vector<std::vector<double> > &_rows) const
+{
+  std::string chunk;
+  if (!gazebo::util::LogPlay::Instance()->DecodeChunk(_index, chunk))
+  {
+    std::cerr << "Unable to decode chunk[" << _index << "]\n";
+    return;
+  }
+
+  const std::string startMarker = "<sdf ";
+  const std::string endMarker = "</sdf>";
+
+  size_t start = chunk.find(startMarker);
+  while (start != std::string::npos)
+  {
+    size_t end = chunk.find(endMarker, start);
+    if (end == std::string::npos)
+      break;
+
+    // Parse the state with TinyXML only. The world description in the
+    // first chunk has no top level <state>, and is skipped.
+    TiXmlDocument doc;
+    doc.Parse(chunk.substr(start, end + endMarker.size() - start).c_str());
+
+    TiXmlElement *sdfXml = doc.FirstChildElement("sdf");
+    TiXmlElement *stateXml = sdfXml ? sdfXml->FirstChildElement("state") :
+      NULL;
+    if (stateXml)
+    {
+      _rows.push_back(std::vector<double>());
+      this->ExtractState(stateXml, _rows.back());
+    }
+
+    start = chunk.find(startMarker, end + endMarker.size());
+  }
+}
+
+/////////////////////////////////////////////////
+bool LogExtractor::InitColumns()
+{
+  gazebo::util::LogPlay *play = gazebo::util::LogPlay::Instance();
+
+  this->columnNames.clear();
+  this->columnIndex.clear();
+  this->columnNames.push_back("sim_time");
+
+  const std::string startMarker = "<sdf ";
+  const std::string endMarker = "</sdf>";
+
+  // Use the first state in the log to find the entities that match the
+  // filter. Entities inserted later in the log are not extracted.
+  std::string chunk;
+  for (unsigned int i = 0; i < play->GetChunkCount(); ++i)
+  {
+    if (!play->DecodeChunk(i, chunk))
+      continue;
+
+    size_t start = chunk.find(startMarker);
+    while (start != std::string::npos)
+    {
+      size_t end = chunk.find(endMarker, start);
+      if (end == std::string::npos)
+        break;
+
+      TiXmlDocument doc;
+      doc.Parse(chunk.substr(start, end + endMarker.size() - start).c_str());
+
+      TiXmlElement *sdfXml = doc.FirstChildElement("sdf");
+      TiXmlElement *stateXml = sdfXml ? sdfXml->FirstChildElement("state") :
+        NULL;
+      if (stateXml)
+      {
+        this->AddColumns(stateXml);
+        return this->columnNames.size() > 1;
+      }
+
+      start = chunk.find(startMarker, end + endMarker.size());
+    }
+  }
+
+  return false;
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::AddColumns(TiXmlElement *_stateXml)
+{
+  static const char *poseSuffixes[] = {"x", "y", "z", "roll", "pitch", "yaw"};
+  std::vector<std::string> pose(poseSuffixes, poseSuffixes + 6);
+
+  boost::regex modelRegex(this->modelRegex);
+  boost::regex linkRegex(this->linkRegex.empty() ? ".*" : this->linkRegex);
+  boost::regex jointRegex(this->jointRegex.empty() ? ".*" :
+      this->jointRegex);
+
+  for (TiXmlElement *modelXml = _stateXml->FirstChildElement("model");
+       modelXml; modelXml = modelXml->NextSiblingElement("model"))
+  {
+    const char *modelName = modelXml->Attribute("name");
+    if (!modelName || !boost::regex_match(modelName, modelRegex))
+      continue;
+
+    if (this->modelPose)
+    {
+      this->AddColumnGroup(std::string("m:") + modelName,
+          std::string(modelName) + ".pose", pose);
+    }
+
+    if (!this->linkRegex.empty())
+    {
+      for (TiXmlElement *linkXml = modelXml->FirstChildElement("link");
+           linkXml; linkXml = linkXml->NextSiblingElement("link"))
+      {
+        const char *linkName = linkXml->Attribute("name");
+        if (!linkName || !boost::regex_match(linkName, linkRegex))
+          continue;
+
+        std::string scopedName = std::string(modelName) + "::" + linkName;
+        this->AddColumnGroup("l:" + scopedName,
+            scopedName + "." + this->linkPart, pose);
+      }
+    }
+
+    if (!this->jointRegex.empty())
+    {
+      for (TiXmlElement *jointXml = modelXml->FirstChildElement("joint");
+           jointXml; jointXml = jointXml->NextSiblingElement("joint"))
+      {
+        const char *jointName = jointXml->Attribute("name");
+        if (!jointName || !boost::regex_match(jointName, jointRegex))
+          continue;
+
+        std::vector<std::string> axes;
+        for (TiXmlElement *angleXml = jointXml->FirstChildElement("angle");
+             angleXml; angleXml = angleXml->NextSiblingElement("angle"))
+        {
+          axes.push_back(boost::lexical_cast<std::string>(axes.size()));
+        }
+
+        std::string scopedName = std::string(modelName) + "::" + jointName;
+        this->AddColumnGroup("j:" + scopedName, scopedName, axes);
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::AddColumnGroup(const std::string &_key,
+    const std::string &_prefix, const std::vector<std::string> &_suffixes)
+{
+  if (_suffixes.empty() || this->columnIndex.count(_key))
+    return;
+
+  this->columnIndex[_key] = this->columnNames.size();
+  for (std::vector<std::string>::const_iterator iter = _suffixes.begin();
+       iter != _suffixes.end(); ++iter)
+  {
+    this->columnNames.push_back(_prefix + "." + *iter);
+  }
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::ExtractState(TiXmlElement *_stateXml,
+    std::vector<double> &_row) const
+{
+  // Entities that are missing from a state are output as NaN.
+  _row.assign(this->columnNames.size(),
+      std::numeric_limits<double>::quiet_NaN());
+
+  // Simulation time is stored as "sec nsec".
+  TiXmlElement *timeXml = _stateXml->FirstChildElement("sim_time");
+  if (timeXml && timeXml->GetText())
+  {
+    char *end = NULL;
+    double sec = strtod(timeXml->GetText(), &end);
+    double nsec = strtod(end, NULL);
+    _row[0] = sec + nsec * 1e-9;
+  }
+
+  std::map<std::string, unsigned int>::const_iterator iter;
+
+  for (TiXmlElement *modelXml = _stateXml->FirstChildElement("model");
+       modelXml; modelXml = modelXml->NextSiblingElement("model"))
+  {
+    const char *modelName = modelXml->Attribute("name");
+    if (!modelName)
+      continue;
+
+    if (this->modelPose)
+    {
+      iter = this->columnIndex.find(std::string("m:") + modelName);
+      TiXmlElement *poseXml = modelXml->FirstChildElement("pose");
+      if (iter != this->columnIndex.end() && poseXml)
+        ReadValues(poseXml->GetText(), 6, &_row[iter->second]);
+    }
+
+    if (!this->linkRegex.empty())
+    {
+      for (TiXmlElement *linkXml = modelXml->FirstChildElement("link");
+           linkXml; linkXml = linkXml->NextSiblingElement("link"))
+      {
+        const char *linkName = linkXml->Attribute("name");
+        if (!linkName)
+          continue;
+
+        iter = this->columnIndex.find(
+            std::string("l:") + modelName + "::" + linkName);
+        if (iter == this->columnIndex.end())
+          continue;
+
+        TiXmlElement *partXml =
+          linkXml->FirstChildElement(this->linkPart.c_str());
+        if (partXml)
+          ReadValues(partXml->GetText(), 6, &_row[iter->second]);
+      }
+    }
+
+    if (!this->jointRegex.empty())
+    {
+      for (TiXmlElement *jointXml = modelXml->FirstChildElement("joint");
+           jointXml; jointXml = jointXml->NextSiblingElement("joint"))
+      {
+        const char *jointName = jointXml->Attribute("name");
+        if (!jointName)
+          continue;
+
+        iter = this->columnIndex.find(
+            std::string("j:") + modelName + "::" + jointName);
+        if (iter == this->columnIndex.end())
+          continue;
+
+        unsigned int axis = 0;
+        for (TiXmlElement *angleXml = jointXml->FirstChildElement("angle");
+             angleXml && iter->second + axis < _row.size();
+             angleXml = angleXml->NextSiblingElement("angle"), ++axis)
+        {
+          ReadValues(angleXml->GetText(), 1, &_row[iter->second + axis]);
+        }
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::ReadValues(const char *_text, unsigned int _count,
+    double *_values)
+{
+  if (!_text)
+    return;
+
+  char *end = NULL;
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    double value = strtod(_text, &end);
+    if (end == _text)
+      break;
+    _values[i] = value;
+    _text = end;
+  }
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::Write(const std::vector<std::vector<double> > &_rows,
+    std::ofstream &_out)
+{
+  for (std::vector<std::vector<double> >::const_iterator iter =
+       _rows.begin(); iter != _rows.end(); ++iter)
+  {
+    const std::vector<double> &row = *iter;
+
+    if (this->hz > 0.0 && this->prevTime >= 0 &&
+        row[0] - this->prevTime < 1.0 / this->hz)
+    {
+      continue;
+    }
+    this->prevTime = row[0];
+
+    if (this->format == CSV)
+    {
+      for (unsigned int i = 0; i < row.size(); ++i)
+        _out << (i > 0 ? "," : "") << row[i];
+      _out << "\n";
+    }
+    else
+    {
+      for (unsigned int i = 0; i < row.size(); ++i)
+        this->columns[i].push_back(row[i]);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void LogExtractor::WriteBinary(std::ofstream &_out) const
+{
+  uint32_t columnCount = this->columns.size();
+  uint64_t rowCount = this->columns.empty() ? 0 : this->columns[0].size();
+
+  // Header
+  _out.write(g_extractMagic, sizeof(g_extractMagic));
+  _out.write(reinterpret_cast<const char *>(&g_extractVersion),
+      sizeof(g_extractVersion));
+  _out.write(reinterpret_cast<const char *>(&columnCount),
+      sizeof(columnCount));
+  _out.write(reinterpret_cast<const char *>(&rowCount), sizeof(rowCount));
+
+  // Column names, each preceded by its length.
+  for (std::vector<std::string>::const_iterator iter =
+       this->columnNames.begin(); iter != this->columnNames.end(); ++iter)
+  {
+    uint32_t length = iter->size();
+    _out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    _out.write(iter->data(), length);
+  }
+
+  // Column data, stored contiguously one column after the other.
+  for (std::vector<std::vector<double> >::const_iterator iter =
+       this->columns.begin(); iter != this->columns.end(); ++iter)
+  {
+    if (!iter->empty())
+    {
+      _out.write(reinterpret_cast<const char *>(&(*iter)[0]),
+          iter->size() * sizeof(double));
+    }
+  }
+}
+
 /////////////////////////////////////////////////
 LogCommand::LogCommand()
   : Command("log", "Introspects and manipulates Gazebo log files.")
@@ -590,8 +1071,14 @@ LogCommand::LogCommand()
     ("hz,z", po::value<double>(), "Filter output to the specified Hz rate."
      "Only valid for echo and step commands.")
     ("file,f", po::value<std::string>(), "Path to a log file.")
+    ("extract,x", po::value<std::string>(), "Extract the model, link or "
+     "joint time series selected by --filter to a file. Log chunks are "
+     "decoded in parallel and states are not loaded as SDF, which is much "
+     "faster than --echo on long logs.")
+    ("format", po::value<std::string>(), "Output format used by --extract. "
+     "Valid values are (csv,bin). Default is csv.")
     ("filter", po::value<std::string>(),
-     "Filter output. Valid only for the echo and step commands");
+     "Filter output. Valid only for the echo, step and extract commands");
 }
 
 /////////////////////////////////////////////////
@@ -600,7 +1087,14 @@ void LogCommand::HelpDetailed()
   std::cerr <<
     "\tIntrospect and manipulate Gazebo log files. The log   \n"
     "\tcommand can also start and stop data log recording from \n"
-    "\tan active Gazebo server.\n"
+    "\tan active Gazebo server.\n\n"
+    "\tThe extract command writes one row per state to a CSV or\n"
+    "\tbinary file. Select the data with a filter of the form\n"
+    "\tmodel[.pose][/link[.pose|velocity|acceleration|wrench][/joint]].\n"
+    "\tBinary files start with the 8 byte magic 'GZLOGCOL', a uint32\n"
+    "\tversion, a uint32 column count, a uint64 row count and the\n"
+    "\tlength prefixed column names, followed by each column as an\n"
+    "\tarray of doubles.\n"
     << std::endl;
 }
 
@@ -665,6 +1159,13 @@ bool LogCommand::RunImpl()
     this->Echo(filter, raw, stamp, hz);
   else if (this->vm.count("step"))
     this->Step(filter, raw, stamp, hz);
+  else if (this->vm.count("extract"))
+  {
+    std::string format =
+      this->vm.count("format") ? this->vm["format"].as<std::string>() : "csv";
+    return this->Extract(filter, this->vm["extract"].as<std::string>(),
+        format, hz);
+  }
   else if (this->vm.count("record"))
     this->Record(this->vm["record"].as<bool>());
   else if (this->vm.count("info"))
@@ -866,6 +1367,28 @@ void LogCommand::Step(const std::string &_filter, bool _raw,
     std::cout << "</gazebo_log>\n";
 }
 
+/////////////////////////////////////////////////
+bool LogCommand::Extract(const std::string &_filter,
+    const std::string &_filename, const std::string &_format, double _hz)
+{
+  LogExtractor::Format format;
+  if (_format == "csv")
+    format = LogExtractor::CSV;
+  else if (_format == "bin")
+    format = LogExtractor::BINARY;
+  else
+  {
+    std::cerr << "Invalid output format[" << _format << "]. "
+      << "Valid values are (csv,bin)\n";
+    return false;
+  }
+
+  LogExtractor extractor(format, _hz);
+  extractor.Init(_filter);
+
+  return extractor.Extract(_filename);
+}
+
 /////////////////////////////////////////////////
 void LogCommand::Record(bool _start)
 {
@@ -17,8 +17,13 @@
 #ifndef _GZ_LOG_HH_
 #define _GZ_LOG_HH_
 
+#include <fstream>
 #include <string>
 #include <list>
+#include <map>
+#include <vector>
+
+#include <tinyxml.h>
 
 #include <gazebo/physics/WorldState.hh>
 #include "gz.hh"
@@ -182,6 +187,120 @@ namespace gazebo
     private: gazebo::common::Time prevTime;
   };
 
+  /// \brief Fast extraction of model, link and joint time series from a
+  /// log file. Chunks are decoded in parallel, and each state is scanned
+  /// with TinyXML instead of being loaded into SDF elements.
+  class LogExtractor
+  {
+    /// \brief Output formats of the extracted data.
+    public: enum Format
+    {
+      /// \brief Comma separated values, one row per state.
+      CSV,
+
+      /// \brief Binary file that stores each column contiguously.
+      BINARY
+    };
+
+    /// \brief Constructor
+    /// \param[in] _format Output format.
+    /// \param[in] _hz Rate at which to output states, 0 outputs all states.
+    public: LogExtractor(Format _format, double _hz = 0);
+
+    /// \brief Initialize the extractor with a filter string.
+    /// \param[in] _filter Filter of the form
+    /// model[.pose][/link[.pose|velocity|acceleration|wrench][/joint]].
+    /// Names may contain '*' wildcards.
+    public: void Init(const std::string &_filter);
+
+    /// \brief Extract the selected time series from the open log file.
+    /// \param[in] _filename Name of the output file.
+    /// \return True on success.
+    public: bool Extract(const std::string &_filename);
+
+    /// \brief Decode a chunk, and extract one row of values for each state
+    /// in the chunk. The first value of a row is the simulation time.
+    /// This function may be called from several threads at once.
+    /// \param[in] _index Index of the chunk.
+    /// \param[out] _rows Rows extracted from the chunk.
+    public: void ExtractChunk(unsigned int _index,
+                std::vector<std::vector<double> > &_rows) const;
+
+    /// \brief Create the output columns from the first state in the log.
+    /// \return True if at least one column was created.
+    private: bool InitColumns();
+
+    /// \brief Add the columns that match the filter for a state.
+    /// \param[in] _stateXml The state to read entity names from.
+    private: void AddColumns(TiXmlElement *_stateXml);
+
+    /// \brief Add a group of columns.
+    /// \param[in] _key Key used to find the group when extracting.
+    /// \param[in] _prefix Prefix of the column names.
+    /// \param[in] _suffixes Suffix of each column name.
+    private: void AddColumnGroup(const std::string &_key,
+                 const std::string &_prefix,
+                 const std::vector<std::string> &_suffixes);
+
+    /// \brief Extract a row of values from a state.
+    /// \param[in] _stateXml The state to read values from.
+    /// \param[out] _row Extracted values.
+    private: void ExtractState(TiXmlElement *_stateXml,
+                 std::vector<double> &_row) const;
+
+    /// \brief Read a list of space separated values into a row.
+    /// \param[in] _text Text to read.
+    /// \param[in] _count Maximum number of values to read.
+    /// \param[out] _values Pointer to the first value to write.
+    private: static void ReadValues(const char *_text, unsigned int _count,
+                 double *_values);
+
+    /// \brief Write the rows that pass the Hz filter to the output.
+    /// \param[in] _rows Rows to write.
+    /// \param[in] _out Output stream, used for CSV.
+    private: void Write(const std::vector<std::vector<double> > &_rows,
+                 std::ofstream &_out);
+
+    /// \brief Write the buffered columns to a binary file.
+    /// \param[in] _out Output stream.
+    private: void WriteBinary(std::ofstream &_out) const;
+
+    /// \brief Output format.
+    private: Format format;
+
+    /// \brief Rate at which to output states.
+    private: double hz;
+
+    /// \brief Simulation time of the previous row written.
+    private: double prevTime;
+
+    /// \brief Regular expression for model names.
+    private: std::string modelRegex;
+
+    /// \brief Regular expression for link names, empty if links are not
+    /// extracted.
+    private: std::string linkRegex;
+
+    /// \brief Regular expression for joint names, empty if joints are not
+    /// extracted.
+    private: std::string jointRegex;
+
+    /// \brief Link state component to extract.
+    private: std::string linkPart;
+
+    /// \brief True to extract model poses.
+    private: bool modelPose;
+
+    /// \brief Names of the output columns, including the time column.
+    private: std::vector<std::string> columnNames;
+
+    /// \brief Offset of the first column of each group of columns.
+    private: std::map<std::string, unsigned int> columnIndex;
+
+    /// \brief Buffered columns for binary output.
+    private: std::vector<std::vector<double> > columns;
+  };
+
   /// \brief Log command
   class LogCommand : public Command
   {
@@ -217,6 +336,16 @@ namespace gazebo
     private: void Step(const std::string &_filter, bool _raw,
                  const std::string &_stamp, double _hz);
 
+    /// \brief Extract time series from a log file to another file.
+    /// \param[in] _filter Filter string
+    /// \param[in] _filename Name of the output file.
+    /// \param[in] _format Output format (csv or bin).
+    /// \param[in] _hz Hertz rate.
+    /// \return True on success.
+    private: bool Extract(const std::string &_filter,
+                 const std::string &_filename, const std::string &_format,
+                 double _hz);
+
     /// \brief Start or stop logging
     /// \param[in] _start True to start logging
     private: void Record(bool _start);
@@ -18,11 +18,14 @@
 #include <gtest/gtest.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/algorithm/string/trim.hpp>
+#include <boost/filesystem.hpp>
 #include <gazebo/common/CommonIface.hh>
 #include <gazebo/common/Time.hh>
 #include <sdf/sdf_config.h>
 
 #include <stdio.h>
+#include <fstream>
+#include <iterator>
 #include <string>
 
 // This header file isn't needed if shasums are used
@@ -275,6 +278,52 @@ TEST(gz_log, RawFilterStamp)
   EXPECT_EQ(validEcho, echo);
 }
 
+/////////////////////////////////////////////////
+/// Check to make sure that 'gz log -x' extracts the correct time series
+TEST(gz_log, Extract)
+{
+  std::string filename = (boost::filesystem::temp_directory_path() /
+      boost::filesystem::unique_path("gz_log_extract_%%%%.csv")).string();
+
+  custom_exec(std::string("gz log -x ") + filename +
+      " --filter pr2 -f " + PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+
+  std::ifstream ifs(filename.c_str());
+  ASSERT_TRUE(ifs.good());
+  std::string csv((std::istreambuf_iterator<char>(ifs)),
+      std::istreambuf_iterator<char>());
+  ifs.close();
+  boost::filesystem::remove(filename);
+
+  std::string validCsv =
+    "sim_time,pr2.pose.x,pr2.pose.y,pr2.pose.z,"
+    "pr2.pose.roll,pr2.pose.pitch,pr2.pose.yaw\n"
+    "0.021344,0.000000,0.000000,-0.000008,0.000000,-0.000000,-0.000000\n"
+    "0.028958,0.000000,0.000000,-0.000015,0.000000,-0.000001,-0.000000\n";
+  EXPECT_EQ(validCsv, csv);
+
+  // Joint filter, with the model pose requested explicitly
+  custom_exec(std::string("gz log -x ") + filename +
+      " --filter pr2.pose//r_upper_arm_roll_joint -f " +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+
+  ifs.open(filename.c_str());
+  ASSERT_TRUE(ifs.good());
+  std::string header;
+  std::getline(ifs, header);
+  ifs.close();
+  boost::filesystem::remove(filename);
+
+  EXPECT_EQ(header, "sim_time,pr2.pose.x,pr2.pose.y,pr2.pose.z,"
+      "pr2.pose.roll,pr2.pose.pitch,pr2.pose.yaw,"
+      "pr2::r_upper_arm_roll_joint.0");
+
+  // Invalid format
+  custom_exec(std::string("gz log -x ") + filename + " --format foo -f " +
+      PROJECT_SOURCE_PATH + "/test/data/pr2_state.log");
+  EXPECT_FALSE(boost::filesystem::exists(filename));
+}
+
 /////////////////////////////////////////////////
 /// Check to make sure that 'gz log -s' returns correct information
 TEST(gz_log, Step)
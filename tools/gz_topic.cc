@@ -21,6 +21,8 @@
   #include <Winsock2.h>
 #endif
 
+#include <boost/regex.hpp>
+
 #include <gazebo/gui/qt.h>
 #include <gazebo/gui/TopicSelector.hh>
 #include <gazebo/gui/viewers/TopicView.hh>
@@ -31,6 +33,376 @@
 
 using namespace gazebo;
 
+/// \brief Magic string at the start of a topic record file.
+static const char kRecordMagic[] = "GZTOPREC";
+
+/// \brief Magic string at the end of an indexed topic record file.
+static const char kIndexMagic[] = "GZTOPIDX";
+
+/// \brief Length of the magic strings.
+static const size_t kMagicLength = 8;
+
+/// \brief Topic record file format version.
+static const uint32_t kRecordVersion = 1;
+
+/// \brief Record kinds.
+static const uint8_t kTopicRecord = 0;
+static const uint8_t kMessageRecord = 1;
+static const uint8_t kIndexRecord = 2;
+
+/////////////////////////////////////////////////
+template<typename T>
+static void writeValue(std::ostream &_out, const T &_value)
+{
+  _out.write(reinterpret_cast<const char *>(&_value), sizeof(T));
+}
+
+/////////////////////////////////////////////////
+template<typename T>
+static bool readValue(std::istream &_in, T &_value)
+{
+  _in.read(reinterpret_cast<char *>(&_value), sizeof(T));
+  return _in.good();
+}
+
+/////////////////////////////////////////////////
+static void writeString(std::ostream &_out, const std::string &_str)
+{
+  writeValue(_out, static_cast<uint32_t>(_str.size()));
+  _out.write(_str.data(), _str.size());
+}
+
+/////////////////////////////////////////////////
+static bool readString(std::istream &_in, std::string &_str)
+{
+  uint32_t size;
+  if (!readValue(_in, size))
+    return false;
+
+  _str.resize(size);
+  if (size > 0)
+    _in.read(&_str[0], size);
+  return _in.good();
+}
+
+/////////////////////////////////////////////////
+TopicRecorder::TopicRecorder()
+{
+}
+
+/////////////////////////////////////////////////
+TopicRecorder::~TopicRecorder()
+{
+  this->Close();
+}
+
+/////////////////////////////////////////////////
+bool TopicRecorder::Open(const std::string &_filename)
+{
+  this->Close();
+
+  this->out.open(_filename.c_str(), std::ios::out | std::ios::binary);
+  if (!this->out.is_open())
+  {
+    gzerr << "Unable to open file[" << _filename << "] for writing\n";
+    return false;
+  }
+
+  this->topics.clear();
+  this->messages.clear();
+  this->counts.clear();
+
+  this->out.write(kRecordMagic, kMagicLength);
+  writeValue(this->out, kRecordVersion);
+  return this->out.good();
+}
+
+/////////////////////////////////////////////////
+uint32_t TopicRecorder::AddTopic(const std::string &_topic,
+    const std::string &_msgType)
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+
+  RecordedTopic topic;
+  topic.name = _topic;
+  topic.msgType = _msgType;
+
+  uint32_t index = this->topics.size();
+  this->topics.push_back(topic);
+  this->counts.push_back(0);
+
+  writeValue(this->out, kTopicRecord);
+  writeValue(this->out, index);
+  writeString(this->out, _topic);
+  writeString(this->out, _msgType);
+
+  return index;
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::Write(uint32_t _topic, const std::string &_data)
+{
+  common::Time stamp = common::Time::GetWallTime();
+
+  boost::mutex::scoped_lock lock(this->mutex);
+  if (!this->out.is_open() || _topic >= this->topics.size())
+    return;
+
+  RecordedMessage msg;
+  msg.stamp = stamp;
+  msg.topic = _topic;
+  msg.size = _data.size();
+
+  writeValue(this->out, kMessageRecord);
+  writeValue(this->out, _topic);
+  writeValue(this->out, stamp.sec);
+  writeValue(this->out, stamp.nsec);
+  writeValue(this->out, msg.size);
+  msg.offset = this->out.tellp();
+  this->out.write(_data.data(), _data.size());
+
+  this->messages.push_back(msg);
+  this->counts[_topic]++;
+}
+
+/////////////////////////////////////////////////
+void TopicRecorder::Close()
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  if (!this->out.is_open())
+    return;
+
+  // The index repeats the topic table so that a reader can skip straight
+  // from the footer to the index.
+  uint64_t indexOffset = this->out.tellp();
+  writeValue(this->out, kIndexRecord);
+
+  writeValue(this->out, static_cast<uint32_t>(this->topics.size()));
+  for (std::vector<RecordedTopic>::const_iterator iter =
+       this->topics.begin(); iter != this->topics.end(); ++iter)
+  {
+    writeString(this->out, iter->name);
+    writeString(this->out, iter->msgType);
+  }
+
+  writeValue(this->out, static_cast<uint64_t>(this->messages.size()));
+  for (std::vector<RecordedMessage>::const_iterator iter =
+       this->messages.begin(); iter != this->messages.end(); ++iter)
+  {
+    writeValue(this->out, iter->topic);
+    writeValue(this->out, iter->stamp.sec);
+    writeValue(this->out, iter->stamp.nsec);
+    writeValue(this->out, iter->offset);
+    writeValue(this->out, iter->size);
+  }
+
+  writeValue(this->out, indexOffset);
+  this->out.write(kIndexMagic, kMagicLength);
+  this->out.close();
+}
+
+/////////////////////////////////////////////////
+unsigned int TopicRecorder::GetMessageCount(uint32_t _topic) const
+{
+  boost::mutex::scoped_lock lock(this->mutex);
+  return _topic < this->counts.size() ? this->counts[_topic] : 0;
+}
+
+/////////////////////////////////////////////////
+TopicRecorderCallback::TopicRecorderCallback(TopicRecorder *_recorder,
+    uint32_t _topic)
+  : recorder(_recorder), topic(_topic)
+{
+}
+
+/////////////////////////////////////////////////
+void TopicRecorderCallback::OnData(const std::string &_data)
+{
+  this->recorder->Write(this->topic, _data);
+}
+
+/////////////////////////////////////////////////
+bool TopicRecordReader::Open(const std::string &_filename)
+{
+  this->topics.clear();
+  this->messages.clear();
+
+  if (this->in.is_open())
+    this->in.close();
+  this->in.clear();
+
+  this->in.open(_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!this->in.is_open())
+  {
+    gzerr << "Unable to open file[" << _filename << "]\n";
+    return false;
+  }
+
+  char magic[kMagicLength];
+  uint32_t version = 0;
+  this->in.read(magic, kMagicLength);
+  if (!this->in.good() ||
+      std::string(magic, kMagicLength) != std::string(kRecordMagic) ||
+      !readValue(this->in, version) || version != kRecordVersion)
+  {
+    gzerr << "File[" << _filename << "] is not a topic record file\n";
+    return false;
+  }
+
+  if (this->ReadIndex())
+    return true;
+
+  gzwarn << "File[" << _filename << "] has no index, "
+    << "recording may have been interrupted. Scanning file.\n";
+  return this->Scan();
+}
+
+/////////////////////////////////////////////////
+bool TopicRecordReader::ReadIndex()
+{
+  const std::streamoff footerSize = sizeof(uint64_t) + kMagicLength;
+
+  this->in.seekg(0, std::ios::end);
+  std::streamoff fileSize = this->in.tellg();
+  if (fileSize < footerSize)
+    return false;
+
+  uint64_t indexOffset;
+  char magic[kMagicLength];
+
+  this->in.seekg(fileSize - footerSize);
+  if (!readValue(this->in, indexOffset))
+    return false;
+  this->in.read(magic, kMagicLength);
+  if (!this->in.good() ||
+      std::string(magic, kMagicLength) != std::string(kIndexMagic) ||
+      indexOffset >= static_cast<uint64_t>(fileSize))
+  {
+    return false;
+  }
+
+  this->in.seekg(indexOffset);
+
+  uint8_t kind;
+  uint32_t topicCount;
+  if (!readValue(this->in, kind) || kind != kIndexRecord ||
+      !readValue(this->in, topicCount))
+  {
+    return false;
+  }
+
+  std::vector<RecordedTopic> indexTopics(topicCount);
+  for (uint32_t i = 0; i < topicCount; ++i)
+  {
+    if (!readString(this->in, indexTopics[i].name) ||
+        !readString(this->in, indexTopics[i].msgType))
+    {
+      return false;
+    }
+  }
+
+  uint64_t msgCount;
+  if (!readValue(this->in, msgCount))
+    return false;
+
+  std::vector<RecordedMessage> indexMessages(msgCount);
+  for (uint64_t i = 0; i < msgCount; ++i)
+  {
+    RecordedMessage &msg = indexMessages[i];
+    if (!readValue(this->in, msg.topic) ||
+        !readValue(this->in, msg.stamp.sec) ||
+        !readValue(this->in, msg.stamp.nsec) ||
+        !readValue(this->in, msg.offset) ||
+        !readValue(this->in, msg.size) ||
+        msg.topic >= topicCount)
+    {
+      return false;
+    }
+  }
+
+  this->topics.swap(indexTopics);
+  this->messages.swap(indexMessages);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool TopicRecordReader::Scan()
+{
+  this->in.clear();
+  this->in.seekg(kMagicLength + sizeof(kRecordVersion));
+
+  uint8_t kind;
+  while (readValue(this->in, kind))
+  {
+    if (kind == kTopicRecord)
+    {
+      uint32_t index;
+      RecordedTopic topic;
+      if (!readValue(this->in, index) ||
+          !readString(this->in, topic.name) ||
+          !readString(this->in, topic.msgType) ||
+          index != this->topics.size())
+      {
+        break;
+      }
+      this->topics.push_back(topic);
+    }
+    else if (kind == kMessageRecord)
+    {
+      RecordedMessage msg;
+      if (!readValue(this->in, msg.topic) ||
+          !readValue(this->in, msg.stamp.sec) ||
+          !readValue(this->in, msg.stamp.nsec) ||
+          !readValue(this->in, msg.size) ||
+          msg.topic >= this->topics.size())
+      {
+        break;
+      }
+
+      msg.offset = this->in.tellg();
+      this->in.seekg(msg.size, std::ios::cur);
+
+      // Drop a message truncated by an interrupted write.
+      if (!this->in.good() || this->in.peek() == EOF)
+      {
+        this->in.clear();
+        this->in.seekg(0, std::ios::end);
+        if (static_cast<uint64_t>(this->in.tellg()) < msg.offset + msg.size)
+          break;
+      }
+      this->messages.push_back(msg);
+    }
+    else
+      break;
+  }
+
+  this->in.clear();
+  return !this->topics.empty();
+}
+
+/////////////////////////////////////////////////
+const std::vector<RecordedTopic> &TopicRecordReader::GetTopics() const
+{
+  return this->topics;
+}
+
+/////////////////////////////////////////////////
+const std::vector<RecordedMessage> &TopicRecordReader::GetMessages() const
+{
+  return this->messages;
+}
+
+/////////////////////////////////////////////////
+bool TopicRecordReader::Read(const RecordedMessage &_msg, std::string &_data)
+{
+  this->in.clear();
+  this->in.seekg(_msg.offset);
+  _data.resize(_msg.size);
+  if (_msg.size > 0)
+    this->in.read(&_data[0], _msg.size);
+  return this->in.good();
+}
+
 /////////////////////////////////////////////////
 TopicCommand::TopicCommand()
   : Command("topic", "Lists information about topics on a Gazebo master")
@@ -45,9 +417,16 @@ TopicCommand::TopicCommand()
      "View topic data using a QT widget.")
     ("hz,z", po::value<std::string>(), "Get publish frequency.")
     ("bw,b", po::value<std::string>(), "Get topic bandwidth.")
+    ("record,r", po::value<std::string>(), "Record topics to a file.")
+    ("play,p", po::value<std::string>(), "Publish the topics recorded in "
+     "a file.")
+    ("topics,t", po::value<std::string>(), "Regular expression that selects "
+     "the topics to record or play. Defaults to all topics.")
+    ("scale,s", po::value<double>()->default_value(1.0), "Playback rate "
+     "relative to the recorded rate. Zero plays as fast as possible.")
     ("unformatted,u", "Output data from echo without formatting.")
     ("duration,d", po::value<long>(), "Duration (seconds) to run. "
-     "Applicable with echo, hz, and bw");
+     "Applicable with echo, hz, bw, and record");
 }
 
 /////////////////////////////////////////////////
@@ -57,6 +436,13 @@ void TopicCommand::HelpDetailed()
     "\tPrint topic information to standard out. If a name for the world, \n"
     "\toption -w, is not specified, the first world found on \n"
     "\tthe Gazebo master will be used.\n"
+    "\n"
+    "\tRecord and play back topics:\n"
+    "\t    gz topic -r <file> [-t <regex>] [-d <seconds>]\n"
+    "\t    gz topic -p <file> [-t <regex>] [-s <scale>]\n"
+    "\tRecording stores the serialized messages without parsing them.\n"
+    "\tPlayback publishes each message at its recorded time, scaled by\n"
+    "\t-s.\n"
     << std::endl;
 }
 
@@ -83,6 +469,10 @@ bool TopicCommand::RunImpl()
     this->Bw(this->vm["bw"].as<std::string>());
   else if (this->vm.count("view"))
     this->View(this->vm["view"].as<std::string>());
+  else if (this->vm.count("record"))
+    this->Record(this->vm["record"].as<std::string>());
+  else if (this->vm.count("play"))
+    this->Play(this->vm["play"].as<std::string>());
   else
     this->Help();
 
@@ -92,6 +482,18 @@ bool TopicCommand::RunImpl()
 /////////////////////////////////////////////////
 void TopicCommand::List()
 {
+  std::vector<std::string> topics = this->GetTopicList();
+  for (std::vector<std::string>::const_iterator iter = topics.begin();
+       iter != topics.end(); ++iter)
+  {
+    std::cout << *iter << std::endl;
+  }
+}
+
+/////////////////////////////////////////////////
+std::vector<std::string> TopicCommand::GetTopicList()
+{
+  std::vector<std::string> result;
   std::string data;
   msgs::Packet packet;
   msgs::Request request;
@@ -110,12 +512,11 @@ void TopicCommand::List()
     topics.ParseFromString(packet.serialized_data());
 
     for (int i = 0; i < topics.data_size(); ++i)
-    {
-      std::cout << topics.data(i) << std::endl;
-    }
+      result.push_back(topics.data(i));
   }
 
   connection.reset();
+  return result;
 }
 
 /////////////////////////////////////////////////
@@ -203,12 +604,7 @@ void TopicCommand::Echo(const std::string &_topic)
   transport::SubscriberPtr sub = this->node->Subscribe(_topic,
       &TopicCommand::EchoCB, this);
 
-  boost::mutex::scoped_lock lock(this->sigMutex);
-  if (this->vm.count("duration"))
-    this->sigCondition.timed_wait(lock,
-        boost::posix_time::seconds(this->vm["duration"].as<long>()));
-  else
-    this->sigCondition.wait(lock);
+  this->WaitForDuration();
 }
 
 /////////////////////////////////////////////////
@@ -228,12 +624,7 @@ void TopicCommand::Hz(const std::string &_topic)
   transport::SubscriberPtr sub = this->node->Subscribe(_topic,
       &TopicCommand::HzCB, this);
 
-  boost::mutex::scoped_lock lock(this->sigMutex);
-  if (this->vm.count("duration"))
-    this->sigCondition.timed_wait(lock,
-        boost::posix_time::seconds(this->vm["duration"].as<long>()));
-  else
-    this->sigCondition.wait(lock);
+  this->WaitForDuration();
 }
 
 /////////////////////////////////////////////////
@@ -320,12 +711,187 @@ void TopicCommand::Bw(const std::string &_topic)
   transport::SubscriberPtr sub = node->Subscribe(_topic,
       &TopicCommand::BwCB, this);
 
+  this->WaitForDuration();
+}
+
+/////////////////////////////////////////////////
+bool TopicCommand::WaitForSignal(const common::Time &_timeout)
+{
+  boost::mutex::scoped_lock lock(this->sigMutex);
+  return this->sigCondition.timed_wait(lock,
+      boost::posix_time::microseconds(
+        static_cast<int64_t>(_timeout.Double() * 1e6)),
+      &Command::Interrupted);
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::WaitForDuration()
+{
   boost::mutex::scoped_lock lock(this->sigMutex);
   if (this->vm.count("duration"))
+  {
     this->sigCondition.timed_wait(lock,
-        boost::posix_time::seconds(this->vm["duration"].as<long>()));
+        boost::posix_time::seconds(this->vm["duration"].as<long>()),
+        &Command::Interrupted);
+  }
   else
-    this->sigCondition.wait(lock);
+    this->sigCondition.wait(lock, &Command::Interrupted);
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::Record(const std::string &_filename)
+{
+  boost::regex filter(this->vm.count("topics") ?
+      this->vm["topics"].as<std::string>() : ".*");
+
+  TopicRecorder recorder;
+  if (!recorder.Open(_filename))
+    return;
+
+  std::vector<std::string> names;
+  std::vector<boost::shared_ptr<TopicRecorderCallback> > callbacks;
+  std::vector<transport::SubscriberPtr> subs;
+
+  std::vector<std::string> topics = this->GetTopicList();
+  for (std::vector<std::string>::const_iterator iter = topics.begin();
+       iter != topics.end(); ++iter)
+  {
+    if (!boost::regex_match(*iter, filter))
+      continue;
+
+    std::string msgType = transport::getTopicMsgType(*iter);
+    if (msgType.empty())
+    {
+      gzwarn << "Unable to get message type for topic[" << *iter
+        << "], skipping\n";
+      continue;
+    }
+
+    uint32_t index = recorder.AddTopic(*iter, msgType);
+    boost::shared_ptr<TopicRecorderCallback> cb(
+        new TopicRecorderCallback(&recorder, index));
+
+    names.push_back(*iter);
+    callbacks.push_back(cb);
+    subs.push_back(this->node->Subscribe(*iter,
+          &TopicRecorderCallback::OnData, cb.get()));
+  }
+
+  if (names.empty())
+  {
+    gzerr << "No topics to record\n";
+    recorder.Close();
+    return;
+  }
+
+  std::cout << "Recording " << names.size() << " topics to "
+    << _filename << std::endl;
+
+  this->WaitForDuration();
+
+  // Stop the callbacks before the recorder goes away.
+  for (std::vector<transport::SubscriberPtr>::iterator iter = subs.begin();
+       iter != subs.end(); ++iter)
+  {
+    (*iter)->Unsubscribe();
+  }
+  subs.clear();
+
+  recorder.Close();
+
+  for (unsigned int i = 0; i < names.size(); ++i)
+  {
+    std::cout << names[i] << ": " << recorder.GetMessageCount(i)
+      << " messages\n";
+  }
+}
+
+/////////////////////////////////////////////////
+void TopicCommand::Play(const std::string &_filename)
+{
+  TopicRecordReader reader;
+  if (!reader.Open(_filename))
+    return;
+
+  boost::regex filter(this->vm.count("topics") ?
+      this->vm["topics"].as<std::string>() : ".*");
+
+  double scale = this->vm["scale"].as<double>();
+  if (scale < 0)
+  {
+    gzerr << "Scale must be zero or positive\n";
+    return;
+  }
+
+  // Transport only publishes protobuf messages, so each recorded message
+  // is parsed into a message of its topic's type before publishing.
+  const std::vector<RecordedTopic> &topics = reader.GetTopics();
+  std::vector<transport::PublisherPtr> pubs(topics.size());
+  std::vector<boost::shared_ptr<google::protobuf::Message> > msgs(
+      topics.size());
+
+  for (unsigned int i = 0; i < topics.size(); ++i)
+  {
+    if (!boost::regex_match(topics[i].name, filter))
+      continue;
+
+    msgs[i] = msgs::MsgFactory::NewMsg(topics[i].msgType);
+    if (!msgs[i])
+    {
+      gzwarn << "Unable to create message of type[" << topics[i].msgType
+        << "] for topic[" << topics[i].name << "], skipping\n";
+      continue;
+    }
+
+    pubs[i] = this->node->Advertise(topics[i].name, topics[i].msgType);
+  }
+
+  const std::vector<RecordedMessage> &messages = reader.GetMessages();
+  if (messages.empty())
+  {
+    std::cout << "No messages in " << _filename << std::endl;
+    return;
+  }
+
+  common::Time firstStamp = messages.front().stamp;
+  common::Time startTime = common::Time::GetWallTime();
+  std::string data;
+  unsigned int published = 0;
+
+  for (std::vector<RecordedMessage>::const_iterator iter = messages.begin();
+       iter != messages.end(); ++iter)
+  {
+    if (!pubs[iter->topic])
+      continue;
+
+    common::Time wait;
+    if (scale > 0)
+    {
+      common::Time target = startTime +
+        common::Time((iter->stamp - firstStamp).Double() / scale);
+      wait = target - common::Time::GetWallTime();
+    }
+
+    // A zero timeout still returns early on an interrupt.
+    if (this->WaitForSignal(wait > common::Time::Zero ?
+          wait : common::Time::Zero))
+    {
+      break;
+    }
+
+    if (!reader.Read(*iter, data) ||
+        !msgs[iter->topic]->ParseFromString(data))
+    {
+      gzwarn << "Unable to read message on topic["
+        << topics[iter->topic].name << "]\n";
+      continue;
+    }
+
+    pubs[iter->topic]->Publish(*msgs[iter->topic], true);
+    ++published;
+  }
+
+  std::cout << "Published " << published << " messages" << std::endl;
 }
 
 /////////////////////////////////////////////////
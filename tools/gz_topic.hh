@@ -17,6 +17,8 @@
 #ifndef _GZ_TOPIC_HH_
 #define _GZ_TOPIC_HH_
 
+#include <fstream>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -24,6 +26,149 @@
 
 namespace gazebo
 {
+  /// \brief A recorded topic.
+  class RecordedTopic
+  {
+    /// \brief Name of the topic.
+    public: std::string name;
+
+    /// \brief Full protobuf name of the message type.
+    public: std::string msgType;
+  };
+
+  /// \brief Location of a recorded message within a topic record file.
+  class RecordedMessage
+  {
+    /// \brief Wall time at which the message was received.
+    public: common::Time stamp;
+
+    /// \brief Index of the message's topic.
+    public: uint32_t topic;
+
+    /// \brief Offset of the serialized message data in the file.
+    public: uint64_t offset;
+
+    /// \brief Size of the serialized message data in bytes.
+    public: uint32_t size;
+  };
+
+  /// \brief Writes serialized topic messages, with their receive
+  /// time, to a binary file. Messages are stored as received, without
+  /// being parsed. When closed, an index of every message is appended
+  /// so that the file can be read back without scanning it.
+  ///
+  /// All integers are written in host byte order.
+  class TopicRecorder
+  {
+    /// \brief Constructor.
+    public: TopicRecorder();
+
+    /// \brief Destructor. Closes the file.
+    public: virtual ~TopicRecorder();
+
+    /// \brief Create a new record file.
+    /// \param[in] _filename Path of the file to write.
+    /// \return True if the file was created.
+    public: bool Open(const std::string &_filename);
+
+    /// \brief Add a topic to the file.
+    /// \param[in] _topic Name of the topic.
+    /// \param[in] _msgType Full protobuf name of the message type.
+    /// \return Index of the topic, used by Write().
+    public: uint32_t AddTopic(const std::string &_topic,
+                const std::string &_msgType);
+
+    /// \brief Write a serialized message. Thread safe.
+    /// \param[in] _topic Index of the topic, as returned by AddTopic().
+    /// \param[in] _data Serialized message.
+    public: void Write(uint32_t _topic, const std::string &_data);
+
+    /// \brief Write the index and close the file.
+    public: void Close();
+
+    /// \brief Get the number of messages written for a topic.
+    /// \param[in] _topic Index of the topic.
+    /// \return Number of messages written.
+    public: unsigned int GetMessageCount(uint32_t _topic) const;
+
+    /// \brief Output file.
+    private: std::ofstream out;
+
+    /// \brief Recorded topics.
+    private: std::vector<RecordedTopic> topics;
+
+    /// \brief Index of every message written.
+    private: std::vector<RecordedMessage> messages;
+
+    /// \brief Number of messages written per topic.
+    private: std::vector<unsigned int> counts;
+
+    /// \brief Protects the output file and the index.
+    private: mutable boost::mutex mutex;
+  };
+
+  /// \brief Receives raw messages from one topic and hands them to a
+  /// TopicRecorder.
+  class TopicRecorderCallback
+  {
+    /// \brief Constructor.
+    /// \param[in] _recorder Recorder to write to.
+    /// \param[in] _topic Index of the topic in the recorder.
+    public: TopicRecorderCallback(TopicRecorder *_recorder, uint32_t _topic);
+
+    /// \brief Subscription callback.
+    /// \param[in] _data Serialized message.
+    public: void OnData(const std::string &_data);
+
+    /// \brief Recorder to write to.
+    private: TopicRecorder *recorder;
+
+    /// \brief Index of the topic in the recorder.
+    private: uint32_t topic;
+  };
+
+  /// \brief Reads a file written by TopicRecorder.
+  class TopicRecordReader
+  {
+    /// \brief Open a record file and load its index. If the file has
+    /// no index, because recording was interrupted, the file is scanned
+    /// instead.
+    /// \param[in] _filename Path of the file to read.
+    /// \return True if the file was read.
+    public: bool Open(const std::string &_filename);
+
+    /// \brief Get the recorded topics.
+    /// \return The recorded topics.
+    public: const std::vector<RecordedTopic> &GetTopics() const;
+
+    /// \brief Get the recorded messages, in the order received.
+    /// \return The recorded messages.
+    public: const std::vector<RecordedMessage> &GetMessages() const;
+
+    /// \brief Read the serialized data of a message.
+    /// \param[in] _msg Message to read.
+    /// \param[out] _data Serialized message.
+    /// \return True on success.
+    public: bool Read(const RecordedMessage &_msg, std::string &_data);
+
+    /// \brief Read the index written at the end of the file.
+    /// \return True if the file has a valid index.
+    private: bool ReadIndex();
+
+    /// \brief Build the index by scanning every record in the file.
+    /// \return True if the file could be scanned.
+    private: bool Scan();
+
+    /// \brief Input file.
+    private: std::ifstream in;
+
+    /// \brief Recorded topics.
+    private: std::vector<RecordedTopic> topics;
+
+    /// \brief Recorded messages.
+    private: std::vector<RecordedMessage> messages;
+  };
+
   /// \brief Topic command
   class TopicCommand : public Command
   {
@@ -39,6 +184,10 @@ namespace gazebo
     /// \brief Output the topic list.
     private: void List();
 
+    /// \brief Get the list of topics from the master.
+    /// \return Names of all advertised topics.
+    private: std::vector<std::string> GetTopicList();
+
     /// \brief Output information about a topic.
     /// \param[in] _topic Topic to print info about.
     private: void Info(const std::string &_topic);
@@ -72,6 +221,23 @@ namespace gazebo
     /// \param[in] _topic Topic name.
     private: void Bw(const std::string &_topic);
 
+    /// \brief Record topics to a file.
+    /// \param[in] _filename File to write.
+    private: void Record(const std::string &_filename);
+
+    /// \brief Publish the messages in a record file.
+    /// \param[in] _filename File to read.
+    private: void Play(const std::string &_filename);
+
+    /// \brief Wait until an interrupt or until a timeout.
+    /// \param[in] _timeout Time to wait for.
+    /// \return True if interrupted.
+    private: bool WaitForSignal(const common::Time &_timeout);
+
+    /// \brief Wait until an interrupt, or until the time given by the
+    /// duration option, if any, has passed.
+    private: void WaitForDuration();
+
     /// \brief View topic information using QT.
     /// \param[in] _topic Name of the topic to view. Empty will bring up
     /// a topic selector.